@@ -0,0 +1,540 @@
+// Includes the AreaKernels.h header file for function declarations.
+#include "AreaKernels.h"
+// Includes the ExactMath.h header file for the overflow-free area calculation and its range filter.
+#include "ExactMath.h"
+
+// Includes the climits library for INT_MAX, the largest index the AVX2 gathers can address.
+#include <climits>
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the cstdint library for the fixed-width std::uint32_t index type.
+#include <cstdint>
+
+// Enables the SIMD kernels only when compiling for x86 or x64 processors.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AREA_KERNELS_X86 1
+// Includes the Intel intrinsics for the SSE2 and AVX2 instructions.
+#include <immintrin.h>
+// Includes the MSVC intrinsics for __cpuid and __cpuidex.
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC compiles intrinsics for any instruction set, GCC and Clang need the target named per function.
+#if defined(AREA_KERNELS_X86) && !defined(_MSC_VER)
+#define AREA_TARGET_SSE2 __attribute__((target("sse2")))
+#define AREA_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AREA_TARGET_SSE2
+#define AREA_TARGET_AVX2
+#endif
+
+/*
+ * Calculates the areas of a range of triangles one at a time.
+ * This is the reference kernel, the fallback on processors without SIMD support, and the
+ * kernel used for meshes whose coordinates are too far apart for the double-precision SIMD kernels.
+ *
+ * @param xs The x-coordinates of the vertex pool.
+ * @param ys The y-coordinates of the vertex pool.
+ * @param zs The z-coordinates of the vertex pool.
+ * @param indices The index buffer, three indices per triangle.
+ * @param first The first triangle to measure.
+ * @param last One past the last triangle to measure.
+ * @param out The array receiving the areas, starting with the area of triangle first.
+ */
+static void calcAreasScalar(const int* xs, const int* ys, const int* zs, const std::uint32_t* indices, std::size_t first, std::size_t last, double* out)
+{
+	// Loop through every triangle in the range.
+	for (std::size_t t = first; t < last; t++)
+	{
+		// Look up the three vertex indices of the triangle.
+		std::uint32_t a = indices[t * 3];
+		std::uint32_t b = indices[t * 3 + 1];
+		std::uint32_t c = indices[t * 3 + 2];
+
+		// Measure the triangle with the filtered exact area calculation.
+		out[t - first] = calcTriangleArea(xs[a], ys[a], zs[a], xs[b], ys[b], zs[b], xs[c], ys[c], zs[c]);
+	}
+}
+
+#ifdef AREA_KERNELS_X86
+/*
+ * Calculates the areas of a range of triangles two at a time with SSE2.
+ * Each instruction works on a pair of triangles packed into the two lanes of a register.
+ *
+ * @param xs The x-coordinates of the vertex pool.
+ * @param ys The y-coordinates of the vertex pool.
+ * @param zs The z-coordinates of the vertex pool.
+ * @param indices The index buffer, three indices per triangle.
+ * @param first The first triangle to measure.
+ * @param last One past the last triangle to measure.
+ * @param out The array receiving the areas, starting with the area of triangle first.
+ */
+AREA_TARGET_SSE2
+static void calcAreasSse2(const int* xs, const int* ys, const int* zs, const std::uint32_t* indices, std::size_t first, std::size_t last, double* out)
+{
+	// Constant used to halve the cross product magnitudes.
+	const __m128d half = _mm_set1_pd(0.5);
+	// Start at the first triangle of the range.
+	std::size_t t = first;
+
+	// Process two triangles per iteration while at least two remain.
+	for (; t + 2 <= last; t += 2)
+	{
+		// Look up the vertex indices of both triangles.
+		const std::uint32_t* i0 = indices + t * 3;
+		const std::uint32_t* i1 = i0 + 3;
+
+		// Gather the first vertex of each triangle into the two lanes.
+		__m128d aX = _mm_set_pd(xs[i1[0]], xs[i0[0]]);
+		__m128d aY = _mm_set_pd(ys[i1[0]], ys[i0[0]]);
+		__m128d aZ = _mm_set_pd(zs[i1[0]], zs[i0[0]]);
+
+		// Compute Vector AB for both triangles.
+		__m128d abX = _mm_sub_pd(_mm_set_pd(xs[i1[1]], xs[i0[1]]), aX);
+		__m128d abY = _mm_sub_pd(_mm_set_pd(ys[i1[1]], ys[i0[1]]), aY);
+		__m128d abZ = _mm_sub_pd(_mm_set_pd(zs[i1[1]], zs[i0[1]]), aZ);
+
+		// Compute Vector AC for both triangles.
+		__m128d acX = _mm_sub_pd(_mm_set_pd(xs[i1[2]], xs[i0[2]]), aX);
+		__m128d acY = _mm_sub_pd(_mm_set_pd(ys[i1[2]], ys[i0[2]]), aY);
+		__m128d acZ = _mm_sub_pd(_mm_set_pd(zs[i1[2]], zs[i0[2]]), aZ);
+
+		// Compute the cross product of vectors AB and AC.
+		__m128d vX = _mm_sub_pd(_mm_mul_pd(abY, acZ), _mm_mul_pd(acY, abZ));
+		__m128d vY = _mm_sub_pd(_mm_mul_pd(acX, abZ), _mm_mul_pd(abX, acZ));
+		__m128d vZ = _mm_sub_pd(_mm_mul_pd(abX, acY), _mm_mul_pd(acX, abY));
+
+		// Compute half the magnitude of both cross products with one square root instruction.
+		__m128d squared = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vX, vX), _mm_mul_pd(vY, vY)), _mm_mul_pd(vZ, vZ));
+		_mm_storeu_pd(out + (t - first), _mm_mul_pd(half, _mm_sqrt_pd(squared)));
+	}
+
+	// Finish a leftover odd triangle with the scalar kernel.
+	calcAreasScalar(xs, ys, zs, indices, t, last, out + (t - first));
+}
+
+/*
+ * Calculates the areas of a range of triangles four at a time with AVX2.
+ * The vertex indices and coordinates are fetched with gather instructions, which treat the indices
+ * as signed 32-bit offsets, so the pool must hold at most INT_MAX vertices.
+ *
+ * @param xs The x-coordinates of the vertex pool.
+ * @param ys The y-coordinates of the vertex pool.
+ * @param zs The z-coordinates of the vertex pool.
+ * @param indices The index buffer, three indices per triangle.
+ * @param first The first triangle to measure.
+ * @param last One past the last triangle to measure.
+ * @param out The array receiving the areas, starting with the area of triangle first.
+ */
+AREA_TARGET_AVX2
+static void calcAreasAvx2(const int* xs, const int* ys, const int* zs, const std::uint32_t* indices, std::size_t first, std::size_t last, double* out)
+{
+	// Constant used to halve the cross product magnitudes.
+	const __m256d half = _mm256_set1_pd(0.5);
+	// Offsets of the four triangles' first indices inside a block of twelve indices.
+	const __m128i stride = _mm_setr_epi32(0, 3, 6, 9);
+	// Start at the first triangle of the range.
+	std::size_t t = first;
+
+	// Process four triangles per iteration while at least four remain.
+	for (; t + 4 <= last; t += 4)
+	{
+		// Gather the first, second and third vertex index of the four triangles.
+		const int* block = reinterpret_cast<const int*>(indices + t * 3);
+		__m128i ia = _mm_i32gather_epi32(block, stride, 4);
+		__m128i ib = _mm_i32gather_epi32(block + 1, stride, 4);
+		__m128i ic = _mm_i32gather_epi32(block + 2, stride, 4);
+
+		// Gather the coordinates of the first vertices and widen them to double.
+		__m256d aX = _mm256_cvtepi32_pd(_mm_i32gather_epi32(xs, ia, 4));
+		__m256d aY = _mm256_cvtepi32_pd(_mm_i32gather_epi32(ys, ia, 4));
+		__m256d aZ = _mm256_cvtepi32_pd(_mm_i32gather_epi32(zs, ia, 4));
+
+		// Compute Vector AB for the four triangles.
+		__m256d abX = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_i32gather_epi32(xs, ib, 4)), aX);
+		__m256d abY = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_i32gather_epi32(ys, ib, 4)), aY);
+		__m256d abZ = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_i32gather_epi32(zs, ib, 4)), aZ);
+
+		// Compute Vector AC for the four triangles.
+		__m256d acX = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_i32gather_epi32(xs, ic, 4)), aX);
+		__m256d acY = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_i32gather_epi32(ys, ic, 4)), aY);
+		__m256d acZ = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_i32gather_epi32(zs, ic, 4)), aZ);
+
+		// Compute the cross product of vectors AB and AC.
+		__m256d vX = _mm256_sub_pd(_mm256_mul_pd(abY, acZ), _mm256_mul_pd(acY, abZ));
+		__m256d vY = _mm256_sub_pd(_mm256_mul_pd(acX, abZ), _mm256_mul_pd(abX, acZ));
+		__m256d vZ = _mm256_sub_pd(_mm256_mul_pd(abX, acY), _mm256_mul_pd(acX, abY));
+
+		// Compute half the magnitude of all four cross products with one square root instruction.
+		__m256d squared = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vX, vX), _mm256_mul_pd(vY, vY)), _mm256_mul_pd(vZ, vZ));
+		_mm256_storeu_pd(out + (t - first), _mm256_mul_pd(half, _mm256_sqrt_pd(squared)));
+	}
+
+	// Finish the last one to three triangles with the SSE2 kernel.
+	calcAreasSse2(xs, ys, zs, indices, t, last, out + (t - first));
+}
+
+/*
+ * Runs the CPUID instruction for a leaf and sub-leaf.
+ *
+ * @param leaf The CPUID leaf to query.
+ * @param subLeaf The CPUID sub-leaf to query.
+ * @param registers Receives EAX, EBX, ECX and EDX in that order.
+ */
+static void readCpuid(int leaf, int subLeaf, unsigned int registers[4])
+{
+#ifdef _MSC_VER
+	// MSVC exposes CPUID as an intrinsic.
+	int values[4];
+	__cpuidex(values, leaf, subLeaf);
+	for (int i = 0; i < 4; i++)
+	{
+		registers[i] = static_cast<unsigned int>(values[i]);
+	}
+#else
+	// GCC and Clang accept CPUID as inline assembly.
+	__asm__ __volatile__("cpuid" : "=a"(registers[0]), "=b"(registers[1]), "=c"(registers[2]), "=d"(registers[3]) : "a"(leaf), "c"(subLeaf));
+#endif
+}
+
+/*
+ * Reads the XCR0 register to find out which register states the operating system saves.
+ *
+ * @return The low 32 bits of XCR0.
+ */
+static unsigned int readXcr0()
+{
+#ifdef _MSC_VER
+	// MSVC exposes XGETBV as an intrinsic.
+	return static_cast<unsigned int>(_xgetbv(0));
+#else
+	// GCC and Clang accept XGETBV as inline assembly.
+	unsigned int low;
+	unsigned int high;
+	__asm__ __volatile__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+	return low;
+#endif
+}
+#endif
+
+/*
+ * Checks whether the SIMD kernels give exact cross products for every triangle of a mesh.
+ * The kernels work in double precision, which is exact only while the vertex pool spans
+ * less than 2^26 on every axis. The extent comes from the box the mesh keeps up to date,
+ * so the pool is scanned only when that box is out of date.
+ *
+ * @param mesh The mesh whose triangles will be measured.
+ * @return True if the SIMD kernels are exact for the mesh.
+ */
+static bool isMeshFastPathSafe(const TriangleMesh& mesh)
+{
+	// An empty pool has nothing that could overflow.
+	Point minimum;
+	Point maximum;
+	if (!mesh.getBounds(minimum, maximum))
+	{
+		return true;
+	}
+
+	// Compare the extents in 64 bits so they cannot overflow; a pending offset moves both ends alike.
+	return isAreaFastPathSafe(static_cast<std::int64_t>(maximum.getCoordinateX()) - minimum.getCoordinateX(),
+		static_cast<std::int64_t>(maximum.getCoordinateY()) - minimum.getCoordinateY(),
+		static_cast<std::int64_t>(maximum.getCoordinateZ()) - minimum.getCoordinateZ());
+}
+
+/*
+ * Detects the fastest area kernel supported by the CPU.
+ *
+ * @return The best kernel available on this machine.
+ */
+static AreaKernel queryAreaKernel()
+{
+#ifdef AREA_KERNELS_X86
+	// Read the basic feature flags from CPUID leaf 1.
+	unsigned int registers[4];
+	readCpuid(0, 0, registers);
+	unsigned int maxLeaf = registers[0];
+	readCpuid(1, 0, registers);
+
+	// SSE2 is reported in bit 26 of EDX.
+	bool hasSse2 = (registers[3] & (1u << 26)) != 0;
+	// AVX needs bit 28 of ECX, and bit 27 (OSXSAVE) to be allowed to check that the OS saves YMM registers.
+	bool hasAvx = (registers[2] & (1u << 28)) != 0 && (registers[2] & (1u << 27)) != 0 && (readXcr0() & 0x6) == 0x6;
+
+	// AVX2 is reported in bit 5 of EBX in CPUID leaf 7.
+	bool hasAvx2 = false;
+	if (hasAvx && maxLeaf >= 7)
+	{
+		readCpuid(7, 0, registers);
+		hasAvx2 = (registers[1] & (1u << 5)) != 0;
+	}
+
+	// Prefer the widest kernel the CPU and the OS both support.
+	if (hasAvx2)
+	{
+		return AreaKernel::AVX2;
+	}
+	if (hasSse2)
+	{
+		return AreaKernel::SSE2;
+	}
+#endif
+	// Fall back to the scalar kernel on other processors.
+	return AreaKernel::Scalar;
+}
+
+/*
+ * Detects the fastest area kernel supported by the CPU, once per program run.
+ *
+ * @return The best kernel available on this machine.
+ */
+AreaKernel detectAreaKernel()
+{
+	// The static local is initialized on the first call only.
+	static const AreaKernel detected = queryAreaKernel();
+	return detected;
+}
+
+/*
+ * Returns a readable name for an area kernel.
+ *
+ * @param kernel The kernel to name.
+ * @return The name of the kernel.
+ */
+const char* getAreaKernelName(AreaKernel kernel)
+{
+	switch (kernel)
+	{
+	case AreaKernel::AVX2:
+		return "AVX2";
+	case AreaKernel::SSE2:
+		return "SSE2";
+	default:
+		return "Scalar";
+	}
+}
+
+/*
+ * Runs one kernel over a range of triangles, never a wider one than the CPU supports.
+ *
+ * @param kernel The kernel to use.
+ * @param xs The x-coordinates of the vertex pool.
+ * @param ys The y-coordinates of the vertex pool.
+ * @param zs The z-coordinates of the vertex pool.
+ * @param indices The index buffer, three indices per triangle.
+ * @param first The first triangle to measure.
+ * @param last One past the last triangle to measure.
+ * @param out The array receiving the areas, starting with the area of triangle first.
+ */
+static void runAreaKernel(AreaKernel kernel, const int* xs, const int* ys, const int* zs, const std::uint32_t* indices, std::size_t first, std::size_t last, double* out)
+{
+	// Never run a kernel wider than what the CPU supports.
+	if (static_cast<int>(kernel) > static_cast<int>(detectAreaKernel()))
+	{
+		kernel = detectAreaKernel();
+	}
+
+	// Dispatch to the selected kernel.
+	switch (kernel)
+	{
+#ifdef AREA_KERNELS_X86
+	case AreaKernel::AVX2:
+		calcAreasAvx2(xs, ys, zs, indices, first, last, out);
+		break;
+	case AreaKernel::SSE2:
+		calcAreasSse2(xs, ys, zs, indices, first, last, out);
+		break;
+#endif
+	default:
+		calcAreasScalar(xs, ys, zs, indices, first, last, out);
+		break;
+	}
+}
+
+/*
+ * Sums the areas of a run of triangles in fixed-size blocks on the stack, in index order.
+ *
+ * @param triangleCount The number of triangles.
+ * @param measure Called as measure(first, last, areas) to fill areas with the areas of triangles first to last.
+ * @return The total area.
+ */
+template <typename MeasureRange>
+static double sumAreasInOrder(std::size_t triangleCount, MeasureRange measure)
+{
+	// Number of triangles measured per block.
+	const std::size_t BLOCK_SIZE = 1024;
+	// Scratch storage for the areas of one block.
+	double areas[BLOCK_SIZE];
+
+	// Running sum of all areas.
+	double total = 0.0;
+
+	// Walk through the triangles one block at a time.
+	for (std::size_t first = 0; first < triangleCount; first += BLOCK_SIZE)
+	{
+		// The last block may be shorter than BLOCK_SIZE.
+		std::size_t last = first + BLOCK_SIZE < triangleCount ? first + BLOCK_SIZE : triangleCount;
+
+		// Measure the block.
+		measure(first, last, areas);
+
+		// Add the block's areas in order.
+		for (std::size_t i = 0; i < last - first; i++)
+		{
+			total += areas[i];
+		}
+	}
+
+	return total;
+}
+
+/*
+ * Selects the kernel to use for a whole mesh.
+ *
+ * @param mesh The mesh whose triangles will be measured.
+ * @return The fastest supported kernel that is exact for the mesh.
+ */
+AreaKernel selectAreaKernel(const TriangleMesh& mesh)
+{
+	// Meshes with far-apart coordinates need the exact scalar path.
+	return isMeshFastPathSafe(mesh) ? detectAreaKernel() : AreaKernel::Scalar;
+}
+
+/*
+ * Calculates the areas of a range of triangles with a kernel chosen by the caller.
+ *
+ * @param mesh The mesh whose triangles are measured.
+ * @param first The first triangle to measure.
+ * @param last One past the last triangle to measure.
+ * @param out The array receiving the areas, starting with the area of triangle first.
+ * @param kernel The kernel to use, normally the result of selectAreaKernel(mesh).
+ */
+void calcAreaRange(const TriangleMesh& mesh, std::size_t first, std::size_t last, double* out, AreaKernel kernel)
+{
+	// Read the raw arrays once so the kernels do not go through per-vertex getters.
+	const PointBuffer& vertices = mesh.getVertices();
+
+	// The AVX2 gathers read the indices as signed 32-bit offsets, so larger pools use the SSE2 kernel.
+	if (kernel == AreaKernel::AVX2 && vertices.size() > static_cast<std::size_t>(INT_MAX))
+	{
+		kernel = AreaKernel::SSE2;
+	}
+	runAreaKernel(kernel, vertices.dataX(), vertices.dataY(), vertices.dataZ(), mesh.getIndices(), first, last, out);
+}
+
+/*
+ * Calculates the area of every triangle in a mesh with the fastest supported kernel.
+ *
+ * @param mesh The mesh whose triangles are measured.
+ * @param out The array receiving one area per triangle.
+ */
+void calcAreas(const TriangleMesh& mesh, double* out)
+{
+	calcAreaRange(mesh, 0, mesh.getTriangleCount(), out, selectAreaKernel(mesh));
+}
+
+/*
+ * Calculates the area of every triangle in a mesh with a specific kernel.
+ *
+ * @param mesh The mesh whose triangles are measured.
+ * @param out The array receiving one area per triangle.
+ * @param kernel The kernel to use.
+ */
+void calcAreas(const TriangleMesh& mesh, double* out, AreaKernel kernel)
+{
+	// Meshes with far-apart coordinates need the exact scalar path.
+	if (kernel != AreaKernel::Scalar && !isMeshFastPathSafe(mesh))
+	{
+		kernel = AreaKernel::Scalar;
+	}
+	calcAreaRange(mesh, 0, mesh.getTriangleCount(), out, kernel);
+}
+
+/*
+ * Calculates the sum of the areas of all triangles in a mesh.
+ * Areas are computed in fixed-size blocks on the stack and summed in index order.
+ *
+ * @param mesh The mesh whose triangles are measured.
+ * @return The total surface area of the mesh.
+ */
+double totalArea(const TriangleMesh& mesh)
+{
+	// Select the kernel once for the whole mesh.
+	AreaKernel kernel = selectAreaKernel(mesh);
+	return sumAreasInOrder(mesh.getTriangleCount(), [&](std::size_t first, std::size_t last, double* areas)
+	{
+		calcAreaRange(mesh, first, last, areas, kernel);
+	});
+}
+
+/*
+ * Selects the kernel to use for triangles whose vertices are held in a compressed pool.
+ *
+ * @param vertices The compressed vertex pool.
+ * @return The fastest supported kernel that is exact for the pool.
+ */
+AreaKernel selectAreaKernel(const CompressedPointBuffer& vertices)
+{
+	// The same extent rule as for a mesh, with the box read from the block headers.
+	Point minimum;
+	Point maximum;
+	if (!vertices.getBounds(minimum, maximum))
+	{
+		return detectAreaKernel();
+	}
+	bool safe = isAreaFastPathSafe(static_cast<std::int64_t>(maximum.getCoordinateX()) - minimum.getCoordinateX(),
+		static_cast<std::int64_t>(maximum.getCoordinateY()) - minimum.getCoordinateY(), static_cast<std::int64_t>(maximum.getCoordinateZ()) - minimum.getCoordinateZ());
+	return safe ? detectAreaKernel() : AreaKernel::Scalar;
+}
+
+/*
+ * Calculates the areas of a range of triangles whose vertices are held in a compressed pool.
+ *
+ * @param vertices The compressed vertex pool.
+ * @param indices The index buffer, three indices per triangle.
+ * @param first The first triangle to measure.
+ * @param last One past the last triangle to measure.
+ * @param out The array receiving the areas, starting with the area of triangle first.
+ * @param kernel The kernel to use, normally the result of selectAreaKernel(vertices).
+ */
+void calcAreaRange(const CompressedPointBuffer& vertices, const std::uint32_t* indices, std::size_t first, std::size_t last, double* out, AreaKernel kernel)
+{
+	// Number of triangles whose corners are gathered at a time; the scratch arrays stay in the L1 cache.
+	const std::size_t GATHER_TRIANGLES = 256;
+	int xs[GATHER_TRIANGLES * 3];
+	int ys[GATHER_TRIANGLES * 3];
+	int zs[GATHER_TRIANGLES * 3];
+	// The gathered corners are laid out triangle by triangle, so the kernels read them through the identity index buffer.
+	std::uint32_t corners[GATHER_TRIANGLES * 3];
+	for (std::uint32_t i = 0; i < GATHER_TRIANGLES * 3; i++)
+	{
+		corners[i] = i;
+	}
+
+	for (std::size_t start = first; start < last; start += GATHER_TRIANGLES)
+	{
+		std::size_t count = start + GATHER_TRIANGLES < last ? GATHER_TRIANGLES : last - start;
+		vertices.gather(indices + start * 3, count * 3, xs, ys, zs);
+		runAreaKernel(kernel, xs, ys, zs, corners, 0, count, out + (start - first));
+	}
+}
+
+/*
+ * Calculates the sum of the areas of triangles whose vertices are held in a compressed pool.
+ *
+ * @param vertices The compressed vertex pool.
+ * @param indices The index buffer, three indices per triangle.
+ * @param triangleCount The number of triangles.
+ * @return The total surface area of the triangles.
+ */
+double totalArea(const CompressedPointBuffer& vertices, const std::uint32_t* indices, std::size_t triangleCount)
+{
+	// Select the kernel once for the whole pool.
+	AreaKernel kernel = selectAreaKernel(vertices);
+	return sumAreasInOrder(triangleCount, [&](std::size_t first, std::size_t last, double* areas)
+	{
+		calcAreaRange(vertices, indices, first, last, areas, kernel);
+	});
+}
@@ -0,0 +1,127 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef AREAKERNELS_H
+#define AREAKERNELS_H
+
+// Includes the TriangleMesh.h header file to compute areas over whole meshes.
+#include "TriangleMesh.h"
+// Includes the CompressedPointBuffer.h header file to measure triangles whose vertex pool is compressed.
+#include "CompressedPointBuffer.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+
+/*
+ * Lists the implementations available for the batch area computation.
+ * Scalar works everywhere, SSE2 handles 2 triangles per instruction and AVX2 handles 4.
+ * AVX2 addresses the vertex pool with signed 32-bit gathers, so pools of more than INT_MAX vertices run SSE2 instead.
+ */
+enum class AreaKernel
+{
+	Scalar,
+	SSE2,
+	AVX2
+};
+
+/*
+ * Detects the fastest area kernel supported by the CPU the program is running on.
+ * The detection runs once and the result is reused by later calls.
+ *
+ * @return The best kernel available on this machine.
+ */
+AreaKernel detectAreaKernel();
+
+/*
+ * Returns a readable name for an area kernel, such as "AVX2".
+ *
+ * @param kernel The kernel to name.
+ * @return The name of the kernel.
+ */
+const char* getAreaKernelName(AreaKernel kernel);
+
+/*
+ * Selects the kernel to use for a mesh: the fastest one the CPU supports, unless the mesh
+ * spans 2^26 or more on an axis, where only the exact scalar kernel gives correct areas.
+ * The extent is read from the mesh's bounding box, which scans the vertex pool only while that box is out of date,
+ * so callers measuring a read-only mesh in pieces should still call it once.
+ *
+ * @param mesh The mesh whose triangles will be measured.
+ * @return The kernel to pass to calcAreaRange for this mesh.
+ */
+AreaKernel selectAreaKernel(const TriangleMesh& mesh);
+
+/*
+ * Calculates the areas of a range of triangles with a kernel chosen by the caller.
+ *
+ * @param mesh The mesh whose triangles are measured.
+ * @param first The first triangle to measure.
+ * @param last One past the last triangle to measure.
+ * @param out The array receiving the areas, starting with the area of triangle first. It must hold last - first values.
+ * @param kernel The kernel to use, normally the result of selectAreaKernel(mesh).
+ */
+void calcAreaRange(const TriangleMesh& mesh, std::size_t first, std::size_t last, double* out, AreaKernel kernel);
+
+/*
+ * Calculates the area of every triangle in a mesh with the fastest kernel the CPU supports.
+ *
+ * @param mesh The mesh whose triangles are measured.
+ * @param out The array receiving one area per triangle. It must hold mesh.getTriangleCount() values.
+ */
+void calcAreas(const TriangleMesh& mesh, double* out);
+
+/*
+ * Calculates the area of every triangle in a mesh with a specific kernel.
+ * A kernel the CPU does not support falls back to the best supported one.
+ *
+ * @param mesh The mesh whose triangles are measured.
+ * @param out The array receiving one area per triangle. It must hold mesh.getTriangleCount() values.
+ * @param kernel The kernel to use.
+ */
+void calcAreas(const TriangleMesh& mesh, double* out, AreaKernel kernel);
+
+/*
+ * Calculates the sum of the areas of all triangles in a mesh.
+ * The triangles are summed in index order, so the result is the same on every run.
+ *
+ * @param mesh The mesh whose triangles are measured.
+ * @return The total surface area of the mesh.
+ */
+double totalArea(const TriangleMesh& mesh);
+
+/*
+ * Selects the kernel to use for triangles whose vertices are held in a compressed pool, with the same rule as
+ * selectAreaKernel(mesh). The extent comes from the block headers, so nothing is decoded.
+ *
+ * @param vertices The compressed vertex pool.
+ * @return The kernel to pass to calcAreaRange for this pool.
+ */
+AreaKernel selectAreaKernel(const CompressedPointBuffer& vertices);
+
+/*
+ * Calculates the areas of a range of triangles whose vertices are held in a compressed pool, such as a mesh's
+ * index buffer over a CompressedPointBuffer of its vertices. This is a separate overload rather than a TriangleMesh
+ * option, since a mesh cannot use a compressed pool as its own. The corners of a few hundred triangles at a time
+ * are gathered into a small scratch buffer, which the same kernels as calcAreaRange(mesh) then measure,
+ * so the areas are identical to those of the uncompressed mesh.
+ *
+ * @param vertices The compressed vertex pool.
+ * @param indices The index buffer, three indices per triangle, each below vertices.size().
+ * @param first The first triangle to measure.
+ * @param last One past the last triangle to measure.
+ * @param out The array receiving the areas, starting with the area of triangle first. It must hold last - first values.
+ * @param kernel The kernel to use, normally the result of selectAreaKernel(vertices).
+ */
+void calcAreaRange(const CompressedPointBuffer& vertices, const std::uint32_t* indices, std::size_t first, std::size_t last, double* out, AreaKernel kernel);
+
+/*
+ * Calculates the sum of the areas of triangles whose vertices are held in a compressed pool, in index order,
+ * giving the same result as totalArea(mesh) on the uncompressed mesh.
+ *
+ * @param vertices The compressed vertex pool.
+ * @param indices The index buffer, three indices per triangle.
+ * @param triangleCount The number of triangles.
+ * @return The total surface area of the triangles.
+ */
+double totalArea(const CompressedPointBuffer& vertices, const std::uint32_t* indices, std::size_t triangleCount);
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
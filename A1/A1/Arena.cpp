@@ -0,0 +1,172 @@
+// Includes the Arena.h header file for function declarations.
+#include "Arena.h"
+
+// Includes the cstdint library for std::uintptr_t, used to align addresses.
+#include <cstdint>
+// Includes the cstdlib library for std::malloc and std::free.
+#include <cstdlib>
+
+// Blocks are allocated with this alignment, so the first object of a block needs no padding.
+static const std::size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+/*
+ * Returns the size of a block header, rounded up to the block alignment.
+ *
+ * @return The size of the header in bytes.
+ */
+std::size_t Arena::blockHeaderSize()
+{
+	return (sizeof(Block) + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+}
+
+/*
+ * Returns the address where the usable memory of a block starts, right after its header.
+ *
+ * @param block The pointer to the block header.
+ * @return A pointer to the first usable byte.
+ */
+unsigned char* Arena::blockData(Block* block)
+{
+	return reinterpret_cast<unsigned char*>(block) + blockHeaderSize();
+}
+
+/*
+ * Constructor for the Arena class.
+ *
+ * @param blockSizeParameter The usable size in bytes of each block the arena allocates.
+ */
+Arena::Arena(std::size_t blockSizeParameter) : firstBlock(nullptr), currentBlock(nullptr), lastFinalizer(nullptr), blockSize(blockSizeParameter)
+{
+	// Constructor body is empty since initialization is done in the initialization list.
+}
+
+/*
+ * Destructor for the Arena class.
+ * Destroys the remaining objects, then returns every block to the system.
+ */
+Arena::~Arena()
+{
+	// Run the destructors of the objects still in the arena.
+	reset();
+
+	// Free the blocks one by one.
+	Block* block = firstBlock;
+	while (block != nullptr)
+	{
+		Block* next = block->next;
+		std::free(block);
+		block = next;
+	}
+}
+
+/*
+ * Hands out raw memory from the current block, moving to a new block when it is full.
+ *
+ * @param size The number of bytes needed.
+ * @param alignment The alignment the memory must have; a power of two.
+ * @return A pointer to the memory.
+ */
+void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+	// Try the current block first, then any blocks kept from before the last reset.
+	while (currentBlock != nullptr)
+	{
+		// Find the first properly aligned address after the memory already handed out.
+		std::uintptr_t start = reinterpret_cast<std::uintptr_t>(blockData(currentBlock)) + currentBlock->used;
+		std::uintptr_t aligned = (start + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+		std::size_t needed = static_cast<std::size_t>(aligned - start) + size;
+
+		// Hand out the memory if it fits in the rest of the block.
+		if (currentBlock->used + needed <= currentBlock->size)
+		{
+			currentBlock->used += needed;
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		// Stop at the last block; otherwise move on to the next one.
+		if (currentBlock->next == nullptr)
+		{
+			break;
+		}
+		currentBlock = currentBlock->next;
+	}
+
+	// Allocate a new block, large enough for the request even if it exceeds the usual block size.
+	std::size_t usable = size + alignment > blockSize ? size + alignment : blockSize;
+	void* memory = std::malloc(blockHeaderSize() + usable);
+	if (memory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	// Fill in the header of the new block.
+	Block* block = static_cast<Block*>(memory);
+	block->next = nullptr;
+	block->size = usable;
+	block->used = 0;
+
+	// Append the block to the list and make it current.
+	if (currentBlock == nullptr)
+	{
+		firstBlock = block;
+	}
+	else
+	{
+		currentBlock->next = block;
+	}
+	currentBlock = block;
+
+	// The new block is guaranteed to have room for the request.
+	return allocate(size, alignment);
+}
+
+/*
+ * Destroys every object in the arena and rewinds all blocks for reuse.
+ */
+void Arena::reset()
+{
+	// Run the destructors from the newest object to the oldest.
+	while (lastFinalizer != nullptr)
+	{
+		Finalizer* finalizer = lastFinalizer;
+		lastFinalizer = finalizer->previous;
+		finalizer->destroy(finalizer->object);
+	}
+
+	// Mark every block as empty, keeping the memory for the next scene.
+	for (Block* block = firstBlock; block != nullptr; block = block->next)
+	{
+		block->used = 0;
+	}
+	currentBlock = firstBlock;
+}
+
+/*
+ * Returns the number of bytes handed out since the last reset.
+ *
+ * @return The number of bytes in use.
+ */
+std::size_t Arena::getBytesUsed() const
+{
+	std::size_t total = 0;
+	for (Block* block = firstBlock; block != nullptr; block = block->next)
+	{
+		total += block->used;
+	}
+	return total;
+}
+
+/*
+ * Returns the number of usable bytes in all blocks owned by the arena.
+ *
+ * @return The number of bytes reserved from the system.
+ */
+std::size_t Arena::getBytesReserved() const
+{
+	std::size_t total = 0;
+	for (Block* block = firstBlock; block != nullptr; block = block->next)
+	{
+		total += block->size;
+	}
+	return total;
+}
@@ -0,0 +1,158 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef ARENA_H
+#define ARENA_H
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the new library for placement new.
+#include <new>
+// Includes the type_traits library to skip destructor bookkeeping for trivially destructible types.
+#include <type_traits>
+// Includes the utility library for std::forward.
+#include <utility>
+
+/*
+ * Defines an Arena class, a monotonic allocator that hands out memory from large blocks.
+ * Objects are never freed one by one; reset() destroys every object created since the last
+ * reset and rewinds the blocks so the next scene reuses the same memory without calling malloc.
+ */
+class Arena
+{
+private:
+	/*
+	 * Header stored at the start of every block of memory owned by the arena.
+	 */
+	struct Block
+	{
+		// The next block in the arena's list, or nullptr for the last block.
+		Block* next;
+		// Number of usable bytes after the header.
+		std::size_t size;
+		// Number of usable bytes already handed out.
+		std::size_t used;
+	};
+
+	/*
+	 * Record of an object whose destructor must run when the arena is reset.
+	 * Records are allocated inside the arena itself.
+	 */
+	struct Finalizer
+	{
+		// Function that calls the destructor of the object.
+		void (*destroy)(void*);
+		// The object to destroy.
+		void* object;
+		// The record created before this one, or nullptr.
+		Finalizer* previous;
+	};
+
+	// First block in the arena's list, or nullptr if nothing has been allocated yet.
+	Block* firstBlock;
+	// Block that new allocations are currently carved from.
+	Block* currentBlock;
+	// Most recently registered finalizer; finalizers run from newest to oldest.
+	Finalizer* lastFinalizer;
+	// Usable size of each new block, unless a single allocation needs more.
+	std::size_t blockSize;
+
+	/*
+	 * Returns the address where the usable memory of a block starts, right after its header.
+	 *
+	 * @param block The pointer to the block header.
+	 * @return A pointer to the first usable byte.
+	 */
+	static unsigned char* blockData(Block* block);
+
+	/*
+	 * Returns the size of a block header, rounded up so the usable memory keeps the block alignment.
+	 *
+	 * @return The size of the header in bytes.
+	 */
+	static std::size_t blockHeaderSize();
+
+	/*
+	 * Calls the destructor of an object of type T.
+	 *
+	 * @param object The object to destroy.
+	 */
+	template <typename T>
+	static void destroyObject(void* object)
+	{
+		static_cast<T*>(object)->~T();
+	}
+
+public:
+	/*
+	 * Constructor for the Arena class. No memory is allocated until the first object is created.
+	 *
+	 * @param blockSizeParameter The usable size in bytes of each block the arena allocates.
+	 */
+	explicit Arena(std::size_t blockSizeParameter = 64 * 1024);
+
+	/*
+	 * Destructor for the Arena class.
+	 * It destroys every object still in the arena and frees all blocks.
+	 */
+	~Arena();
+
+	// The arena owns its blocks, so it cannot be copied.
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	/*
+	 * Hands out raw memory from the current block, moving to a new block when it is full.
+	 *
+	 * @param size The number of bytes needed.
+	 * @param alignment The alignment the memory must have; a power of two.
+	 * @return A pointer to the memory. It stays valid until the arena is reset or destroyed.
+	 */
+	void* allocate(std::size_t size, std::size_t alignment);
+
+	/*
+	 * Constructs an object inside the arena.
+	 * Its destructor runs when the arena is reset or destroyed, never earlier.
+	 *
+	 * @param args The arguments passed to the object's constructor.
+	 * @return A pointer to the new object.
+	 */
+	template <typename T, typename... Args>
+	T* create(Args&&... args)
+	{
+		// Construct the object in memory taken from the current block.
+		T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+		// Only objects with a real destructor need a finalizer record.
+		if (!std::is_trivially_destructible<T>::value)
+		{
+			Finalizer* finalizer = new (allocate(sizeof(Finalizer), alignof(Finalizer))) Finalizer;
+			finalizer->destroy = &destroyObject<T>;
+			finalizer->object = object;
+			finalizer->previous = lastFinalizer;
+			lastFinalizer = finalizer;
+		}
+		return object;
+	}
+
+	/*
+	 * Destroys every object in the arena and rewinds all blocks for reuse.
+	 * Pointers to objects created before the reset must no longer be used.
+	 */
+	void reset();
+
+	/*
+	 * Returns the number of bytes handed out since the last reset, including padding.
+	 *
+	 * @return The number of bytes in use.
+	 */
+	std::size_t getBytesUsed() const;
+
+	/*
+	 * Returns the number of usable bytes in all blocks owned by the arena.
+	 *
+	 * @return The number of bytes reserved from the system.
+	 */
+	std::size_t getBytesReserved() const;
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -0,0 +1,428 @@
+// Includes the CompressedPointBuffer.h header file for function declarations.
+#include "CompressedPointBuffer.h"
+// Includes the ExactMath.h header file for the overflow-free area calculation.
+#include "ExactMath.h"
+
+// Includes the input/output stream library for IO operations.
+#include <iostream>
+
+// Decodes with SSE2 wherever the compiler may use it without a check: on every x64 processor,
+// and on 32-bit x86 when the build targets SSE2.
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COMPRESSED_POINTS_SSE2 1
+// Includes the SSE2 intrinsics.
+#include <emmintrin.h>
+#endif
+
+// Largest span of an axis in a block that still fits in 16-bit deltas.
+static const std::uint32_t NARROW_SPAN_MAX = 0xFFFF;
+
+/*
+ * Default constructor for the CompressedPointBuffer class.
+ */
+CompressedPointBuffer::CompressedPointBuffer() : count(0)
+{
+	// Constructor body is empty since the block and delta vectors start empty.
+}
+
+/*
+ * Constructor for the CompressedPointBuffer class that compresses the points of a PointBuffer.
+ *
+ * @param points The points to compress.
+ */
+CompressedPointBuffer::CompressedPointBuffer(const PointBuffer& points) : count(0)
+{
+	assign(points);
+}
+
+/*
+ * Replaces the contents of the buffer with the compressed points of a PointBuffer.
+ *
+ * @param points The points to compress.
+ */
+void CompressedPointBuffer::assign(const PointBuffer& points)
+{
+	clear();
+	count = points.size();
+	const int* coordinates[3] = { points.dataX(), points.dataY(), points.dataZ() };
+
+	std::size_t blockCount = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	blocks.resize(blockCount);
+	// Most axes fit in 16 bits, so reserve for that case.
+	narrow.reserve(count * 3);
+
+	for (std::size_t b = 0; b < blockCount; b++)
+	{
+		std::size_t first = b * BLOCK_SIZE;
+		std::size_t last = first + BLOCK_SIZE < count ? first + BLOCK_SIZE : count;
+		Block& block = blocks[b];
+		block.wideAxes = 0;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			const int* values = coordinates[axis];
+			// The span of the axis in this block decides whether its deltas fit in 16 bits.
+			int low = values[first];
+			int high = values[first];
+			for (std::size_t i = first + 1; i < last; i++)
+			{
+				low = values[i] < low ? values[i] : low;
+				high = values[i] > high ? values[i] : high;
+			}
+			block.origin[axis] = low;
+			block.span[axis] = static_cast<std::uint32_t>(high) - static_cast<std::uint32_t>(low);
+
+			// The deltas are computed in unsigned arithmetic, where they never overflow.
+			if (block.span[axis] <= NARROW_SPAN_MAX)
+			{
+				block.offset[axis] = narrow.size();
+				for (std::size_t i = first; i < last; i++)
+				{
+					narrow.push_back(static_cast<std::uint16_t>(static_cast<std::uint32_t>(values[i]) - static_cast<std::uint32_t>(low)));
+				}
+			}
+			else
+			{
+				block.wideAxes |= 1u << axis;
+				block.offset[axis] = wide.size();
+				for (std::size_t i = first; i < last; i++)
+				{
+					wide.push_back(static_cast<std::uint32_t>(values[i]) - static_cast<std::uint32_t>(low));
+				}
+			}
+		}
+	}
+
+	// Give back what the reservation did not use.
+	narrow.shrink_to_fit();
+	wide.shrink_to_fit();
+}
+
+/*
+ * Decodes every point back into a PointBuffer.
+ *
+ * @param points Receives the points, replacing its previous contents.
+ */
+void CompressedPointBuffer::decompress(PointBuffer& points) const
+{
+	points.clear();
+	points.resize(count);
+	int* xs = points.dataX();
+	int* ys = points.dataY();
+	int* zs = points.dataZ();
+	// Each block decodes straight into its place in the buffer.
+	for (std::size_t b = 0; b < blocks.size(); b++)
+	{
+		decodeBlock(b, xs + b * BLOCK_SIZE, ys + b * BLOCK_SIZE, zs + b * BLOCK_SIZE);
+	}
+}
+
+/*
+ * Removes all points and frees the memory.
+ */
+void CompressedPointBuffer::clear()
+{
+	count = 0;
+	std::vector<Block>().swap(blocks);
+	std::vector<std::uint16_t>().swap(narrow);
+	std::vector<std::uint32_t>().swap(wide);
+}
+
+/*
+ * Returns the number of points stored.
+ *
+ * @return The number of points.
+ */
+std::size_t CompressedPointBuffer::size() const
+{
+	return count;
+}
+
+/*
+ * Returns the number of blocks the points are cut into.
+ *
+ * @return The number of blocks.
+ */
+std::size_t CompressedPointBuffer::getBlockCount() const
+{
+	return blocks.size();
+}
+
+/*
+ * Returns the number of bytes the block headers and the deltas take up.
+ *
+ * @return The memory used, in bytes.
+ */
+std::size_t CompressedPointBuffer::getMemoryUsage() const
+{
+	return blocks.capacity() * sizeof(Block) + narrow.capacity() * sizeof(std::uint16_t) + wide.capacity() * sizeof(std::uint32_t);
+}
+
+/*
+ * Decodes one axis of one block, eight 16-bit or four 32-bit deltas per SSE2 step.
+ *
+ * @param block The index of the block.
+ * @param axis The axis to decode: 0 for x, 1 for y, or 2 for z.
+ * @param out Receives the coordinates of the points in the block.
+ */
+void CompressedPointBuffer::decodeAxis(std::size_t block, int axis, int* out) const
+{
+	const Block& header = blocks[block];
+	std::size_t first = block * BLOCK_SIZE;
+	std::size_t points = first + BLOCK_SIZE < count ? BLOCK_SIZE : count - first;
+	std::uint32_t origin = static_cast<std::uint32_t>(header.origin[axis]);
+	std::size_t i = 0;
+
+	if (header.wideAxes & (1u << axis))
+	{
+		const std::uint32_t* deltas = wide.data() + header.offset[axis];
+#ifdef COMPRESSED_POINTS_SSE2
+		// Adding 32-bit lanes wraps around, which is exactly how the deltas were made.
+		const __m128i base = _mm_set1_epi32(static_cast<int>(origin));
+		for (; i + 4 <= points; i += 4)
+		{
+			__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(deltas + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(values, base));
+		}
+#endif
+		// Finish the points left over, or all of them without SSE2.
+		for (; i < points; i++)
+		{
+			out[i] = static_cast<int>(origin + deltas[i]);
+		}
+	}
+	else
+	{
+		const std::uint16_t* deltas = narrow.data() + header.offset[axis];
+#ifdef COMPRESSED_POINTS_SSE2
+		// Widen eight deltas to 32 bits by interleaving them with zeros, then add the origin.
+		const __m128i base = _mm_set1_epi32(static_cast<int>(origin));
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 8 <= points; i += 8)
+		{
+			__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(deltas + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(_mm_unpacklo_epi16(values, zero), base));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_add_epi32(_mm_unpackhi_epi16(values, zero), base));
+		}
+#endif
+		// Finish the points left over, or all of them without SSE2.
+		for (; i < points; i++)
+		{
+			out[i] = static_cast<int>(origin + deltas[i]);
+		}
+	}
+}
+
+/*
+ * Decodes the points of one block into three coordinate arrays.
+ *
+ * @param block The index of the block.
+ * @param xs Receives the x-coordinates.
+ * @param ys Receives the y-coordinates.
+ * @param zs Receives the z-coordinates.
+ * @return The number of points in the block.
+ */
+std::size_t CompressedPointBuffer::decodeBlock(std::size_t block, int* xs, int* ys, int* zs) const
+{
+	decodeAxis(block, 0, xs);
+	decodeAxis(block, 1, ys);
+	decodeAxis(block, 2, zs);
+	std::size_t first = block * BLOCK_SIZE;
+	return first + BLOCK_SIZE < count ? BLOCK_SIZE : count - first;
+}
+
+/*
+ * Returns one coordinate of a point.
+ *
+ * @param index The index of the point.
+ * @param axis The axis: 0 for x, 1 for y, or 2 for z.
+ * @return The coordinate.
+ */
+int CompressedPointBuffer::getCoordinate(std::size_t index, int axis) const
+{
+	const Block& header = blocks[index / BLOCK_SIZE];
+	std::size_t position = header.offset[axis] + index % BLOCK_SIZE;
+	std::uint32_t delta = header.wideAxes & (1u << axis) ? wide[position] : narrow[position];
+	return static_cast<int>(static_cast<std::uint32_t>(header.origin[axis]) + delta);
+}
+
+/*
+ * Decodes the points at a list of indices, in that order.
+ *
+ * @param indices The indices of the points.
+ * @param indexCount The number of indices.
+ * @param xs Receives the x-coordinates.
+ * @param ys Receives the y-coordinates.
+ * @param zs Receives the z-coordinates.
+ */
+void CompressedPointBuffer::gather(const std::uint32_t* indices, std::size_t indexCount, int* xs, int* ys, int* zs) const
+{
+	int* out[3] = { xs, ys, zs };
+	for (std::size_t i = 0; i < indexCount; i++)
+	{
+		// Each point reads its block header once for all three axes.
+		const Block& header = blocks[indices[i] / BLOCK_SIZE];
+		std::size_t position = indices[i] % BLOCK_SIZE;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			std::uint32_t delta = header.wideAxes & (1u << axis) ? wide[header.offset[axis] + position] : narrow[header.offset[axis] + position];
+			out[axis][i] = static_cast<int>(static_cast<std::uint32_t>(header.origin[axis]) + delta);
+		}
+	}
+}
+
+/*
+ * Returns the axis-aligned box around every point, read from the block headers.
+ *
+ * @param minimum Receives the smallest coordinate on each axis.
+ * @param maximum Receives the largest coordinate on each axis.
+ * @return True if the box was returned, false if the buffer is empty.
+ */
+bool CompressedPointBuffer::getBounds(Point& minimum, Point& maximum) const
+{
+	if (blocks.empty())
+	{
+		return false;
+	}
+
+	// A block's origin is its smallest coordinate and the origin plus its span its largest, both real coordinates.
+	int lowest[3] = { blocks[0].origin[0], blocks[0].origin[1], blocks[0].origin[2] };
+	int highest[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		highest[axis] = static_cast<int>(static_cast<std::uint32_t>(blocks[0].origin[axis]) + blocks[0].span[axis]);
+	}
+	for (std::size_t b = 1; b < blocks.size(); b++)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			int low = blocks[b].origin[axis];
+			int high = static_cast<int>(static_cast<std::uint32_t>(low) + blocks[b].span[axis]);
+			lowest[axis] = low < lowest[axis] ? low : lowest[axis];
+			highest[axis] = high > highest[axis] ? high : highest[axis];
+		}
+	}
+	minimum = Point(lowest[0], lowest[1], lowest[2]);
+	maximum = Point(highest[0], highest[1], highest[2]);
+	return true;
+}
+
+/*
+ * Returns the coordinates of the point at the given index.
+ *
+ * @param index The index of the point.
+ * @return A Point holding its coordinates.
+ */
+Point CompressedPointBuffer::getPoint(std::size_t index) const
+{
+	return Point(getCoordinate(index, 0), getCoordinate(index, 1), getCoordinate(index, 2));
+}
+
+/*
+ * Returns the x-coordinate of the point at the given index.
+ *
+ * @param index The index of the point.
+ * @return The x-coordinate.
+ */
+int CompressedPointBuffer::getCoordinateX(std::size_t index) const
+{
+	return getCoordinate(index, 0);
+}
+
+/*
+ * Returns the y-coordinate of the point at the given index.
+ *
+ * @param index The index of the point.
+ * @return The y-coordinate.
+ */
+int CompressedPointBuffer::getCoordinateY(std::size_t index) const
+{
+	return getCoordinate(index, 1);
+}
+
+/*
+ * Returns the z-coordinate of the point at the given index.
+ *
+ * @param index The index of the point.
+ * @return The z-coordinate.
+ */
+int CompressedPointBuffer::getCoordinateZ(std::size_t index) const
+{
+	return getCoordinate(index, 2);
+}
+
+/*
+ * Calculates the area of the triangle formed by three of the points.
+ *
+ * @param a The index of the first vertex.
+ * @param b The index of the second vertex.
+ * @param c The index of the third vertex.
+ * @return The area of the triangle.
+ */
+double CompressedPointBuffer::calcArea(std::size_t a, std::size_t b, std::size_t c) const
+{
+	return calcTriangleArea(getCoordinate(a, 0), getCoordinate(a, 1), getCoordinate(a, 2),
+		getCoordinate(b, 0), getCoordinate(b, 1), getCoordinate(b, 2),
+		getCoordinate(c, 0), getCoordinate(c, 1), getCoordinate(c, 2));
+}
+
+/*
+ * Translates every point by a specified distance along a given axis by moving the block origins.
+ *
+ * @param d The distance by which to translate the points.
+ * @param axis The axis along which to translate ('x', 'y', or 'z').
+ * @return 0 if successful, -1 if the axis is invalid.
+ */
+int CompressedPointBuffer::translate(int d, char axis)
+{
+	// Turn the axis letter into the index of the origin coordinate.
+	int index;
+	switch (axis)
+	{
+	case 'x':
+		index = 0;
+		break;
+	case 'y':
+		index = 1;
+		break;
+	case 'z':
+		index = 2;
+		break;
+	// If the axis is invalid, return -1 indicating an error.
+	default:
+		return -1;
+	}
+
+	for (std::size_t b = 0; b < blocks.size(); b++)
+	{
+		blocks[b].origin[index] += d;
+	}
+	return 0;
+}
+
+/*
+ * Translates every point by an offset on all three axes by moving the block origins.
+ *
+ * @param dx The distance to translate along the x-axis.
+ * @param dy The distance to translate along the y-axis.
+ * @param dz The distance to translate along the z-axis.
+ */
+void CompressedPointBuffer::translate(int dx, int dy, int dz)
+{
+	for (std::size_t b = 0; b < blocks.size(); b++)
+	{
+		blocks[b].origin[0] += dx;
+		blocks[b].origin[1] += dy;
+		blocks[b].origin[2] += dz;
+	}
+}
+
+/*
+ * Displays the coordinates of the point at the given index in the format (x, y, z).
+ *
+ * @param index The index of the point.
+ */
+void CompressedPointBuffer::displayPoint(std::size_t index) const
+{
+	std::cout << "(" << getCoordinate(index, 0) << ", " << getCoordinate(index, 1) << ", " << getCoordinate(index, 2) << ")\n";
+}
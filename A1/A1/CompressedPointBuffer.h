@@ -0,0 +1,233 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef COMPRESSEDPOINTBUFFER_H
+#define COMPRESSEDPOINTBUFFER_H
+
+// Includes the PointBuffer.h header file to compress and restore whole vertex pools.
+#include "PointBuffer.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the cstdint library for the 16-bit and 32-bit deltas.
+#include <cstdint>
+// Includes the vector library for the block headers and the delta streams.
+#include <vector>
+
+/*
+ * Defines a CompressedPointBuffer class that stores a large set of 3D points in less memory than a PointBuffer.
+ * The points are cut into blocks of BLOCK_SIZE consecutive points. Each block keeps its smallest coordinates
+ * as an origin, and each point keeps its offset from that origin: in 16 bits on every axis where the block
+ * spans less than 65536, which is 6 bytes per point instead of 12, and in 32 bits on the other axes.
+ * Points that are close in space should be close in the buffer, for example after reorderMeshByMortonCode().
+ * Blocks are decoded with SSE2, either into caller buffers or back into a PointBuffer, and a translation
+ * only moves the block origins. The buffer is built in one go and cannot be edited point by point.
+ * It is a secondary, read-mostly copy of a pool, not a drop-in replacement for PointBuffer: TriangleMesh always
+ * keeps its vertices in a PointBuffer, and no mesh operation reads this class. Only its own decodeBlock(), gather(),
+ * translate() and getBounds() work on it directly, along with the area overloads in AreaKernels.h, which take it
+ * with the mesh's index buffer and run the same SIMD kernels on the gathered corners. Anything else, such as
+ * welding, sorting or editing, needs the pool restored into a PointBuffer with decompress() first.
+ */
+class CompressedPointBuffer
+{
+private:
+	/*
+	 * The origin of a block and where the deltas of each of its axes start.
+	 */
+	struct Block
+	{
+		// The smallest coordinates of the points in the block, plus any translation since.
+		int origin[3];
+		// Where the deltas of each axis start, in the narrow or the wide stream. A size_t, since a scan of more than
+		// about 1.4 billion points puts more than 2^32 deltas in the narrow stream.
+		std::size_t offset[3];
+		// The largest delta on each axis, so the bounds of the buffer come from the headers alone.
+		std::uint32_t span[3];
+		// Bit k is set if axis k is stored in the wide stream.
+		std::uint32_t wideAxes;
+	};
+
+	// Number of points stored.
+	std::size_t count;
+	// One header per block.
+	std::vector<Block> blocks;
+	// 16-bit deltas of the axes that fit in them, one run of up to BLOCK_SIZE values per block and axis.
+	std::vector<std::uint16_t> narrow;
+	// 32-bit deltas of the other axes, wrapping around like unsigned numbers.
+	std::vector<std::uint32_t> wide;
+
+	/*
+	 * Decodes one axis of one block.
+	 *
+	 * @param block The index of the block.
+	 * @param axis The axis to decode: 0 for x, 1 for y, or 2 for z.
+	 * @param out Receives the coordinates of the points in the block.
+	 */
+	void decodeAxis(std::size_t block, int axis, int* out) const;
+
+	/*
+	 * Returns one coordinate of a point.
+	 *
+	 * @param index The index of the point.
+	 * @param axis The axis: 0 for x, 1 for y, or 2 for z.
+	 * @return The coordinate.
+	 */
+	int getCoordinate(std::size_t index, int axis) const;
+
+public:
+	// Number of points in a block; the last block may hold fewer. A multiple of 8, the points one SSE2 step decodes.
+	static constexpr std::size_t BLOCK_SIZE = 256;
+
+	/*
+	 * Default constructor for the CompressedPointBuffer class.
+	 * Creates an empty buffer.
+	 */
+	CompressedPointBuffer();
+
+	/*
+	 * Constructor for the CompressedPointBuffer class that compresses the points of a PointBuffer.
+	 *
+	 * @param points The points to compress.
+	 */
+	explicit CompressedPointBuffer(const PointBuffer& points);
+
+	/*
+	 * Replaces the contents of the buffer with the compressed points of a PointBuffer.
+	 *
+	 * @param points The points to compress.
+	 */
+	void assign(const PointBuffer& points);
+
+	/*
+	 * Decodes every point back into a PointBuffer.
+	 *
+	 * @param points Receives the points, replacing its previous contents.
+	 */
+	void decompress(PointBuffer& points) const;
+
+	/*
+	 * Removes all points and frees the memory.
+	 */
+	void clear();
+
+	/*
+	 * Returns the number of points stored.
+	 *
+	 * @return The number of points.
+	 */
+	std::size_t size() const;
+
+	/*
+	 * Returns the number of blocks the points are cut into.
+	 *
+	 * @return The number of blocks.
+	 */
+	std::size_t getBlockCount() const;
+
+	/*
+	 * Returns the number of bytes the block headers and the deltas take up.
+	 *
+	 * @return The memory used, in bytes.
+	 */
+	std::size_t getMemoryUsage() const;
+
+	/*
+	 * Decodes the points of one block into three coordinate arrays.
+	 *
+	 * @param block The index of the block.
+	 * @param xs Receives the x-coordinates. It must hold BLOCK_SIZE values.
+	 * @param ys Receives the y-coordinates. It must hold BLOCK_SIZE values.
+	 * @param zs Receives the z-coordinates. It must hold BLOCK_SIZE values.
+	 * @return The number of points in the block.
+	 */
+	std::size_t decodeBlock(std::size_t block, int* xs, int* ys, int* zs) const;
+
+	/*
+	 * Decodes the points at a list of indices, in that order, for kernels that work on coordinate arrays.
+	 *
+	 * @param indices The indices of the points, each below size().
+	 * @param indexCount The number of indices.
+	 * @param xs Receives the x-coordinates. It must hold indexCount values.
+	 * @param ys Receives the y-coordinates. It must hold indexCount values.
+	 * @param zs Receives the z-coordinates. It must hold indexCount values.
+	 */
+	void gather(const std::uint32_t* indices, std::size_t indexCount, int* xs, int* ys, int* zs) const;
+
+	/*
+	 * Returns the axis-aligned box around every point, read from the block headers without decoding any point.
+	 *
+	 * @param minimum Receives the smallest coordinate on each axis.
+	 * @param maximum Receives the largest coordinate on each axis.
+	 * @return True if the box was returned, false if the buffer is empty.
+	 */
+	bool getBounds(Point& minimum, Point& maximum) const;
+
+	/*
+	 * Returns the coordinates of the point at the given index.
+	 *
+	 * @param index The index of the point.
+	 * @return A Point holding its coordinates.
+	 */
+	Point getPoint(std::size_t index) const;
+
+	/*
+	 * Returns the x-coordinate of the point at the given index.
+	 *
+	 * @param index The index of the point.
+	 * @return The x-coordinate.
+	 */
+	int getCoordinateX(std::size_t index) const;
+
+	/*
+	 * Returns the y-coordinate of the point at the given index.
+	 *
+	 * @param index The index of the point.
+	 * @return The y-coordinate.
+	 */
+	int getCoordinateY(std::size_t index) const;
+
+	/*
+	 * Returns the z-coordinate of the point at the given index.
+	 *
+	 * @param index The index of the point.
+	 * @return The z-coordinate.
+	 */
+	int getCoordinateZ(std::size_t index) const;
+
+	/*
+	 * Calculates the area of the triangle formed by three of the points, exactly as TriangleMesh::calcArea() does.
+	 *
+	 * @param a The index of the first vertex.
+	 * @param b The index of the second vertex.
+	 * @param c The index of the third vertex.
+	 * @return The area of the triangle.
+	 */
+	double calcArea(std::size_t a, std::size_t b, std::size_t c) const;
+
+	/*
+	 * Translates every point by a specified distance along a given axis.
+	 * Only the block origins move, so this takes one step per block instead of one per point.
+	 *
+	 * @param d The distance by which to translate the points.
+	 * @param axis The axis along which to translate ('x', 'y', or 'z').
+	 * @return 0 if successful, -1 if the axis is invalid.
+	 */
+	int translate(int d, char axis);
+
+	/*
+	 * Translates every point by an offset on all three axes at once.
+	 *
+	 * @param dx The distance to translate along the x-axis.
+	 * @param dy The distance to translate along the y-axis.
+	 * @param dz The distance to translate along the z-axis.
+	 */
+	void translate(int dx, int dy, int dz);
+
+	/*
+	 * Displays the coordinates of the point at the given index in the format (x, y, z).
+	 *
+	 * @param index The index of the point.
+	 */
+	void displayPoint(std::size_t index) const;
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
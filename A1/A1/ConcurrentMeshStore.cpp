@@ -0,0 +1,263 @@
+// Includes the ConcurrentMeshStore.h header file for function declarations.
+#include "ConcurrentMeshStore.h"
+
+// Includes the climits library for the largest epoch value.
+#include <climits>
+// Includes the functional library for std::hash, used to spread readers over the slots.
+#include <functional>
+// Includes the thread library to identify readers and to yield when every slot is taken.
+#include <thread>
+// Includes the utility library for std::move.
+#include <utility>
+
+/*
+ * Constructor for the Snapshot class, used by the store only.
+ *
+ * @param slotParameter The slot in which the reader announced its epoch.
+ * @param versionParameter The version being read.
+ */
+ConcurrentMeshStore::Snapshot::Snapshot(ReaderSlot* slotParameter, const Version* versionParameter) : slot(slotParameter), version(versionParameter)
+{
+	// Constructor body is empty since initialization is done in the initialization list.
+}
+
+/*
+ * Destructor for the Snapshot class.
+ * It frees the reader slot, which tells writers the reader no longer uses any version.
+ */
+ConcurrentMeshStore::Snapshot::~Snapshot()
+{
+	if (slot != nullptr)
+	{
+		slot->epoch.store(0);
+	}
+}
+
+/*
+ * Move constructor that takes over the reader slot of another snapshot.
+ *
+ * @param other The snapshot to move from. It no longer holds a version.
+ */
+ConcurrentMeshStore::Snapshot::Snapshot(Snapshot&& other) noexcept : slot(other.slot), version(other.version)
+{
+	other.slot = nullptr;
+	other.version = nullptr;
+}
+
+/*
+ * Read-only access to the mesh of this version.
+ *
+ * @return A reference to the mesh.
+ */
+const TriangleMesh& ConcurrentMeshStore::Snapshot::getMesh() const
+{
+	return version->mesh;
+}
+
+/*
+ * Returns the number of the version being read.
+ *
+ * @return The version number.
+ */
+unsigned long long ConcurrentMeshStore::Snapshot::getVersion() const
+{
+	return version->number;
+}
+
+/*
+ * Default constructor for the ConcurrentMeshStore class.
+ * Publishes an empty mesh as version 1.
+ */
+ConcurrentMeshStore::ConcurrentMeshStore() : ConcurrentMeshStore(TriangleMesh())
+{
+	// Constructor body is empty since the delegated constructor publishes the first version.
+}
+
+/*
+ * Constructor that publishes an existing mesh as version 1.
+ *
+ * @param mesh The initial triangles.
+ */
+ConcurrentMeshStore::ConcurrentMeshStore(TriangleMesh mesh) : current(nullptr), globalEpoch(1)
+{
+	// Every reader slot starts free.
+	for (std::size_t i = 0; i < MAX_READERS; i++)
+	{
+		readers[i].epoch.store(0);
+	}
+
+	// Publish the first version. Snapshots are read by many threads at once, so the area cache, which calcArea updates, stays off,
+	// and the box and the centroid are stored now so their queries answer without scanning.
+	mesh.setAreaCacheEnabled(false);
+	mesh.refreshBoundsCache();
+	current.store(new Version{ std::move(mesh), 1 });
+}
+
+/*
+ * Destructor for the ConcurrentMeshStore class.
+ * Frees the latest version and every version still waiting to be freed.
+ */
+ConcurrentMeshStore::~ConcurrentMeshStore()
+{
+	for (std::size_t i = 0; i < retired.size(); i++)
+	{
+		delete retired[i].version;
+	}
+	delete current.load();
+}
+
+/*
+ * Takes a snapshot of the latest version without locking.
+ *
+ * @return A snapshot of the latest published version.
+ */
+ConcurrentMeshStore::Snapshot ConcurrentMeshStore::read()
+{
+	// Start the search at a slot derived from the thread, so readers on different threads rarely collide.
+	std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_READERS;
+
+	while (true)
+	{
+		// Announce the current epoch in a free slot. The epoch is read before the version is loaded,
+		// so a writer that sees the announcement keeps every version this reader could load.
+		unsigned long long epoch = globalEpoch.load();
+		for (std::size_t i = 0; i < MAX_READERS; i++)
+		{
+			ReaderSlot& slot = readers[(start + i) % MAX_READERS];
+			unsigned long long expected = 0;
+			if (slot.epoch.compare_exchange_strong(expected, epoch))
+			{
+				return Snapshot(&slot, current.load());
+			}
+		}
+
+		// Every slot is taken; let another thread run and try again.
+		std::this_thread::yield();
+	}
+}
+
+/*
+ * Frees every retired version that no active reader can still see.
+ * A reader that announced epoch e may hold any version retired at epoch e or later, so a version
+ * retired at epoch r can be freed once every active reader announced an epoch after r.
+ */
+void ConcurrentMeshStore::reclaim()
+{
+	// Find the oldest epoch still announced by a reader.
+	unsigned long long oldest = ULLONG_MAX;
+	for (std::size_t i = 0; i < MAX_READERS; i++)
+	{
+		unsigned long long epoch = readers[i].epoch.load();
+		if (epoch != 0 && epoch < oldest)
+		{
+			oldest = epoch;
+		}
+	}
+
+	// Free the versions retired before that epoch and keep the rest.
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < retired.size(); i++)
+	{
+		if (retired[i].epoch < oldest)
+		{
+			delete retired[i].version;
+		}
+		else
+		{
+			retired[kept++] = retired[i];
+		}
+	}
+	retired.resize(kept);
+}
+
+/*
+ * Publishes a new version and retires the previous one.
+ *
+ * @param mesh The triangles of the new version.
+ */
+void ConcurrentMeshStore::publishLocked(TriangleMesh&& mesh)
+{
+	// Build the new version completely before anyone can see it, including its box and centroid.
+	mesh.setAreaCacheEnabled(false);
+	mesh.refreshBoundsCache();
+	Version* next = new Version{ std::move(mesh), current.load()->number + 1 };
+
+	// Swap it in, then move to a new epoch: readers announcing the new epoch can only load the new version.
+	Version* previous = current.exchange(next);
+	unsigned long long epoch = globalEpoch.fetch_add(1);
+
+	// Keep the previous version until the readers that may hold it are done.
+	retired.push_back(RetiredVersion{ previous, epoch });
+	reclaim();
+}
+
+/*
+ * Replaces the mesh with a new one.
+ *
+ * @param mesh The triangles of the new version.
+ */
+void ConcurrentMeshStore::publish(TriangleMesh mesh)
+{
+	std::lock_guard<std::mutex> lock(writeMutex);
+	publishLocked(std::move(mesh));
+}
+
+/*
+ * Applies a change to a copy of the latest version and publishes the result.
+ *
+ * @param change The function that modifies the copy.
+ */
+void ConcurrentMeshStore::update(const std::function<void(TriangleMesh&)>& change)
+{
+	std::lock_guard<std::mutex> lock(writeMutex);
+	// Only writers replace the current version, so it cannot change or be freed while the lock is held.
+	TriangleMesh next = current.load()->mesh;
+	change(next);
+	publishLocked(std::move(next));
+}
+
+/*
+ * Publishes a copy of the latest version translated along one axis.
+ *
+ * @param d The distance to translate the mesh along the axis.
+ * @param axis The axis along which to translate ('x', 'y', or 'z').
+ * @return 0 if successful, -1 if the axis is invalid.
+ */
+int ConcurrentMeshStore::translate(int d, char axis)
+{
+	// Reject an invalid axis before copying anything.
+	if (!(axis == 'x' || axis == 'y' || axis == 'z'))
+	{
+		return -1;
+	}
+
+	std::lock_guard<std::mutex> lock(writeMutex);
+	TriangleMesh next = current.load()->mesh;
+	next.translate(d, axis);
+	publishLocked(std::move(next));
+	return 0;
+}
+
+/*
+ * Returns the number of the latest published version.
+ *
+ * @return The version number.
+ */
+unsigned long long ConcurrentMeshStore::getVersion()
+{
+	// A snapshot keeps the version alive while its number is read.
+	return read().getVersion();
+}
+
+/*
+ * Returns the number of replaced versions that are still kept alive for readers.
+ *
+ * @return The number of versions waiting to be freed.
+ */
+std::size_t ConcurrentMeshStore::getRetiredCount()
+{
+	std::lock_guard<std::mutex> lock(writeMutex);
+	// Free what can be freed first, so the count only includes versions readers really hold.
+	reclaim();
+	return retired.size();
+}
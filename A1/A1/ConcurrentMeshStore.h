@@ -0,0 +1,202 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef CONCURRENTMESHSTORE_H
+#define CONCURRENTMESHSTORE_H
+
+// Includes the TriangleMesh.h header file for the triangles held by each version.
+#include "TriangleMesh.h"
+
+// Includes the atomic library for the published version and the epoch counters.
+#include <atomic>
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the functional library for std::function, the type of a change applied by a writer.
+#include <functional>
+// Includes the mutex library to serialize writers.
+#include <mutex>
+// Includes the vector library for the versions waiting to be freed.
+#include <vector>
+
+/*
+ * Defines a ConcurrentMeshStore class that lets many threads read a mesh while other threads change it.
+ * Writers never modify the published mesh: they build a new version and publish it with one atomic swap,
+ * so a reader always sees a whole version, never a half-translated one. Readers take no lock; they announce
+ * the epoch they started in, and an old version is freed only once every reader that could still see it is done.
+ */
+class ConcurrentMeshStore
+{
+private:
+	/*
+	 * One published state of the mesh. It is never changed after it has been published.
+	 */
+	struct Version
+	{
+		// The triangles of this version.
+		TriangleMesh mesh;
+		// Number of this version; the first version is 1 and each publish adds 1.
+		unsigned long long number;
+	};
+
+	/*
+	 * A version that has been replaced and waits until no reader can still see it.
+	 */
+	struct RetiredVersion
+	{
+		// The replaced version.
+		Version* version;
+		// Global epoch at the time it was replaced; readers that started in a later epoch cannot see it.
+		unsigned long long epoch;
+	};
+
+	/*
+	 * The epoch announced by one active reader, alone on its cache line so readers do not slow each other down.
+	 */
+	struct alignas(64) ReaderSlot
+	{
+		// Epoch in which the reader started, or 0 if the slot is free.
+		std::atomic<unsigned long long> epoch;
+	};
+
+	// Number of readers that can hold a snapshot at the same time; further readers wait for a free slot.
+	static const std::size_t MAX_READERS = 64;
+
+	// The version new readers see.
+	std::atomic<Version*> current;
+	// Advanced by every publish; readers record it to show which versions they may still be using.
+	std::atomic<unsigned long long> globalEpoch;
+	// The epochs announced by active readers.
+	ReaderSlot readers[MAX_READERS];
+	// Serializes writers; readers never take it.
+	std::mutex writeMutex;
+	// Replaced versions that may still be in use, guarded by writeMutex.
+	std::vector<RetiredVersion> retired;
+
+	/*
+	 * Frees every retired version that no active reader can still see. Must be called with writeMutex held.
+	 */
+	void reclaim();
+
+	/*
+	 * Publishes a new version and retires the previous one. Must be called with writeMutex held.
+	 *
+	 * @param mesh The triangles of the new version.
+	 */
+	void publishLocked(TriangleMesh&& mesh);
+
+public:
+	/*
+	 * A consistent, read-only view of one version of the mesh.
+	 * The version stays alive for as long as the snapshot exists, even if writers publish newer ones,
+	 * so snapshots should be short-lived to let old versions be freed.
+	 */
+	class Snapshot
+	{
+	private:
+		// The slot the reader announced its epoch in, or nullptr once the snapshot has been released.
+		ReaderSlot* slot;
+		// The version being read.
+		const Version* version;
+
+		// Only the store creates snapshots.
+		friend class ConcurrentMeshStore;
+		Snapshot(ReaderSlot* slotParameter, const Version* versionParameter);
+
+	public:
+		/*
+		 * Destructor for the Snapshot class.
+		 * It tells the store the reader is done, so older versions can be freed.
+		 */
+		~Snapshot();
+
+		// A snapshot owns its reader slot, so it can be moved but not copied.
+		Snapshot(const Snapshot&) = delete;
+		Snapshot& operator=(const Snapshot&) = delete;
+		Snapshot(Snapshot&& other) noexcept;
+
+		/*
+		 * Read-only access to the mesh of this version. Its area cache is always disabled,
+		 * so any number of threads can call calcArea on it at once, and its box and centroid are stored
+		 * before it is published, so getBounds and getCentroid answer without scanning.
+		 *
+		 * @return A reference to the mesh.
+		 */
+		const TriangleMesh& getMesh() const;
+
+		/*
+		 * Returns the number of the version being read.
+		 *
+		 * @return The version number.
+		 */
+		unsigned long long getVersion() const;
+	};
+
+	/*
+	 * Default constructor for the ConcurrentMeshStore class.
+	 * Publishes an empty mesh as version 1.
+	 */
+	ConcurrentMeshStore();
+
+	/*
+	 * Constructor that publishes an existing mesh as version 1.
+	 *
+	 * @param mesh The initial triangles.
+	 */
+	explicit ConcurrentMeshStore(TriangleMesh mesh);
+
+	/*
+	 * Destructor for the ConcurrentMeshStore class.
+	 * Every snapshot must have been released before the store is destroyed.
+	 */
+	~ConcurrentMeshStore();
+
+	// The store is shared between threads by reference, so it cannot be copied.
+	ConcurrentMeshStore(const ConcurrentMeshStore&) = delete;
+	ConcurrentMeshStore& operator=(const ConcurrentMeshStore&) = delete;
+
+	/*
+	 * Takes a snapshot of the latest version without locking. Readers never wait for writers.
+	 *
+	 * @return A snapshot of the latest published version.
+	 */
+	Snapshot read();
+
+	/*
+	 * Replaces the mesh with a new one.
+	 *
+	 * @param mesh The triangles of the new version.
+	 */
+	void publish(TriangleMesh mesh);
+
+	/*
+	 * Applies a change to a copy of the latest version and publishes the result.
+	 * Concurrent writers are applied one after the other, each to the result of the previous one.
+	 *
+	 * @param change The function that modifies the copy.
+	 */
+	void update(const std::function<void(TriangleMesh&)>& change);
+
+	/*
+	 * Publishes a copy of the latest version translated along one axis.
+	 *
+	 * @param d The distance to translate the mesh along the axis.
+	 * @param axis The axis along which to translate ('x', 'y', or 'z').
+	 * @return 0 if successful, -1 if the axis is invalid, in which case nothing is published.
+	 */
+	int translate(int d, char axis);
+
+	/*
+	 * Returns the number of the latest published version.
+	 *
+	 * @return The version number.
+	 */
+	unsigned long long getVersion();
+
+	/*
+	 * Returns the number of replaced versions that are still kept alive for readers.
+	 *
+	 * @return The number of versions waiting to be freed.
+	 */
+	std::size_t getRetiredCount();
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
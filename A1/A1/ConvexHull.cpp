@@ -0,0 +1,603 @@
+// Includes the ConvexHull.h header file for function declarations.
+#include "ConvexHull.h"
+// Includes the ExactMath.h header file for the exact orientation predicates.
+#include "ExactMath.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the cstdint library for the 32-bit point and face indices.
+#include <cstdint>
+// Includes the unordered_map library to link the new faces around the horizon.
+#include <unordered_map>
+// Includes the vector library for the faces, the outside sets, and the horizon.
+#include <vector>
+
+// Number of points searched or partitioned by one parallel task. The chunks are fixed, so the extreme points found
+// and the order of each outside set are the same for any thread count.
+static const std::size_t HULL_CHUNK = 65536;
+// Marks a missing point or face.
+static const std::uint32_t NONE = 0xFFFFFFFFu;
+
+/*
+ * One triangular face of the hull being built.
+ */
+struct HullFace
+{
+	// The corners, counterclockwise seen from outside.
+	std::uint32_t vertex[3];
+	// The face across each edge; edge i runs from vertex[i] to vertex[(i + 1) % 3].
+	std::uint32_t neighbor[3];
+	// A normal in double precision, only used to rank the points in front of the face by distance.
+	double normal[3];
+	// The points in front of the face that no earlier face claimed.
+	std::vector<std::uint32_t> outside;
+	// The point of the outside set farthest from the face, and its distance scaled by the normal's length.
+	std::uint32_t farthest;
+	double farthestDistance;
+	// Whether the face is still part of the hull.
+	bool alive;
+	// The step in which the face was last tested against an eye point, and whether that point could see it.
+	std::uint32_t visitTag;
+	bool visible;
+};
+
+/*
+ * Everything the quickhull steps share: the points, the faces built so far, and the thread pool.
+ */
+struct HullState
+{
+	const int* xs;
+	const int* ys;
+	const int* zs;
+	std::vector<HullFace> faces;
+	ThreadPool* pool;
+};
+
+/*
+ * A horizon edge: an edge between a face the eye point sees and one it does not.
+ */
+struct HorizonEdge
+{
+	// The edge, in the direction the visible face runs along it.
+	std::uint32_t from;
+	std::uint32_t to;
+	// The visible face being removed and the hidden face that stays.
+	std::uint32_t visibleFace;
+	std::uint32_t hiddenFace;
+};
+
+/*
+ * Tells exactly on which side of a face a point lies.
+ *
+ * @param state The hull being built.
+ * @param face The face.
+ * @param point The index of the point.
+ * @return 1 if the point is in front of the face, -1 if behind it, 0 if on its plane.
+ */
+static int sideOfFace(const HullState& state, const HullFace& face, std::uint32_t point)
+{
+	std::uint32_t a = face.vertex[0];
+	std::uint32_t b = face.vertex[1];
+	std::uint32_t c = face.vertex[2];
+	return orient3d(state.xs[a], state.ys[a], state.zs[a], state.xs[b], state.ys[b], state.zs[b],
+		state.xs[c], state.ys[c], state.zs[c], state.xs[point], state.ys[point], state.zs[point]);
+}
+
+/*
+ * Estimates how far in front of a face a point lies, scaled by the length of the face's normal.
+ * It is only used to compare points against the same face, so rounding errors do no harm.
+ *
+ * @param state The hull being built.
+ * @param face The face.
+ * @param point The index of the point.
+ * @return The scaled distance.
+ */
+static double distanceToFace(const HullState& state, const HullFace& face, std::uint32_t point)
+{
+	std::uint32_t a = face.vertex[0];
+	return face.normal[0] * (static_cast<double>(state.xs[point]) - state.xs[a])
+		+ face.normal[1] * (static_cast<double>(state.ys[point]) - state.ys[a])
+		+ face.normal[2] * (static_cast<double>(state.zs[point]) - state.zs[a]);
+}
+
+/*
+ * Adds a face with the given corners; its neighbours are linked by the caller.
+ *
+ * @param state The hull being built.
+ * @param a The first corner.
+ * @param b The second corner.
+ * @param c The third corner.
+ * @return The index of the new face.
+ */
+static std::uint32_t addFace(HullState& state, std::uint32_t a, std::uint32_t b, std::uint32_t c)
+{
+	HullFace face;
+	face.vertex[0] = a;
+	face.vertex[1] = b;
+	face.vertex[2] = c;
+	face.neighbor[0] = face.neighbor[1] = face.neighbor[2] = NONE;
+
+	// The cross product of two edges, rounded; it only has to point roughly outward.
+	double abX = static_cast<double>(state.xs[b]) - state.xs[a];
+	double abY = static_cast<double>(state.ys[b]) - state.ys[a];
+	double abZ = static_cast<double>(state.zs[b]) - state.zs[a];
+	double acX = static_cast<double>(state.xs[c]) - state.xs[a];
+	double acY = static_cast<double>(state.ys[c]) - state.ys[a];
+	double acZ = static_cast<double>(state.zs[c]) - state.zs[a];
+	face.normal[0] = abY * acZ - abZ * acY;
+	face.normal[1] = abZ * acX - abX * acZ;
+	face.normal[2] = abX * acY - abY * acX;
+
+	face.farthest = NONE;
+	face.farthestDistance = 0.0;
+	face.alive = true;
+	face.visitTag = 0;
+	face.visible = false;
+	state.faces.push_back(face);
+	return static_cast<std::uint32_t>(state.faces.size() - 1);
+}
+
+/*
+ * Finds the point that scores highest under a measure, searching fixed-size chunks in parallel.
+ * Ties go to the lowest index, so the result does not depend on the thread count.
+ *
+ * @param count The number of points.
+ * @param pool The thread pool that searches the chunks.
+ * @param measure Returns the score of a point.
+ * @return The index of the best point.
+ */
+template <typename Measure>
+static std::uint32_t findBest(std::size_t count, ThreadPool& pool, Measure measure)
+{
+	std::size_t chunkCount = ThreadPool::getChunkCount(count, HULL_CHUNK);
+	std::vector<std::uint32_t> best(chunkCount);
+	std::vector<double> bestScore(chunkCount);
+	pool.parallelForChunks(count, HULL_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+	{
+		std::uint32_t chunkBest = static_cast<std::uint32_t>(first);
+		double chunkScore = measure(chunkBest);
+		for (std::size_t i = first + 1; i < last; i++)
+		{
+			double score = measure(static_cast<std::uint32_t>(i));
+			if (score > chunkScore)
+			{
+				chunkScore = score;
+				chunkBest = static_cast<std::uint32_t>(i);
+			}
+		}
+		best[chunk] = chunkBest;
+		bestScore[chunk] = chunkScore;
+	});
+
+	// Combine the chunks in order, keeping the earliest of equal scores.
+	std::size_t winner = 0;
+	for (std::size_t chunk = 1; chunk < chunkCount; chunk++)
+	{
+		if (bestScore[chunk] > bestScore[winner])
+		{
+			winner = chunk;
+		}
+	}
+	return best[winner];
+}
+
+/*
+ * Hands each candidate point to the first new face it lies in front of; points in front of none are inside
+ * the hull and dropped. Large candidate lists are cut into chunks that are partitioned in parallel
+ * and then appended in chunk order.
+ *
+ * @param state The hull being built.
+ * @param candidates The points to hand out.
+ * @param newFaces The faces that may take them.
+ */
+static void assignOutside(HullState& state, const std::vector<std::uint32_t>& candidates, const std::vector<std::uint32_t>& newFaces)
+{
+	std::size_t chunkCount = ThreadPool::getChunkCount(candidates.size(), HULL_CHUNK);
+	std::size_t faceCount = newFaces.size();
+	// The points each chunk gives each face, chunk by chunk.
+	std::vector<std::vector<std::uint32_t>> claimed(chunkCount * faceCount);
+
+	auto partition = [&](std::size_t chunk, std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; i++)
+		{
+			std::uint32_t point = candidates[i];
+			for (std::size_t f = 0; f < faceCount; f++)
+			{
+				if (sideOfFace(state, state.faces[newFaces[f]], point) > 0)
+				{
+					claimed[chunk * faceCount + f].push_back(point);
+					break;
+				}
+			}
+		}
+	};
+	// Small lists are not worth waking the pool for.
+	if (chunkCount > 1)
+	{
+		state.pool->parallelForChunks(candidates.size(), HULL_CHUNK, partition);
+	}
+	else if (chunkCount == 1)
+	{
+		partition(0, 0, candidates.size());
+	}
+
+	// Gather each face's points in chunk order and find the farthest, again in parallel over the faces.
+	auto gather = [&](std::size_t f)
+	{
+		HullFace& face = state.faces[newFaces[f]];
+		std::size_t total = 0;
+		for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+		{
+			total += claimed[chunk * faceCount + f].size();
+		}
+		face.outside.reserve(total);
+		for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+		{
+			std::vector<std::uint32_t>& points = claimed[chunk * faceCount + f];
+			face.outside.insert(face.outside.end(), points.begin(), points.end());
+			std::vector<std::uint32_t>().swap(points);
+		}
+		for (std::size_t i = 0; i < face.outside.size(); i++)
+		{
+			double distance = distanceToFace(state, face, face.outside[i]);
+			if (face.farthest == NONE || distance > face.farthestDistance)
+			{
+				face.farthest = face.outside[i];
+				face.farthestDistance = distance;
+			}
+		}
+	};
+	if (chunkCount > 1)
+	{
+		state.pool->parallelFor(faceCount, gather);
+	}
+	else
+	{
+		for (std::size_t f = 0; f < faceCount; f++)
+		{
+			gather(f);
+		}
+	}
+}
+
+/*
+ * Finds four points that span a volume: the two farthest apart of the extreme points on each axis,
+ * the point farthest from the line through them, and the point farthest from the plane through those three.
+ * The searches rank points in double precision; each choice is then confirmed with an exact predicate,
+ * and an exact scan takes over in the rare case the rounded ranking picked a degenerate point.
+ *
+ * @param state The hull being built.
+ * @param count The number of points.
+ * @param corners Receives the four points.
+ * @return True if four such points exist, false if every point lies on one plane.
+ */
+static bool findInitialCorners(const HullState& state, std::size_t count, std::uint32_t corners[4])
+{
+	const int* xs = state.xs;
+	const int* ys = state.ys;
+	const int* zs = state.zs;
+	ThreadPool& pool = *state.pool;
+
+	// The smallest and largest point on each axis.
+	std::uint32_t extremes[6];
+	const int* axes[3] = { xs, ys, zs };
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const int* values = axes[axis];
+		extremes[axis * 2] = findBest(count, pool, [values](std::uint32_t i) { return -static_cast<double>(values[i]); });
+		extremes[axis * 2 + 1] = findBest(count, pool, [values](std::uint32_t i) { return static_cast<double>(values[i]); });
+	}
+
+	// The two extremes farthest apart.
+	double widest = -1.0;
+	for (int i = 0; i < 6; i++)
+	{
+		for (int j = i + 1; j < 6; j++)
+		{
+			double dx = static_cast<double>(xs[extremes[i]]) - xs[extremes[j]];
+			double dy = static_cast<double>(ys[extremes[i]]) - ys[extremes[j]];
+			double dz = static_cast<double>(zs[extremes[i]]) - zs[extremes[j]];
+			double distance = dx * dx + dy * dy + dz * dz;
+			if (distance > widest)
+			{
+				widest = distance;
+				corners[0] = extremes[i];
+				corners[1] = extremes[j];
+			}
+		}
+	}
+	// Every extreme is the same point only if every point is.
+	if (widest <= 0.0)
+	{
+		return false;
+	}
+
+	// The point farthest from the line through the first two.
+	std::uint32_t a = corners[0];
+	std::uint32_t b = corners[1];
+	double abX = static_cast<double>(xs[b]) - xs[a];
+	double abY = static_cast<double>(ys[b]) - ys[a];
+	double abZ = static_cast<double>(zs[b]) - zs[a];
+	corners[2] = findBest(count, pool, [&](std::uint32_t i)
+	{
+		double apX = static_cast<double>(xs[i]) - xs[a];
+		double apY = static_cast<double>(ys[i]) - ys[a];
+		double apZ = static_cast<double>(zs[i]) - zs[a];
+		double cX = abY * apZ - abZ * apY;
+		double cY = abZ * apX - abX * apZ;
+		double cZ = abX * apY - abY * apX;
+		return cX * cX + cY * cY + cZ * cZ;
+	});
+	// Three points are collinear exactly when their projections onto all three coordinate planes are.
+	auto collinear = [&](std::uint32_t c)
+	{
+		return orient2d(xs[a], ys[a], xs[b], ys[b], xs[c], ys[c]) == 0 && orient2d(ys[a], zs[a], ys[b], zs[b], ys[c], zs[c]) == 0
+			&& orient2d(zs[a], xs[a], zs[b], xs[b], zs[c], xs[c]) == 0;
+	};
+	if (collinear(corners[2]))
+	{
+		corners[2] = NONE;
+		for (std::size_t i = 0; i < count && corners[2] == NONE; i++)
+		{
+			corners[2] = collinear(static_cast<std::uint32_t>(i)) ? NONE : static_cast<std::uint32_t>(i);
+		}
+		if (corners[2] == NONE)
+		{
+			return false;
+		}
+	}
+
+	// The point farthest from the plane through the first three.
+	std::uint32_t c = corners[2];
+	double acX = static_cast<double>(xs[c]) - xs[a];
+	double acY = static_cast<double>(ys[c]) - ys[a];
+	double acZ = static_cast<double>(zs[c]) - zs[a];
+	double normal[3] = { abY * acZ - abZ * acY, abZ * acX - abX * acZ, abX * acY - abY * acX };
+	corners[3] = findBest(count, pool, [&](std::uint32_t i)
+	{
+		double distance = normal[0] * (static_cast<double>(xs[i]) - xs[a]) + normal[1] * (static_cast<double>(ys[i]) - ys[a])
+			+ normal[2] * (static_cast<double>(zs[i]) - zs[a]);
+		return distance < 0.0 ? -distance : distance;
+	});
+	auto coplanar = [&](std::uint32_t d)
+	{
+		return orient3d(xs[a], ys[a], zs[a], xs[b], ys[b], zs[b], xs[c], ys[c], zs[c], xs[d], ys[d], zs[d]) == 0;
+	};
+	if (coplanar(corners[3]))
+	{
+		corners[3] = NONE;
+		for (std::size_t i = 0; i < count && corners[3] == NONE; i++)
+		{
+			corners[3] = coplanar(static_cast<std::uint32_t>(i)) ? NONE : static_cast<std::uint32_t>(i);
+		}
+		if (corners[3] == NONE)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * Computes the convex hull of a set of 3D points with the quickhull algorithm.
+ *
+ * @param points The points to wrap.
+ * @param hull Receives the hull.
+ * @param pool The thread pool that runs the parallel searches and partitions.
+ * @return True if the hull was built, false if the points do not span a volume.
+ */
+bool computeConvexHull(const PointBuffer& points, TriangleMesh& hull, ThreadPool& pool)
+{
+	hull.clear();
+	std::size_t count = points.size();
+	if (count < 4)
+	{
+		return false;
+	}
+
+	HullState state;
+	state.xs = points.dataX();
+	state.ys = points.dataY();
+	state.zs = points.dataZ();
+	state.pool = &pool;
+
+	std::uint32_t corners[4];
+	if (!findInitialCorners(state, count, corners))
+	{
+		return false;
+	}
+
+	// Build the tetrahedron. Each face leaves out one corner and is turned so that corner lies behind it.
+	std::vector<std::uint32_t> newFaces;
+	for (int omitted = 0; omitted < 4; omitted++)
+	{
+		std::uint32_t face[3];
+		for (int k = 0, n = 0; k < 4; k++)
+		{
+			if (k != omitted)
+			{
+				face[n++] = corners[k];
+			}
+		}
+		std::uint32_t index = addFace(state, face[0], face[1], face[2]);
+		if (sideOfFace(state, state.faces[index], corners[omitted]) > 0)
+		{
+			state.faces.pop_back();
+			index = addFace(state, face[0], face[2], face[1]);
+		}
+		newFaces.push_back(index);
+	}
+	// Link the faces: the neighbour across edge a-b is the face that runs along it from b to a.
+	for (std::uint32_t f = 0; f < 4; f++)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			std::uint32_t from = state.faces[f].vertex[i];
+			std::uint32_t to = state.faces[f].vertex[(i + 1) % 3];
+			for (std::uint32_t g = 0; g < 4; g++)
+			{
+				for (int j = 0; j < 3; j++)
+				{
+					if (state.faces[g].vertex[j] == to && state.faces[g].vertex[(j + 1) % 3] == from)
+					{
+						state.faces[f].neighbor[i] = g;
+					}
+				}
+			}
+		}
+	}
+
+	// Hand every point to a face of the tetrahedron, or drop it if it is inside.
+	{
+		std::vector<std::uint32_t> all(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			all[i] = static_cast<std::uint32_t>(i);
+		}
+		assignOutside(state, all, newFaces);
+	}
+
+	// Faces that may still have points in front of them.
+	std::vector<std::uint32_t> pending(newFaces.begin(), newFaces.end());
+	std::vector<std::uint32_t> visibleFaces;
+	std::vector<HorizonEdge> horizon;
+	std::vector<std::uint32_t> candidates;
+	std::unordered_map<std::uint32_t, std::uint32_t> faceStartingAt;
+	std::uint32_t tag = 0;
+
+	while (!pending.empty())
+	{
+		std::uint32_t start = pending.back();
+		pending.pop_back();
+		if (!state.faces[start].alive || state.faces[start].outside.empty())
+		{
+			continue;
+		}
+
+		// The farthest point in front of the face becomes a corner of the hull.
+		std::uint32_t eye = state.faces[start].farthest;
+		tag++;
+
+		// Collect every face the eye point sees, spreading from the start face across edges,
+		// and record the horizon edges where a visible face meets a hidden one.
+		visibleFaces.clear();
+		horizon.clear();
+		visibleFaces.push_back(start);
+		state.faces[start].visitTag = tag;
+		state.faces[start].visible = true;
+		for (std::size_t k = 0; k < visibleFaces.size(); k++)
+		{
+			std::uint32_t f = visibleFaces[k];
+			for (int i = 0; i < 3; i++)
+			{
+				std::uint32_t n = state.faces[f].neighbor[i];
+				HullFace& neighbor = state.faces[n];
+				if (neighbor.visitTag != tag)
+				{
+					neighbor.visitTag = tag;
+					neighbor.visible = sideOfFace(state, neighbor, eye) > 0;
+					if (neighbor.visible)
+					{
+						visibleFaces.push_back(n);
+					}
+				}
+				if (!neighbor.visible)
+				{
+					horizon.push_back({ state.faces[f].vertex[i], state.faces[f].vertex[(i + 1) % 3], f, n });
+				}
+			}
+		}
+
+		// Gather the points of the visible faces, which are removed.
+		candidates.clear();
+		for (std::size_t k = 0; k < visibleFaces.size(); k++)
+		{
+			HullFace& face = state.faces[visibleFaces[k]];
+			for (std::size_t i = 0; i < face.outside.size(); i++)
+			{
+				if (face.outside[i] != eye)
+				{
+					candidates.push_back(face.outside[i]);
+				}
+			}
+			std::vector<std::uint32_t>().swap(face.outside);
+			face.alive = false;
+		}
+
+		// Cone the horizon to the eye point. Each new face keeps the horizon edge's direction,
+		// so it turns the same way as the visible face it replaces.
+		newFaces.clear();
+		faceStartingAt.clear();
+		for (std::size_t k = 0; k < horizon.size(); k++)
+		{
+			const HorizonEdge& edge = horizon[k];
+			std::uint32_t created = addFace(state, edge.from, edge.to, eye);
+			state.faces[created].neighbor[0] = edge.hiddenFace;
+			// The hidden face runs along the edge from to to from.
+			HullFace& hidden = state.faces[edge.hiddenFace];
+			for (int j = 0; j < 3; j++)
+			{
+				if (hidden.neighbor[j] == edge.visibleFace && hidden.vertex[j] == edge.to)
+				{
+					hidden.neighbor[j] = created;
+				}
+			}
+			faceStartingAt[edge.from] = created;
+			newFaces.push_back(created);
+		}
+		// Link neighbouring cone faces: the face on edge a-b shares its edge b-eye with the face on edge b-c.
+		for (std::size_t k = 0; k < newFaces.size(); k++)
+		{
+			std::uint32_t next = faceStartingAt[state.faces[newFaces[k]].vertex[1]];
+			state.faces[newFaces[k]].neighbor[1] = next;
+			state.faces[next].neighbor[2] = newFaces[k];
+		}
+
+		// Hand the points of the removed faces to the new ones.
+		assignOutside(state, candidates, newFaces);
+		for (std::size_t k = 0; k < newFaces.size(); k++)
+		{
+			if (!state.faces[newFaces[k]].outside.empty())
+			{
+				pending.push_back(newFaces[k]);
+			}
+		}
+	}
+
+	// Copy the corners of the remaining faces into the mesh, in the order the faces use them.
+	std::unordered_map<std::uint32_t, std::uint32_t> hullIndex;
+	for (std::size_t f = 0; f < state.faces.size(); f++)
+	{
+		const HullFace& face = state.faces[f];
+		if (!face.alive)
+		{
+			continue;
+		}
+		std::uint32_t triangle[3];
+		for (int i = 0; i < 3; i++)
+		{
+			std::uint32_t point = face.vertex[i];
+			std::unordered_map<std::uint32_t, std::uint32_t>::iterator found = hullIndex.find(point);
+			if (found == hullIndex.end())
+			{
+				found = hullIndex.emplace(point, hull.addVertex(state.xs[point], state.ys[point], state.zs[point])).first;
+			}
+			triangle[i] = found->second;
+		}
+		hull.addTriangle(triangle[0], triangle[1], triangle[2]);
+	}
+	return true;
+}
+
+/*
+ * Computes the convex hull of a set of 3D points on the program's shared thread pool.
+ *
+ * @param points The points to wrap.
+ * @param hull Receives the hull.
+ * @return True if the hull was built, false if the points do not span a volume.
+ */
+bool computeConvexHull(const PointBuffer& points, TriangleMesh& hull)
+{
+	return computeConvexHull(points, hull, ThreadPool::getShared());
+}
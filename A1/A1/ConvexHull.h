@@ -0,0 +1,40 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef CONVEXHULL_H
+#define CONVEXHULL_H
+
+// Includes the PointBuffer.h header file to read the point sets.
+#include "PointBuffer.h"
+// Includes the TriangleMesh.h header file to return the hull as an indexed mesh.
+#include "TriangleMesh.h"
+// Includes the ThreadPool.h header file to search and partition the points in parallel.
+#include "ThreadPool.h"
+
+/*
+ * Computes the convex hull of a set of 3D points with the quickhull algorithm.
+ * The hull starts as a tetrahedron of extreme points and grows by the farthest point outside one of its faces,
+ * replacing the faces that point can see with a cone of new faces. Every point is kept in the outside set of one
+ * face it lies in front of, so each step only looks at the points near the faces it replaces.
+ * The extreme points are searched, and large outside sets are partitioned among new faces, in parallel chunks.
+ * Every side test is done with the exact orient3d() predicate, so the hull is correct for any int coordinates,
+ * including points that are coplanar or repeated. Points on a face of the hull but not at a corner are left out.
+ *
+ * @param points The points to wrap.
+ * @param hull Receives the hull: its corners as vertices, and triangles that turn counterclockwise seen from outside.
+ *             Its previous contents are replaced.
+ * @param pool The thread pool that runs the parallel searches and partitions.
+ * @return True if the hull was built, false if the points do not span a volume (fewer than four points,
+ *         or all of them on one plane), in which case the hull is left empty.
+ */
+bool computeConvexHull(const PointBuffer& points, TriangleMesh& hull, ThreadPool& pool);
+
+/*
+ * Computes the convex hull of a set of 3D points on the program's shared thread pool.
+ *
+ * @param points The points to wrap.
+ * @param hull Receives the hull. Its previous contents are replaced.
+ * @return True if the hull was built, false if the points do not span a volume.
+ */
+bool computeConvexHull(const PointBuffer& points, TriangleMesh& hull);
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
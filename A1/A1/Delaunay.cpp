@@ -0,0 +1,513 @@
+// Includes the Delaunay.h header file for function declarations.
+#include "Delaunay.h"
+// Includes the ExactMath.h header file for the exact orientation and incircle predicates.
+#include "ExactMath.h"
+// Includes the MeshSort.h header file to sort the insertion order with the parallel radix sort.
+#include "MeshSort.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the cstdint library for the 32-bit vertex and half-edge indices and the 64-bit order keys.
+#include <cstdint>
+// Includes the vector library for the half-edge arrays and the work lists.
+#include <vector>
+
+// Number of points keyed or copied by one parallel task. Each point's key depends only on the point and its index,
+// so the insertion order is the same for any thread count.
+static const std::size_t DELAUNAY_CHUNK = 65536;
+// Bits per axis of the Hilbert curve; the round number goes in the bits above.
+static const int HILBERT_BITS = 28;
+// Highest BRIO round; a point reaches it with probability 2^-20, so it holds a handful of points at most.
+static const std::uint32_t MAX_ROUND = 20;
+// The vertex at infinity that closes the hull.
+static const std::uint32_t INFINITE_VERTEX = 0xFFFFFFFFu;
+// Marks a triangle slot that is no longer used.
+static const std::uint32_t DEAD = 0xFFFFFFFEu;
+
+/*
+ * An edge on the border of the triangles a new point removes.
+ */
+struct CavityEdge
+{
+	// The edge, in the direction the removed triangle runs along it.
+	std::uint32_t from;
+	std::uint32_t to;
+	// The half-edge of the triangle that stays, across the edge.
+	std::uint32_t twin;
+};
+
+/*
+ * The triangulation being built. Triangle t owns half-edges 3t, 3t + 1, and 3t + 2; half-edge e runs from
+ * corners[e] to the next corner of its triangle, and twins[e] is the half-edge running the other way.
+ * Triangles with the vertex at infinity as a corner close the hull: one lies across every hull edge.
+ */
+struct DelaunayState
+{
+	// The coordinates in insertion order, so points inserted together sit together in memory.
+	std::vector<int> xs;
+	std::vector<int> ys;
+	std::vector<std::uint32_t> corners;
+	std::vector<std::uint32_t> twins;
+	// The insertion in which each triangle was last tested against the new point, and whether it was in conflict.
+	std::vector<std::uint32_t> visitTag;
+	std::vector<std::uint8_t> conflict;
+	// For each vertex, the new triangle that starts at it; the last entry stands for the vertex at infinity.
+	std::vector<std::uint32_t> startingAt;
+	// Scratch lists reused by every insertion.
+	std::vector<std::uint32_t> cavity;
+	std::vector<std::uint32_t> stack;
+	std::vector<std::uint32_t> created;
+	std::vector<CavityEdge> border;
+	// The triangle the next walk starts from, and the number of the current insertion.
+	std::uint32_t last;
+	std::uint32_t stamp;
+};
+
+/*
+ * Returns the half-edge after another in the same triangle.
+ *
+ * @param edge The half-edge.
+ * @return The next half-edge.
+ */
+static std::uint32_t nextEdge(std::uint32_t edge)
+{
+	return edge % 3 == 2 ? edge - 2 : edge + 1;
+}
+
+/*
+ * Finds where the vertex at infinity sits in a triangle.
+ *
+ * @param state The triangulation.
+ * @param triangle The triangle.
+ * @return The corner holding the vertex at infinity, or -1 if the triangle is finite.
+ */
+static int infiniteCorner(const DelaunayState& state, std::uint32_t triangle)
+{
+	const std::uint32_t* corner = &state.corners[triangle * 3];
+	return corner[0] == INFINITE_VERTEX ? 0 : corner[1] == INFINITE_VERTEX ? 1 : corner[2] == INFINITE_VERTEX ? 2 : -1;
+}
+
+/*
+ * Computes the index of a point along a Hilbert curve over a square grid.
+ *
+ * @param x The column of the point, below 2^HILBERT_BITS.
+ * @param y The row of the point, below 2^HILBERT_BITS.
+ * @return The distance of the point along the curve.
+ */
+static std::uint64_t encodeHilbert(std::uint32_t x, std::uint32_t y)
+{
+	const std::uint32_t mask = (1u << HILBERT_BITS) - 1;
+	std::uint64_t distance = 0;
+	for (std::uint32_t step = 1u << (HILBERT_BITS - 1); step > 0; step >>= 1)
+	{
+		std::uint32_t right = (x & step) ? 1 : 0;
+		std::uint32_t up = (y & step) ? 1 : 0;
+		distance += static_cast<std::uint64_t>(step) * step * ((3 * right) ^ up);
+		// Turn the quadrant so the curve inside it starts and ends where the next level expects.
+		if (up == 0)
+		{
+			if (right == 1)
+			{
+				x = mask - x;
+				y = mask - y;
+			}
+			std::uint32_t swap = x;
+			x = y;
+			y = swap;
+		}
+	}
+	return distance;
+}
+
+/*
+ * Picks the BRIO round of a point from a hash of its index: round r holds about half as many points as round r - 1,
+ * and the higher rounds are inserted first.
+ *
+ * @param index The index of the point.
+ * @return The round, from 0 to MAX_ROUND.
+ */
+static std::uint32_t pickRound(std::size_t index)
+{
+	// Mix the index so the rounds look random but are the same on every run.
+	std::uint64_t hash = static_cast<std::uint64_t>(index) * 0x9E3779B97F4A7C15ull;
+	hash ^= hash >> 31;
+	hash *= 0xBF58476D1CE4E5B9ull;
+	hash ^= hash >> 29;
+	// The number of trailing one bits is r with probability 2^-(r + 1).
+	std::uint32_t round = 0;
+	while (round < MAX_ROUND && (hash & 1))
+	{
+		hash >>= 1;
+		round++;
+	}
+	return round;
+}
+
+/*
+ * Checks whether a new point conflicts with a triangle: for a finite triangle, whether it lies strictly inside
+ * the circumcircle; for a triangle on the hull, whether it lies strictly outside the hull edge, or on the edge
+ * between its ends, which counts as the limit of the circle.
+ *
+ * @param state The triangulation.
+ * @param triangle The triangle.
+ * @param x The x-coordinate of the new point.
+ * @param y The y-coordinate of the new point.
+ * @return True if the triangle has to be removed to insert the point.
+ */
+static bool inConflict(const DelaunayState& state, std::uint32_t triangle, int x, int y)
+{
+	const std::uint32_t* corner = &state.corners[triangle * 3];
+	int infinite = infiniteCorner(state, triangle);
+	if (infinite < 0)
+	{
+		return incircle(state.xs[corner[0]], state.ys[corner[0]], state.xs[corner[1]], state.ys[corner[1]],
+			state.xs[corner[2]], state.ys[corner[2]], x, y) > 0;
+	}
+
+	// The hull edge runs from a to b with the outside on its left.
+	std::uint32_t a = corner[(infinite + 1) % 3];
+	std::uint32_t b = corner[(infinite + 2) % 3];
+	int side = orient2d(state.xs[a], state.ys[a], state.xs[b], state.ys[b], x, y);
+	if (side != 0)
+	{
+		return side > 0;
+	}
+	// On the line: compare along an axis the edge is not perpendicular to.
+	if (state.xs[a] != state.xs[b])
+	{
+		return state.xs[a] < state.xs[b] ? state.xs[a] < x && x < state.xs[b] : state.xs[b] < x && x < state.xs[a];
+	}
+	return state.ys[a] < state.ys[b] ? state.ys[a] < y && y < state.ys[b] : state.ys[b] < y && y < state.ys[a];
+}
+
+/*
+ * Adds a triangle slot with no corners or neighbours set.
+ *
+ * @param state The triangulation.
+ * @return The index of the new triangle.
+ */
+static std::uint32_t appendTriangle(DelaunayState& state)
+{
+	std::uint32_t triangle = static_cast<std::uint32_t>(state.visitTag.size());
+	state.corners.resize(state.corners.size() + 3);
+	state.twins.resize(state.twins.size() + 3);
+	state.visitTag.push_back(0);
+	state.conflict.push_back(0);
+	return triangle;
+}
+
+/*
+ * Walks from the last new triangle towards a point, crossing every edge the point lies strictly beyond.
+ * On a Delaunay triangulation this walk always ends, and the starting side is turned after every step
+ * so that no order of tests is favoured.
+ *
+ * @param state The triangulation.
+ * @param point The point to find.
+ * @return A finite triangle whose closure holds the point, or a hull triangle whose edge the point lies strictly beyond.
+ */
+static std::uint32_t locate(const DelaunayState& state, std::uint32_t point)
+{
+	int x = state.xs[point];
+	int y = state.ys[point];
+	std::uint32_t triangle = state.last;
+	// Step off the hull onto the finite triangle across the hull edge.
+	int infinite = infiniteCorner(state, triangle);
+	if (infinite >= 0)
+	{
+		triangle = state.twins[triangle * 3 + (infinite + 1) % 3] / 3;
+	}
+
+	std::uint32_t cameFrom = INFINITE_VERTEX;
+	int rotation = 0;
+	for (;;)
+	{
+		bool moved = false;
+		for (int k = 0; k < 3 && !moved; k++)
+		{
+			std::uint32_t edge = triangle * 3 + (k + rotation) % 3;
+			if (edge == cameFrom)
+			{
+				continue;
+			}
+			std::uint32_t a = state.corners[edge];
+			std::uint32_t b = state.corners[nextEdge(edge)];
+			if (orient2d(state.xs[a], state.ys[a], state.xs[b], state.ys[b], x, y) < 0)
+			{
+				cameFrom = state.twins[edge];
+				triangle = cameFrom / 3;
+				moved = true;
+			}
+		}
+		if (!moved || infiniteCorner(state, triangle) >= 0)
+		{
+			return triangle;
+		}
+		rotation = rotation == 2 ? 0 : rotation + 1;
+	}
+}
+
+/*
+ * Inserts one point: removes every triangle it conflicts with and fills the hole with triangles to the point.
+ *
+ * @param state The triangulation.
+ * @param point The point to insert.
+ * @return True if the point was inserted, false if it repeats the x and y of a vertex already there.
+ */
+static bool insertPoint(DelaunayState& state, std::uint32_t point)
+{
+	int x = state.xs[point];
+	int y = state.ys[point];
+	std::uint32_t start = locate(state, point);
+	// A point already in the triangulation is a corner of the triangle the walk ends in.
+	if (infiniteCorner(state, start) < 0)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			std::uint32_t corner = state.corners[start * 3 + k];
+			if (state.xs[corner] == x && state.ys[corner] == y)
+			{
+				return false;
+			}
+		}
+	}
+
+	// Collect the triangles in conflict, spreading from the one the walk found, and the edges around them.
+	state.stamp++;
+	state.cavity.clear();
+	state.border.clear();
+	state.stack.clear();
+	state.visitTag[start] = state.stamp;
+	state.conflict[start] = 1;
+	state.stack.push_back(start);
+	while (!state.stack.empty())
+	{
+		std::uint32_t triangle = state.stack.back();
+		state.stack.pop_back();
+		state.cavity.push_back(triangle);
+		for (int k = 0; k < 3; k++)
+		{
+			std::uint32_t edge = triangle * 3 + k;
+			std::uint32_t twin = state.twins[edge];
+			std::uint32_t neighbor = twin / 3;
+			if (state.visitTag[neighbor] != state.stamp)
+			{
+				state.visitTag[neighbor] = state.stamp;
+				state.conflict[neighbor] = inConflict(state, neighbor, x, y) ? 1 : 0;
+				if (state.conflict[neighbor])
+				{
+					state.stack.push_back(neighbor);
+				}
+			}
+			if (!state.conflict[neighbor])
+			{
+				state.border.push_back({ state.corners[edge], state.corners[nextEdge(edge)], twin });
+			}
+		}
+	}
+
+	// Connect every border edge to the point, reusing the slots of the removed triangles first.
+	std::size_t infiniteSlot = state.startingAt.size() - 1;
+	state.created.clear();
+	for (std::size_t k = 0; k < state.border.size(); k++)
+	{
+		const CavityEdge& edge = state.border[k];
+		std::uint32_t triangle = k < state.cavity.size() ? state.cavity[k] : appendTriangle(state);
+		state.corners[triangle * 3] = edge.from;
+		state.corners[triangle * 3 + 1] = edge.to;
+		state.corners[triangle * 3 + 2] = point;
+		state.twins[triangle * 3] = edge.twin;
+		state.twins[edge.twin] = triangle * 3;
+		state.startingAt[edge.from == INFINITE_VERTEX ? infiniteSlot : edge.from] = triangle;
+		state.created.push_back(triangle);
+	}
+	// The new triangle on edge a-b shares its edge b-point with the one on the edge that starts at b.
+	for (std::size_t k = 0; k < state.created.size(); k++)
+	{
+		std::uint32_t triangle = state.created[k];
+		std::uint32_t to = state.corners[triangle * 3 + 1];
+		std::uint32_t next = state.startingAt[to == INFINITE_VERTEX ? infiniteSlot : to];
+		state.twins[triangle * 3 + 1] = next * 3 + 2;
+		state.twins[next * 3 + 2] = triangle * 3 + 1;
+	}
+	// A hole always has two more border edges than triangles, but never leave a slot looking alive.
+	for (std::size_t k = state.border.size(); k < state.cavity.size(); k++)
+	{
+		state.corners[state.cavity[k] * 3] = DEAD;
+	}
+	state.last = state.created[0];
+	return true;
+}
+
+/*
+ * Computes the Delaunay triangulation of a set of points seen from above.
+ *
+ * @param points The points to triangulate.
+ * @param mesh Receives the triangulation. Its previous contents are replaced.
+ * @param pool The thread pool that computes and sorts the insertion order.
+ * @return True if the triangulation was built, false if the points do not span an area.
+ */
+bool computeDelaunayTriangulation(const PointBuffer& points, TriangleMesh& mesh, ThreadPool& pool)
+{
+	mesh.clear();
+	std::size_t count = points.size();
+	if (count < 3)
+	{
+		return false;
+	}
+	const int* xs = points.dataX();
+	const int* ys = points.dataY();
+
+	// The bounding box, to spread the points over the Hilbert grid.
+	int minX = xs[0];
+	int maxX = xs[0];
+	int minY = ys[0];
+	int maxY = ys[0];
+	for (std::size_t i = 1; i < count; i++)
+	{
+		minX = xs[i] < minX ? xs[i] : minX;
+		maxX = xs[i] > maxX ? xs[i] : maxX;
+		minY = ys[i] < minY ? ys[i] : minY;
+		maxY = ys[i] > maxY ? ys[i] : maxY;
+	}
+	// The larger side, so the grid cells stay square. Widths are computed in 64 bits, where they cannot overflow.
+	std::int64_t width = static_cast<std::int64_t>(maxX) - minX;
+	std::int64_t height = static_cast<std::int64_t>(maxY) - minY;
+	std::uint64_t extent = static_cast<std::uint64_t>(width > height ? width : height) + 1;
+
+	// Key every point by its round, highest first, then by its place on the curve, and sort the keys.
+	std::vector<std::uint64_t> keys(count);
+	pool.parallelForChunks(count, DELAUNAY_CHUNK, [&](std::size_t, std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; i++)
+		{
+			// Offsets below 2^32 times 2^28 stay below 2^60, so the scaling is exact in 64 bits.
+			std::uint64_t column = (static_cast<std::uint64_t>(static_cast<std::int64_t>(xs[i]) - minX) << HILBERT_BITS) / extent;
+			std::uint64_t row = (static_cast<std::uint64_t>(static_cast<std::int64_t>(ys[i]) - minY) << HILBERT_BITS) / extent;
+			std::uint64_t round = MAX_ROUND - pickRound(i);
+			keys[i] = round << (2 * HILBERT_BITS) | encodeHilbert(static_cast<std::uint32_t>(column), static_cast<std::uint32_t>(row));
+		}
+	});
+	std::vector<std::uint32_t> order;
+	radixSortKeys(keys, order, pool);
+	std::vector<std::uint64_t>().swap(keys);
+
+	// Copy the coordinates into insertion order.
+	DelaunayState state;
+	state.xs.resize(count);
+	state.ys.resize(count);
+	pool.parallelForChunks(count, DELAUNAY_CHUNK, [&](std::size_t, std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; i++)
+		{
+			state.xs[i] = xs[order[i]];
+			state.ys[i] = ys[order[i]];
+		}
+	});
+
+	// The first triangle: the first point, the first one at a different place, and the first one off their line.
+	std::uint32_t first[3] = { 0, INFINITE_VERTEX, INFINITE_VERTEX };
+	for (std::size_t i = 1; i < count && first[1] == INFINITE_VERTEX; i++)
+	{
+		if (state.xs[i] != state.xs[0] || state.ys[i] != state.ys[0])
+		{
+			first[1] = static_cast<std::uint32_t>(i);
+		}
+	}
+	int turn = 0;
+	for (std::size_t i = first[1] + 1; first[1] != INFINITE_VERTEX && i < count && turn == 0; i++)
+	{
+		turn = orient2d(state.xs[0], state.ys[0], state.xs[first[1]], state.ys[first[1]], state.xs[i], state.ys[i]);
+		first[2] = static_cast<std::uint32_t>(i);
+	}
+	if (turn == 0)
+	{
+		return false;
+	}
+	if (turn < 0)
+	{
+		std::uint32_t swap = first[1];
+		first[1] = first[2];
+		first[2] = swap;
+	}
+
+	// The triangle and one hull triangle across each of its edges: edge a-b gets the hull triangle b, a, infinity.
+	state.corners.reserve(count * 6 + 12);
+	state.twins.reserve(count * 6 + 12);
+	state.visitTag.reserve(count * 2 + 4);
+	state.conflict.reserve(count * 2 + 4);
+	std::uint32_t inner = appendTriangle(state);
+	for (int k = 0; k < 3; k++)
+	{
+		state.corners[inner * 3 + k] = first[k];
+	}
+	for (std::uint32_t k = 0; k < 3; k++)
+	{
+		std::uint32_t hull = appendTriangle(state);
+		state.corners[hull * 3] = first[(k + 1) % 3];
+		state.corners[hull * 3 + 1] = first[k];
+		state.corners[hull * 3 + 2] = INFINITE_VERTEX;
+		state.twins[hull * 3] = inner * 3 + k;
+		state.twins[inner * 3 + k] = hull * 3;
+	}
+	for (std::uint32_t k = 0; k < 3; k++)
+	{
+		// Hull triangle k runs infinity to first[(k + 1) % 3]; the next one runs first[(k + 1) % 3] to infinity.
+		std::uint32_t hull = 1 + k;
+		std::uint32_t next = 1 + (k + 1) % 3;
+		state.twins[hull * 3 + 2] = next * 3 + 1;
+		state.twins[next * 3 + 1] = hull * 3 + 2;
+	}
+	state.last = inner;
+	state.stamp = 0;
+	state.startingAt.resize(count + 1);
+
+	// Insert the rest in order.
+	for (std::size_t i = 1; i < count; i++)
+	{
+		if (i != first[1] && i != first[2])
+		{
+			insertPoint(state, static_cast<std::uint32_t>(i));
+		}
+	}
+
+	// Copy the points and the finite triangles into the mesh, back in the caller's numbering.
+	std::size_t triangleCount = 0;
+	std::size_t slotCount = state.visitTag.size();
+	for (std::uint32_t t = 0; t < slotCount; t++)
+	{
+		if (state.corners[t * 3] != DEAD && infiniteCorner(state, t) < 0)
+		{
+			triangleCount++;
+		}
+	}
+	mesh.resize(count, triangleCount);
+	PointBuffer& vertices = mesh.getVertices();
+	const int* zs = points.dataZ();
+	for (std::size_t i = 0; i < count; i++)
+	{
+		vertices.setPoint(i, xs[i], ys[i], zs[i]);
+	}
+	std::uint32_t* indices = mesh.getIndices();
+	for (std::uint32_t t = 0; t < slotCount; t++)
+	{
+		if (state.corners[t * 3] != DEAD && infiniteCorner(state, t) < 0)
+		{
+			*indices++ = order[state.corners[t * 3]];
+			*indices++ = order[state.corners[t * 3 + 1]];
+			*indices++ = order[state.corners[t * 3 + 2]];
+		}
+	}
+	return true;
+}
+
+/*
+ * Computes the Delaunay triangulation of a set of points seen from above on the program's shared thread pool.
+ *
+ * @param points The points to triangulate.
+ * @param mesh Receives the triangulation. Its previous contents are replaced.
+ * @return True if the triangulation was built, false if the points do not span an area.
+ */
+bool computeDelaunayTriangulation(const PointBuffer& points, TriangleMesh& mesh)
+{
+	return computeDelaunayTriangulation(points, mesh, ThreadPool::getShared());
+}
@@ -0,0 +1,42 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef DELAUNAY_H
+#define DELAUNAY_H
+
+// Includes the PointBuffer.h header file to read the point sets.
+#include "PointBuffer.h"
+// Includes the TriangleMesh.h header file to return the triangulation as an indexed mesh.
+#include "TriangleMesh.h"
+// Includes the ThreadPool.h header file to compute and sort the insertion order in parallel.
+#include "ThreadPool.h"
+
+/*
+ * Computes the Delaunay triangulation of a set of points seen from above, for terrain and scan data:
+ * the triangles are chosen by the x- and y-coordinates only, and each vertex keeps its z-coordinate.
+ * Points are inserted one at a time with the Bowyer-Watson algorithm, in a biased randomized order (BRIO):
+ * a random half of the points goes last, a random half of the rest before that, and so on, and each round
+ * follows a Hilbert curve, so each point is found by a short walk from the one inserted before it.
+ * The triangles are stored as half-edges in two flat arrays, and the hull is closed with triangles to a vertex
+ * at infinity, so points outside the hull need no special case. Every decision uses the exact orient2d() and
+ * incircle() predicates, so the result is correct for any int coordinates, including collinear and cocircular points.
+ *
+ * @param points The points to triangulate.
+ * @param mesh Receives the triangulation: a copy of every point as a vertex, at the same index, and triangles that turn
+ *             counterclockwise seen from above. A point at the same x and y as an earlier one is kept as a vertex
+ *             but used by no triangle. Its previous contents are replaced.
+ * @param pool The thread pool that computes and sorts the insertion order.
+ * @return True if the triangulation was built, false if the points do not span an area (fewer than three points,
+ *         or all of them on one line seen from above), in which case the mesh is left empty.
+ */
+bool computeDelaunayTriangulation(const PointBuffer& points, TriangleMesh& mesh, ThreadPool& pool);
+
+/*
+ * Computes the Delaunay triangulation of a set of points seen from above on the program's shared thread pool.
+ *
+ * @param points The points to triangulate.
+ * @param mesh Receives the triangulation. Its previous contents are replaced.
+ * @return True if the triangulation was built, false if the points do not span an area.
+ */
+bool computeDelaunayTriangulation(const PointBuffer& points, TriangleMesh& mesh);
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -4,236 +4,439 @@
 #include "Triangle.h"
 // Includes the Point.h header file for function declarations.
 #include "Point.h"
+// Includes the StlReader.h header file to load meshes from binary STL files.
+#include "StlReader.h"
+// Includes the MeshReduce.h header file to summarize loaded meshes.
+#include "MeshReduce.h"
+// Includes the InputParser.h header file to validate and convert user input in a single pass.
+#include "InputParser.h"
 
 // Includes the input/output stream library for performing input/output operations in the console.
 #include <iostream>
 // Includes the string library to work with string variables for user input.
 #include <string>
-// Includes the stringstream library to convert string inputs into integer values.
-#include <sstream>
 // Includes the standard library for system commands such as clearing the screen.
 #include <cstdlib>
 // Includes the cctype library for character manipulation functions like 'tolower'.
 #include <cctype>
+// Includes the chrono library to time mesh loading.
+#include <chrono>
+
+// Number of batch commands between two flushes of the session log.
+static const unsigned long long BATCH_FLUSH_INTERVAL = 4096;
 
 /*
- * Default constructor for the Driver class.
- * Initializes the triangle pointer to nullptr, meaning no triangle is created when the Driver object is first instantiated.
+ * Parses the target of a command: a triangle handle written as index:generation, or the word all.
+ *
+ * @param text The text to parse.
+ * @param handle Receives the handle.
+ * @param all Receives true if the text is all.
+ * @return True if the text is a well-formed handle or all, false otherwise.
  */
-Driver::Driver()
+static bool parseHandle(std::string_view text, SlotHandle& handle, bool& all)
 {
-	// Initialize triangle pointer to nullptr, indicating no triangle object exists yet.
-	triangle = nullptr;
+	// The whole scene is named by a keyword.
+	all = text == "all";
+	if (all)
+	{
+		return true;
+	}
+
+	// A handle is two unsigned numbers separated by a colon.
+	std::size_t colon = text.find(':');
+	return colon != std::string_view::npos && parseUnsigned(text.substr(0, colon), handle.index)
+		&& parseUnsigned(text.substr(colon + 1), handle.generation);
 }
 
 /*
- * Creates a triangle by asking the user to input the coordinates of three points.
- * The function dynamically allocates memory for the three points and constructs a Triangle object using these points.
- * It also handles invalid input properly and ensures proper integer inputs for the coordinates.
+ * Writes a triangle's handle and the nine coordinates of its vertices on one line, in the order create takes them.
+ *
+ * @param output The stream to write to.
+ * @param handle The handle of the triangle.
+ * @param triangle The triangle to write.
  */
-void Driver::createTriangle()
+static void writeTriangleLine(std::ostream& output, SlotHandle handle, const Triangle& triangle)
 {
-// Clears the console screen for Windows operating systems.
-#ifdef _WIN32
-	system("cls");
-// Clears the console screen for Unix-based or macOS systems.
-#elif __unix__ || __APPLE__
-	system("clear");
-// If the OS doesn't support clear, show an error.
-#else
-	std::cerr << "Clear console command not supported on this OS.\n";
-#endif
+	output << handle.index << ':' << handle.generation;
+	for (int vertex = 1; vertex <= 3; vertex++)
+	{
+		const Point* point = triangle.getVertex(vertex);
+		output << ' ' << point->getCoordinateX() << ' ' << point->getCoordinateY() << ' ' << point->getCoordinateZ();
+	}
+	output << '\n';
+}
 
-	// Declare pointers to three Point objects, initialized to nullptr.
-	Point* a = nullptr;
-	Point* b = nullptr;
-	Point* c = nullptr;
+/*
+ * Default constructor for the Driver class.
+ * The scene, the arena, and the mesh all start empty, so no triangle exists when the Driver object is first instantiated.
+ */
+Driver::Driver() : pendingOffset{ 0, 0, 0 }
+{
+	// Constructor body is empty since every member starts empty.
+}
 
-	// Declare a string variable to hold user input.
-	std::string input;
+/*
+ * Takes three vertices from freePoints or the arena and sets their coordinates.
+ *
+ * @param coordinates The x, y, and z coordinates of the three vertices, in that order.
+ * @param vertices Receives the three vertices.
+ */
+void Driver::takeVertices(const int coordinates[9], Point* vertices[3])
+{
+	for (int i = 0; i < 3; i++)
+	{
+		// Store the vertex without the pending translation, which is added back when the scene is flushed.
+		int x = coordinates[i * 3] - pendingOffset[0];
+		int y = coordinates[i * 3 + 1] - pendingOffset[1];
+		int z = coordinates[i * 3 + 2] - pendingOffset[2];
 
-	// Declare integer variables to store the x, y, and z coordinates.
-	int coordinateX;
-	int coordinateY;
-	int coordinateZ;
+		// Reuse the vertex of a deleted triangle if there is one, otherwise allocate a new one in the arena.
+		if (!freePoints.empty())
+		{
+			vertices[i] = freePoints.back();
+			freePoints.pop_back();
+			*vertices[i] = Point(x, y, z);
+		}
+		else
+		{
+			vertices[i] = arena.create<Point>(x, y, z);
+		}
+	}
+}
 
-	// Input and validation for the first point (x coordinate).
-	std::cout << "Enter the x coordinate of the first point: ";
-	// Read input from the user.
-	std::getline(std::cin, input);
-	// Validate that the input is a valid integer.
-	if (isValidInputInt(input))
+/*
+ * Adds a triangle to the scene, taking its vertices from freePoints or the arena, and logs it.
+ *
+ * @param coordinates The x, y, and z coordinates of the three vertices, in that order.
+ * @return The handle of the new triangle.
+ */
+SlotHandle Driver::addTriangle(const int coordinates[9])
+{
+	Point* vertices[3];
+	takeVertices(coordinates, vertices);
+
+	// Construct the triangle in the scene; the arena owns the vertices.
+	SlotHandle handle = scene.emplace(vertices[0], vertices[1], vertices[2], false);
+	log.logCreate(handle, coordinates);
+	checkSnapshot();
+	return handle;
+}
+
+/*
+ * Translates one triangle or the whole scene and logs the change.
+ *
+ * @param handle The handle of the triangle; ignored when all is true.
+ * @param all Whether to translate every triangle in the scene.
+ * @param distance The distance to translate by.
+ * @param axis The axis to translate along ('x', 'y', or 'z').
+ */
+void Driver::translateTarget(SlotHandle handle, bool all, int distance, char axis)
+{
+	// Translating the whole scene only adds to the pending offset, so repeated translations cost nothing until a read.
+	if (all)
 	{
-		// Convert the input string to an integer.
-		coordinateX = std::stoi(input);
+		pendingOffset[axis - 'x'] += distance;
 	}
-	// Exit the function if the input is invalid.
+	// Translations add up in any order, so one triangle can move while the scene's offset is still pending.
 	else
 	{
-		std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
-		return;
+		scene.get(handle)->translate(distance, axis);
 	}
+	log.logTranslate(handle, all, distance, axis);
+	checkSnapshot();
+}
 
-	// Input and validation for the first point (y coordinate).
-	std::cout << "Enter the y coordinate of the first point: ";
-	// Read input from the user.
-	std::getline(std::cin, input);
-	// Validate that the input is a valid integer.
-	if (isValidInputInt(input))
+/*
+ * Removes a triangle from the scene and keeps its vertices for reuse.
+ *
+ * @param handle The handle of the triangle.
+ * @return True if the triangle was removed, false if the handle is stale.
+ */
+bool Driver::eraseTriangle(SlotHandle handle)
+{
+	Triangle* triangle = scene.get(handle);
+	if (triangle == nullptr)
 	{
-		// Convert the input string to an integer.
-		coordinateY = std::stoi(input);
+		return false;
 	}
-	// Exit the function if the input is invalid.
-	else
+
+	// Keep the vertices for the next triangles, since the arena cannot free them one by one.
+	for (int vertex = 1; vertex <= 3; vertex++)
 	{
-		std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
-		return;
+		freePoints.push_back(triangle->getVertex(vertex));
 	}
+	scene.erase(handle);
+	log.logErase(handle, false);
+	checkSnapshot();
+	return true;
+}
 
-	// Input and validation for the first point (z coordinate).
-	std::cout << "Enter the z coordinate of the first point: ";
-	// Read input from the user.
-	std::getline(std::cin, input);
-	// Validate that the input is a valid integer.
-	if (isValidInputInt(input))
+/*
+ * Removes every triangle from the scene and logs it.
+ */
+void Driver::eraseAll()
+{
+	clearScene();
+	log.logErase(SlotHandle{ 0, 0 }, true);
+	checkSnapshot();
+}
+
+/*
+ * Applies the pending translation of the whole scene to every vertex in one pass over the packed scene.
+ */
+void Driver::flushTranslation()
+{
+	for (int axis = 0; axis < 3; axis++)
 	{
-		// Convert the input string to an integer.
-		coordinateZ = std::stoi(input);
+		if (pendingOffset[axis] == 0)
+		{
+			continue;
+		}
+		for (Triangle& triangle : scene)
+		{
+			triangle.translate(pendingOffset[axis], static_cast<char>('x' + axis));
+		}
+		pendingOffset[axis] = 0;
 	}
-	// Exit the function if the input is invalid.
-	else
+}
+
+/*
+ * Removes every triangle from the scene and releases all vertices to the arena at once, without logging it.
+ */
+void Driver::clearScene()
+{
+	scene.clear();
+	freePoints.clear();
+	arena.reset();
+	// Nothing is left to translate.
+	pendingOffset[0] = 0;
+	pendingOffset[1] = 0;
+	pendingOffset[2] = 0;
+}
+
+/*
+ * Applies one change read back from a session's snapshot or log.
+ * The log is not open yet while a session is being restored, so the helpers used here do not log the change again.
+ *
+ * @param record The change to apply.
+ * @return True if the change was applied, false if it does not fit the scene.
+ */
+bool Driver::applyRecord(const SessionRecord& record)
+{
+	if (record.type == SessionRecord::Create)
 	{
-		std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
-		return;
+		// Recreate the triangle under the handle it had, so saved handles stay valid.
+		Point* vertices[3];
+		takeVertices(record.coordinates, vertices);
+		if (!scene.emplaceAt(record.handle, vertices[0], vertices[1], vertices[2], false))
+		{
+			freePoints.insert(freePoints.end(), vertices, vertices + 3);
+			return false;
+		}
+		return true;
 	}
 
-	// Dynamically allocate memory for Point 'a' and initialize it with the user input.
-	a = new Point(coordinateX, coordinateY, coordinateZ);
-
-	// Input and validation for the second point (x coordinate).
-	std::cout << "\nEnter the x coordinate of the second point: ";
-	// Read input from the user.
-	std::getline(std::cin, input);
-	// Validate that the input is a valid integer.
-	if (isValidInputInt(input))
+	// Translations and deletions must name a triangle that exists, unless they apply to the whole scene.
+	if (!record.all && !scene.contains(record.handle))
 	{
-		// Convert the input string to an integer.
-		coordinateX = std::stoi(input);
+		return false;
 	}
-	// Exit the function if the input is invalid.
-	else
+	if (record.type == SessionRecord::Translate)
 	{
-		std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
-		return;
+		if (!(record.axis == 'x' || record.axis == 'y' || record.axis == 'z'))
+		{
+			return false;
+		}
+		translateTarget(record.handle, record.all, record.distance, record.axis);
 	}
-
-	// Input and validation for the second point (y coordinate).
-	std::cout << "Enter the y coordinate of the second point: ";
-	// Read input from the user.
-	std::getline(std::cin, input);
-	// Validate that the input is a valid integer.
-	if (isValidInputInt(input))
+	else if (record.all)
 	{
-		// Convert the input string to an integer.
-		coordinateY = std::stoi(input);
+		clearScene();
 	}
-	// Exit the function if the input is invalid.
 	else
 	{
-		std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
-		return;
+		eraseTriangle(record.handle);
 	}
+	return true;
+}
 
-	// Input and validation for the second point (z coordinate).
-	std::cout << "Enter the z coordinate of the second point: ";
-	// Read input from the user.
-	std::getline(std::cin, input);
-	// Validate that the input is a valid integer.
-	if (isValidInputInt(input))
-	{
-		// Convert the input string to an integer.
-		coordinateZ = std::stoi(input);
-	}
-	// Exit the function if the input is invalid.
-	else
+/*
+ * Writes a snapshot of the scene once enough changes have been logged since the last one.
+ */
+void Driver::checkSnapshot()
+{
+	if (!log.shouldSnapshot())
 	{
-		std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
 		return;
 	}
-
-	// Dynamically allocate memory for Point 'b' and initialize it with the user input.
-	b = new Point(coordinateX, coordinateY, coordinateZ);
-
-	// Input and validation for the third point (x coordinate).
-	std::cout << "\nEnter the x coordinate of the third point: ";
-	// Read input from the user.
-	std::getline(std::cin, input);
-	// Validate that the input is a valid integer.
-	if (isValidInputInt(input))
+	// The snapshot stores the vertices as they are, so they must include the pending translation.
+	flushTranslation();
+	if (log.writeSnapshot(scene) != 0)
 	{
-		// Convert the input string to an integer.
-		coordinateX = std::stoi(input);
+		// The log still holds every change, so the session is safe; the snapshot is retried after the next change.
+		std::cerr << "Could not write the session snapshot.\n";
 	}
-	// Exit the function if the input is invalid.
-	else
+}
+
+/*
+ * Writes a final snapshot of the scene and closes the session. Does nothing if no session is open.
+ */
+void Driver::closeSession()
+{
+	if (!log.isOpen())
 	{
-		std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
 		return;
 	}
-
-	// Input and validation for the third point (y coordinate).
-	std::cout << "Enter the y coordinate of the third point: ";
-	// Read input from the user.
-	std::getline(std::cin, input);
-	// Validate that the input is a valid integer.
-	if (isValidInputInt(input))
+	flushTranslation();
+	if (log.writeSnapshot(scene) != 0)
 	{
-		// Convert the input string to an integer.
-		coordinateY = std::stoi(input);
+		std::cerr << "Could not write the session snapshot.\n";
 	}
-	// Exit the function if the input is invalid.
-	else
+	log.close();
+}
+
+/*
+ * Function to restore the scene saved under a base path and log every later change to it.
+ *
+ * @param basePath The path of the session files without their extensions.
+ * @return True if the session was opened, false if its files are damaged or could not be opened.
+ */
+bool Driver::openSession(const std::string& basePath)
+{
+	// Start from an empty scene and rebuild it from the snapshot and the log.
+	closeSession();
+	clearScene();
+	std::uint64_t replayed = 0;
+	int result = log.open(basePath,
+		[this](const std::vector<std::uint32_t>& generations, const std::vector<std::uint32_t>& freeList)
+		{
+			return scene.importSlots(generations, freeList);
+		},
+		[this](const SessionRecord& record)
+		{
+			return applyRecord(record);
+		},
+		replayed);
+	if (result != 0)
 	{
-		std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
-		return;
+		clearScene();
+		std::cerr << "Could not open the session " << basePath << "\n";
+		return false;
 	}
 
-	// Input and validation for the third point (z coordinate).
-	std::cout << "Enter the z coordinate of the third point: ";
+	std::cerr << "Restored " << scene.size() << " triangle(s) from the session " << basePath << " (" << replayed << " logged change(s) replayed).\n";
+	return true;
+}
+
+/*
+ * Asks the user which triangle to work on: a handle such as 0:1, or all for the whole scene.
+ *
+ * @param handle Receives the handle typed by the user.
+ * @param all Receives true if the user chose the whole scene.
+ * @return True if the input names a triangle in the scene or the whole scene, false otherwise.
+ */
+bool Driver::promptHandle(SlotHandle& handle, bool& all)
+{
+	// Declare a string variable for user input of the handle.
+	std::string input;
+
+	// Input and validation of the handle.
+	std::cout << "The scene holds " << scene.size() << " triangle(s).\n";
+	std::cout << "Enter the handle of the triangle (such as 0:1), or all for every triangle: ";
 	// Read input from the user.
 	std::getline(std::cin, input);
-	// Validate that the input is a valid integer.
-	if (isValidInputInt(input))
+
+	// The handle must be the only word on the line.
+	std::string_view remaining(input);
+	std::string_view token;
+	if (!nextToken(remaining, token) || !parseHandle(token, handle, all) || nextToken(remaining, token))
 	{
-		// Convert the input string to an integer.
-		coordinateZ = std::stoi(input);
+		std::cout << "Invalid Input! Please enter a valid handle next time!\n\n";
+		return false;
 	}
-	// Exit the function if the input is invalid.
-	else
+
+	// The handle must still refer to a triangle; it may have been deleted.
+	if (!all && !scene.contains(handle))
 	{
-		std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
-		return;
+		std::cout << "No triangle has that handle! It may have been deleted.\n\n";
+		return false;
 	}
+	return true;
+}
+
+/*
+ * Creates a triangle by asking the user to input the coordinates of three points.
+ * The function allocates the three points in the session arena and adds the Triangle to the scene, which keeps every earlier triangle.
+ * All nine coordinates may be given at once on the first line; otherwise they are asked for one at a time.
+ * It also handles invalid input properly and ensures proper integer inputs for the coordinates.
+ */
+void Driver::createTriangle()
+{
+// Clears the console screen for Windows operating systems.
+#ifdef _WIN32
+	system("cls");
+// Clears the console screen for Unix-based or macOS systems.
+#elif __unix__ || __APPLE__
+	system("clear");
+// If the OS doesn't support clear, show an error.
+#else
+	std::cerr << "Clear console command not supported on this OS.\n";
+#endif
+
+	// Names of the three points and the three axes, used in the prompts.
+	const char* pointNames[3] = { "first", "second", "third" };
+	const char axisNames[3] = { 'x', 'y', 'z' };
 
-	// Dynamically allocate memory for Point 'c' and initialize it with the user input.
-	c = new Point(coordinateX, coordinateY, coordinateZ);
+	// Declare a string variable to hold user input.
+	std::string input;
+
+	// Declare an array storing the x, y, and z coordinates of the three points, in that order.
+	int coordinates[9];
+
+	// Read and validate all nine coordinates before allocating anything,
+	// so an invalid input part way through leaves nothing behind.
+	for (int i = 0; i < 9; i++)
+	{
+		// Separate the points with an empty line, as each new point starts with its x coordinate.
+		if (i > 0 && i % 3 == 0)
+		{
+			std::cout << "\n";
+		}
+
+		// Prompt for the next coordinate.
+		std::cout << "Enter the " << axisNames[i % 3] << " coordinate of the " << pointNames[i / 3] << " point";
+		// The first prompt also offers to take the whole triangle on one line.
+		std::cout << (i == 0 ? " (or all 9 coordinates on one line): " : ": ");
+		// Read input from the user.
+		std::getline(std::cin, input);
+		// Take all nine coordinates at once if the first line holds a whole triangle.
+		if (i == 0 && parseInts(input, coordinates, 9) == 9)
+		{
+			break;
+		}
+		// Validate and convert the input in a single pass; exit the function if the input is invalid.
+		if (!parseInt(input, coordinates[i]))
+		{
+			std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
+			return;
+		}
+	}
 
-	// Construct the triangle using the three points 'a', 'b', and 'c'.
-	triangle = new Triangle(a, b, c);
+	// Add the triangle to the scene.
+	SlotHandle handle = addTriangle(coordinates);
 
-	// Confirm that the triangle has been successfully created.
-	std::cout << "\nTriangle created!\n\n";
+	// Confirm that the triangle has been successfully created and show the handle that refers to it.
+	std::cout << "\nTriangle created with handle " << handle.index << ":" << handle.generation << "!\n\n";
 }
 
 /*
- * This function translates the existing triangle along a specified axis (X, Y, or Z) by a given distance.
- * It ensures that the triangle has been created before performing the translation.
+ * This function translates one triangle, or every triangle in the scene, along a specified axis (X, Y, or Z) by a given distance.
+ * It ensures that a triangle has been created before performing the translation.
  */
 void Driver::translateTriangle()
 {
 	// Exit the function if no triangle has been created.
-	if (triangle == nullptr)
+	if (scene.empty())
 	{
 		std::cout << "No Triangle has been created previously. Please create a triangle before using this option.\n\n";
 		return;
@@ -250,6 +453,14 @@ void Driver::translateTriangle()
 	std::cerr << "Clear console command not supported on this OS.\n";
 #endif
 
+	// Ask which triangle to work on; exit the function if the input is invalid.
+	SlotHandle handle;
+	bool all;
+	if (!promptHandle(handle, all))
+	{
+		return;
+	}
+
 	// Declare a variable to store the translation distance.
 	int distance;
 	// Declare a variable to store the axis for translation.
@@ -263,14 +474,8 @@ void Driver::translateTriangle()
 	std::cout << "Enter the distance to translate the triangle: ";
 	// Read input from the user.
 	std::getline(std::cin, inputD);
-	// Validate that the distance input is a valid integer.
-	if (isValidInputInt(inputD))
-	{
-		// Convert the string input to an integer.
-		distance = std::stoi(inputD);
-	}
-	// Exit the function if the input is invalid.
-	else
+	// Validate and convert the distance in a single pass; exit the function if the input is invalid.
+	if (!parseInt(inputD, distance))
 	{
 		std::cout << "Invalid Input! Please enter a valid integer next time!\n\n";
 		return;
@@ -300,21 +505,26 @@ void Driver::translateTriangle()
 		return;
 	}
 
-	// Perform the translation of the triangle using the input values.
-	triangle->translate(distance, axis);
+	// Perform the translation of the triangle, or of every triangle, using the input values.
+	translateTarget(handle, all, distance, axis);
 
-	// Confirm that the triangle has been successfully translated.
+	// Confirm that the triangles have been successfully translated.
+	if (all)
+	{
+		std::cout << "\nAll " << scene.size() << " triangles translated!\n\n";
+		return;
+	}
 	std::cout << "\nTriangle translated!\n\n";
 }
 
 /*
- * This function displays the current coordinates of the triangle's three vertices.
- * It ensures that the triangle has been created before displaying the coordinates.
+ * This function displays the coordinates of the three vertices of one triangle, or of every triangle in the scene.
+ * It ensures that a triangle has been created before displaying the coordinates.
  */
 void Driver::displayTriangle()
 {
 	// Exit the function if no triangle has been created.
-	if (triangle == nullptr)
+	if (scene.empty())
 	{
 		std::cout << "No Triangle has been created previously. Please create a triangle before using this option.\n\n";
 		return;
@@ -331,18 +541,41 @@ void Driver::displayTriangle()
 	std::cerr << "Clear console command not supported on this OS.\n";
 #endif
 
+	// Ask which triangle to work on; exit the function if the input is invalid.
+	SlotHandle handle;
+	bool all;
+	if (!promptHandle(handle, all))
+	{
+		return;
+	}
+
+	// Bring the stored coordinates up to date with translations of the whole scene.
+	flushTranslation();
+
+	// Display every triangle, each under its handle.
+	if (all)
+	{
+		for (std::size_t i = 0; i < scene.size(); i++)
+		{
+			SlotHandle current = scene.handleAt(i);
+			std::cout << "Triangle " << current.index << ":" << current.generation << "\n";
+			scene.data()[i].displayTriangle();
+		}
+		return;
+	}
+
 	// Call the display method of the Triangle class to print the triangle's coordinates.
-	triangle->displayTriangle();
+	scene.get(handle)->displayTriangle();
 }
 
 /*
- * This function calculates the area of the triangle based on its three vertices.
- * It ensures that the triangle has been created before performing the area calculation.
+ * This function calculates the area of one triangle based on its three vertices, or the total area of the scene.
+ * It ensures that a triangle has been created before performing the area calculation.
  */
 void Driver::calculateTriangleArea()
 {
 	// Exit the function if no triangle has been created.
-	if (triangle == nullptr)
+	if (scene.empty())
 	{
 		std::cout << "No Triangle has been created previously. Please create a triangle before using this option.\n\n";
 		return;
@@ -358,40 +591,174 @@ void Driver::calculateTriangleArea()
 #else
 	std::cerr << "Clear console command not supported on this OS.\n";
 #endif
-	
+
+	// Ask which triangle to work on; exit the function if the input is invalid.
+	SlotHandle handle;
+	bool all;
+	if (!promptHandle(handle, all))
+	{
+		return;
+	}
+	// Add up the areas of every triangle in one pass over the packed scene.
+	if (all)
+	{
+		double total = 0.0;
+		for (Triangle& triangle : scene)
+		{
+			total += triangle.calcArea();
+		}
+		std::cout << "\nTotal Area of " << scene.size() << " Triangles: " << total << "\n\n";
+		return;
+	}
+
 	// Call the calcArea method of the Triangle class to calculate and display the area.
-	std::cout << "Triangle Area: " << triangle->calcArea() << "\n\n";
+	std::cout << "\nTriangle Area: " << scene.get(handle)->calcArea() << "\n\n";
 }
 
 /*
- * This helper function validates if the input string can be converted to a valid integer.
- * It returns true if the string is a valid integer, otherwise returns false.
+ * This function deletes one triangle, or every triangle in the scene.
+ * The handle of a deleted triangle stays invalid even after its slot is reused by a new triangle.
  */
-bool Driver::isValidInputInt(const std::string& stringInput)
+void Driver::deleteTriangle()
 {
-	// Return false if the input string is empty.
-	if (stringInput.empty())
+	// Exit the function if no triangle has been created.
+	if (scene.empty())
 	{
-		return false;
+		std::cout << "No Triangle has been created previously. Please create a triangle before using this option.\n\n";
+		return;
+	}
+
+// Clears the console screen for Windows operating systems.
+#ifdef _WIN32
+	system("cls");
+// Clears the console screen for Unix-based or macOS systems.
+#elif __unix__ || __APPLE__
+	system("clear");
+// If the OS doesn't support clear, show an error.
+#else
+	std::cerr << "Clear console command not supported on this OS.\n";
+#endif
+
+	// Ask which triangle to work on; exit the function if the input is invalid.
+	SlotHandle handle;
+	bool all;
+	if (!promptHandle(handle, all))
+	{
+		return;
+	}
+
+	// Delete the whole scene and release its vertices at once.
+	if (all)
+	{
+		eraseAll();
+		std::cout << "\nAll triangles deleted!\n\n";
+		return;
+	}
+
+	// Delete the triangle and keep its vertices for reuse.
+	eraseTriangle(handle);
+
+	// Confirm that the triangle has been successfully deleted.
+	std::cout << "\nTriangle deleted!\n\n";
+}
+
+/*
+ * This function loads a mesh from a binary STL file chosen by the user.
+ * The file is memory-mapped and decoded in parallel, then the triangle count, total area, and bounds are reported.
+ */
+void Driver::loadMesh()
+{
+// Clears the console screen for Windows operating systems.
+#ifdef _WIN32
+	system("cls");
+// Clears the console screen for Unix-based or macOS systems.
+#elif __unix__ || __APPLE__
+	system("clear");
+// If the OS doesn't support clear, show an error.
+#else
+	std::cerr << "Clear console command not supported on this OS.\n";
+#endif
+
+	// Declare a string variable for the path of the file.
+	std::string path;
+	// Declare a string variable for the welding choice.
+	std::string inputW;
+	// Declare the loading settings, starting from the defaults.
+	StlOptions options;
+	// Loaded meshes are large, so place the triangles that are close in space next to each other in memory.
+	options.reorderByMortonCode = true;
+
+	// Input of the file path.
+	std::cout << "Enter the path of the binary STL file: ";
+	// Read input from the user.
+	std::getline(std::cin, path);
+
+	// Input and validation of the welding choice.
+	std::cout << "Merge vertices shared between triangles? (y or n): ";
+	// Read input from the user.
+	std::getline(std::cin, inputW);
+	// Check if the input is y or n, in either case.
+	if (inputW.length() == 1 && (std::tolower(inputW[0]) == 'y' || std::tolower(inputW[0]) == 'n'))
+	{
+		options.weldVertices = std::tolower(inputW[0]) == 'y';
+	}
+	// Exit the function if the input is invalid.
+	else
+	{
+		std::cout << "Invalid Input! Please enter y or n next time!\n\n";
+		return;
+	}
+
+	// Load the file and measure how long it takes.
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	StlStatus status = loadBinaryStl(path.c_str(), mesh, options);
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	// Exit the function if the file could not be loaded.
+	if (status != StlStatus::Ok)
+	{
+		std::cout << "\nCould not load the mesh: " << getStlStatusMessage(status) << "\n\n";
+		return;
 	}
 
-	// Create a stringstream to process the string input.
-	std::stringstream ss(stringInput);
-	// Declare an integer to store the converted value.
+	// Summarize the loaded mesh.
+	MeshStatistics statistics = computeMeshStatistics(mesh);
+	std::cout << "\nMesh loaded in " << elapsed.count() << " seconds!\n";
+	std::cout << "Triangles: " << statistics.triangleCount << "\n";
+	std::cout << "Vertices: " << statistics.vertexCount << "\n";
+	// The file gives every triangle three vertices of its own, so welding shrank the pool from three per triangle.
+	if (options.weldVertices && statistics.vertexCount > 0)
+	{
+		std::cout << "Compression Ratio: " << static_cast<double>(statistics.triangleCount * 3) / static_cast<double>(statistics.vertexCount) << "x\n";
+	}
+	std::cout << "Total Area: " << statistics.totalArea << "\n";
+	std::cout << "Bounds: (" << statistics.minX << ", " << statistics.minY << ", " << statistics.minZ << ") to ("
+		<< statistics.maxX << ", " << statistics.maxY << ", " << statistics.maxZ << ")\n";
+	// The mesh keeps the vertex centroid up to date from here on, so later translations do not rescan it.
+	double centroidX = 0.0;
+	double centroidY = 0.0;
+	double centroidZ = 0.0;
+	if (mesh.getCentroid(centroidX, centroidY, centroidZ))
+	{
+		std::cout << "Centroid: (" << centroidX << ", " << centroidY << ", " << centroidZ << ")\n";
+	}
+	std::cout << "\n";
+}
+
+/*
+ * This helper function validates if the input string can be converted to a valid integer.
+ * It returns true if the string is a valid integer, otherwise returns false.
+ */
+bool Driver::isValidInputInt(const std::string& stringInput)
+{
+	// Parse the input without building a stream; the converted value is not needed here.
 	int inputInt;
-	// Try converting the string to an integer.
-	ss >> inputInt;
-
-	// Checks if the entire string has been successfully processed and converted to an integer.
-	// `ss.eof()` checks if the end of the input string has been reached, meaning the entire string was read.
-	// `!ss.fail()` ensures that the string was successfully converted into an integer without errors.
-	// If both conditions are true, it means the input string represents a valid integer. Otherwise, it is not.
-	return ss.eof() && !ss.fail();
+	return parseInt(stringInput, inputInt);
 }
 
 /*
  * This function displays a menu with various options for the user to interact with the program.
- * It allows the user to create a triangle, translate it, display its coordinates, calculate its area, or exit.
+ * It allows the user to create triangles, translate, display, measure, or delete one of them or the whole scene, load a mesh, or exit.
  */
 void Driver::menu()
 {
@@ -409,19 +776,15 @@ void Driver::menu()
 		std::cout << "2- Translate Triangle\n";
 		std::cout << "3- Display Triangle's Coordinates\n";
 		std::cout << "4- Calculate Triangle's Area\n";
-		std::cout << "5- Exit\n\n";
+		std::cout << "5- Delete Triangle\n";
+		std::cout << "6- Load a Mesh from a Binary STL File\n";
+		std::cout << "7- Exit\n\n";
 		std::cout << "Select an option: ";
 
 		// Read the user input.
 		std::getline(std::cin, input);
-		// Validate that the input is a valid integer.
-		if (isValidInputInt(input))
-		{
-			// Convert the string input to an integer.
-			option = std::stoi(input);
-		}
-		// If the input is invalid, prompt the user again.
-		else
+		// Validate and convert the input in a single pass; if it is invalid, prompt the user again.
+		if (!parseInt(input, option))
 		{
 			std::cout << "Invalid Input! Please enter a valid integer!\n\n";
 			// Skip the rest of the loop and ask the user for input again.
@@ -449,8 +812,18 @@ void Driver::menu()
 			calculateTriangleArea();
 			break;
 		case 5:
-			// Delete the dynamically allocated memory for the triangle object (if created).
-			delete triangle;
+			// Call the deleteTriangle function to remove triangles from the scene.
+			deleteTriangle();
+			break;
+		case 6:
+			// Call the loadMesh function to read a mesh from a file.
+			loadMesh();
+			break;
+		case 7:
+			// Save the scene if a session is open, so it comes back on the next start.
+			closeSession();
+			// Destroy every triangle in the scene and release their points to the arena in bulk.
+			clearScene();
 			// Print an exit message to notify the user.
 			std::cout << "Exiting...\n";
 			// Exit the menu function
@@ -459,5 +832,188 @@ void Driver::menu()
 			// Print an error message for invalid options and prompt the user to try again.
 			std::cout << "Invalid option! Please try again!\n\n";
 		}
+
+		// Hand the logged changes to the operating system after every action, so a crash of the program loses none of them.
+		// A crash of the machine still can, since the file is not synced to the disk.
+		log.flush();
 	}
+}
+
+/*
+ * This function runs a script of triangle commands without prompts or screen clearing.
+ * It shares the triangle and the arena with the interactive menu, and reports its throughput at the end.
+ *
+ * @param input The stream to read commands from.
+ * @param output The stream to write results to.
+ * @param flushEachCommand Whether to hand the logged changes to the operating system after every command.
+ * @return 0 if every command succeeded, -1 if any command failed.
+ */
+int Driver::runBatch(std::istream& input, std::ostream& output, bool flushEachCommand)
+{
+	// Declare a string to hold the current line of the script.
+	std::string line;
+	// Number of the current line, for error messages.
+	unsigned long long lineNumber = 0;
+	// Number of commands run and number of commands that failed.
+	unsigned long long commandCount = 0;
+	unsigned long long errorCount = 0;
+
+	// Time the whole script.
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// Read the script one line at a time.
+	while (std::getline(input, line))
+	{
+		lineNumber++;
+
+		// Split off the command; the rest of the line holds its arguments.
+		std::string_view arguments(line);
+		std::string_view command;
+		// Skip empty lines and comments.
+		if (!nextToken(arguments, command) || command[0] == '#')
+		{
+			continue;
+		}
+		commandCount++;
+
+		// Message describing why the command failed, or nullptr if it succeeded.
+		const char* error = nullptr;
+		// Scratch token for the arguments that are not plain integer lists.
+		std::string_view token;
+
+		if (command == "create")
+		{
+			// Parse and validate the nine coordinates before allocating anything.
+			int coordinates[9];
+			if (parseInts(arguments, coordinates, 9) != 9)
+			{
+				error = "create takes 9 integer coordinates";
+			}
+			// Add the triangle to the scene and write its handle for later commands.
+			else
+			{
+				SlotHandle handle = addTriangle(coordinates);
+				output << handle.index << ':' << handle.generation << '\n';
+			}
+		}
+		else if (command == "exit")
+		{
+			// Stop reading the script.
+			break;
+		}
+		else if (command == "translate" || command == "area" || command == "display" || command == "erase")
+		{
+			// The other commands start with their target: a handle, or all for the whole scene.
+			SlotHandle handle;
+			bool all;
+			if (!nextToken(arguments, token) || !parseHandle(token, handle, all))
+			{
+				error = "expected a triangle handle such as 0:1, or all";
+			}
+			else if (!all && !scene.contains(handle))
+			{
+				error = "no triangle has that handle";
+			}
+			else if (command == "translate")
+			{
+				// Parse the distance and the axis, which must be the only two arguments after the target.
+				int distance;
+				char axis = '\0';
+				if (nextToken(arguments, token) && parseInt(token, distance) && nextToken(arguments, token) && token.length() == 1)
+				{
+					axis = static_cast<char>(std::tolower(static_cast<unsigned char>(token[0])));
+				}
+				if (!(axis == 'x' || axis == 'y' || axis == 'z') || nextToken(arguments, token))
+				{
+					error = "translate takes a target, an integer distance and an axis (x, y, or z)";
+				}
+				else
+				{
+					translateTarget(handle, all, distance, axis);
+				}
+			}
+			else if (nextToken(arguments, token))
+			{
+				error = "area, display and erase take only a target";
+			}
+			else if (command == "area")
+			{
+				// Write the area, or the total area of the scene, on its own line.
+				double area = 0.0;
+				if (all)
+				{
+					for (Triangle& triangle : scene)
+					{
+						area += triangle.calcArea();
+					}
+				}
+				else
+				{
+					area = scene.get(handle)->calcArea();
+				}
+				output << area << '\n';
+			}
+			else if (command == "display")
+			{
+				// Write one line per triangle, in the order of the packed scene, with the pending translation applied.
+				flushTranslation();
+				if (all)
+				{
+					for (std::size_t i = 0; i < scene.size(); i++)
+					{
+						writeTriangleLine(output, scene.handleAt(i), scene.data()[i]);
+					}
+				}
+				else
+				{
+					writeTriangleLine(output, handle, *scene.get(handle));
+				}
+			}
+			else if (all)
+			{
+				eraseAll();
+			}
+			else
+			{
+				eraseTriangle(handle);
+			}
+		}
+		else
+		{
+			error = "unknown command";
+		}
+
+		// Report the failure and move on to the next line.
+		if (error != nullptr)
+		{
+			errorCount++;
+			std::cerr << "Line " << lineNumber << ": " << error << "\n";
+		}
+
+		// Hand the logged changes to the operating system once per block of commands, or after every command if asked to.
+		// Each flush is a system call, which would otherwise dominate the cost of a long script.
+		if (flushEachCommand || commandCount % BATCH_FLUSH_INTERVAL == 0)
+		{
+			log.flush();
+		}
+	}
+
+	// Make sure every logged change and every result has been written before the report.
+	log.flush();
+	output.flush();
+
+	// Report the number of commands and the throughput.
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	std::cerr << "Ran " << commandCount << " commands (" << errorCount << " failed) in " << elapsed.count() << " seconds";
+	if (elapsed.count() > 0.0)
+	{
+		std::cerr << " (" << static_cast<unsigned long long>(commandCount / elapsed.count()) << " commands per second)";
+	}
+	std::cerr << "\n";
+
+	// Save the scene if a session is open, then release it and its points, as leaving the menu does.
+	closeSession();
+	clearScene();
+
+	return errorCount == 0 ? 0 : -1;
 }
\ No newline at end of file
@@ -4,9 +4,21 @@
 
 // Includes the Triangle.h header file for function declarations.
 #include "Triangle.h"
+// Includes the Arena.h header file for the allocator that owns the session's points and triangles.
+#include "Arena.h"
+// Includes the TriangleMesh.h header file for meshes loaded from files.
+#include "TriangleMesh.h"
+// Includes the SlotMap.h header file for the scene of triangles addressed by handles.
+#include "SlotMap.h"
+// Includes the SessionLog.h header file to save the scene and recover it after a restart.
+#include "SessionLog.h"
 
 // Includes the C++ Standard Library's string header, which provides the std::string class.
 #include <string>
+// Includes the input/output stream library for the streams of batch mode.
+#include <iostream>
+// Includes the vector library for the vertices kept for reuse.
+#include <vector>
 
 /*
  * Declaration of the Driver class that will manage the user interface and triangle operations.
@@ -14,35 +26,146 @@
 class Driver
 {
 private:
-	// Pointer to a Triangle object, used to store the current triangle being worked on.
-	Triangle* triangle;
+	// The triangles of the scene, stored contiguously and addressed by generational handles.
+	SlotMap<Triangle> scene;
+
+	// Arena that owns the vertices of every triangle in the scene and frees them in bulk.
+	Arena arena;
+
+	// Vertices of deleted triangles, reused by the next triangles created so the arena does not keep growing.
+	std::vector<Point*> freePoints;
+
+	// Mesh loaded from a binary STL file, empty until one is loaded.
+	TriangleMesh mesh;
+
+	// Write-ahead log of the scene's changes, open only when a session file was given.
+	SessionLog log;
+
+	// Translation of the whole scene not yet applied to its vertices, indexed by axis (x, y, z).
+	// Translating the whole scene only adds to it; it is applied in one pass before the coordinates are read.
+	int pendingOffset[3];
+
+	/*
+	 * Takes three vertices from freePoints or the arena and sets their coordinates.
+	 *
+	 * @param coordinates The x, y, and z coordinates of the three vertices, in that order.
+	 * @param vertices Receives the three vertices.
+	 */
+	void takeVertices(const int coordinates[9], Point* vertices[3]);
+
+	/*
+	 * Adds a triangle to the scene, taking its vertices from freePoints or the arena, and logs it.
+	 *
+	 * @param coordinates The x, y, and z coordinates of the three vertices, in that order.
+	 * @return The handle of the new triangle.
+	 */
+	SlotHandle addTriangle(const int coordinates[9]);
+
+	/*
+	 * Translates one triangle or the whole scene and logs the change.
+	 *
+	 * @param handle The handle of the triangle; ignored when all is true.
+	 * @param all Whether to translate every triangle in the scene.
+	 * @param distance The distance to translate by.
+	 * @param axis The axis to translate along ('x', 'y', or 'z').
+	 */
+	void translateTarget(SlotHandle handle, bool all, int distance, char axis);
+
+	/*
+	 * Removes a triangle from the scene, keeps its vertices for reuse, and logs it.
+	 *
+	 * @param handle The handle of the triangle.
+	 * @return True if the triangle was removed, false if the handle is stale.
+	 */
+	bool eraseTriangle(SlotHandle handle);
+
+	/*
+	 * Removes every triangle from the scene and logs it.
+	 */
+	void eraseAll();
+
+	/*
+	 * Applies the pending translation of the whole scene to every vertex, so the stored coordinates can be read.
+	 */
+	void flushTranslation();
+
+	/*
+	 * Removes every triangle from the scene and releases all vertices to the arena at once, without logging it.
+	 */
+	void clearScene();
+
+	/*
+	 * Applies one change read back from a session's snapshot or log.
+	 *
+	 * @param record The change to apply.
+	 * @return True if the change was applied, false if it does not fit the scene.
+	 */
+	bool applyRecord(const SessionRecord& record);
+
+	/*
+	 * Writes a snapshot of the scene once enough changes have been logged since the last one.
+	 */
+	void checkSnapshot();
+
+	/*
+	 * Writes a final snapshot of the scene and closes the session. Does nothing if no session is open.
+	 */
+	void closeSession();
+
+	/*
+	 * Asks the user which triangle to work on: a handle such as 0:1, or all for the whole scene.
+	 *
+	 * @param handle Receives the handle typed by the user.
+	 * @param all Receives true if the user chose the whole scene.
+	 * @return True if the input names a triangle in the scene or the whole scene, false otherwise.
+	 */
+	bool promptHandle(SlotHandle& handle, bool& all);
 
 public:
 	/*
-	 * Default constructor declaration for the Driver class, initializes triangle to nullptr.
+	 * Default constructor declaration for the Driver class, starts with an empty scene.
 	 */
 	Driver();
 
 	/*
-	 * Function to create a triangle by prompting the user for 3 points' coordinates.
+	 * Function to restore the scene saved under a base path and log every later change to it.
+	 * The scene is kept in basePath.snap and basePath.wal; both are created if they do not exist.
+	 *
+	 * @param basePath The path of the session files without their extensions.
+	 * @return True if the session was opened, false if its files are damaged or could not be opened.
+	 */
+	bool openSession(const std::string& basePath);
+
+	/*
+	 * Function to create a triangle by prompting the user for 3 points' coordinates and add it to the scene.
 	 */
 	void createTriangle();
 
 	/*
-	 * Function to translate the triangle along a specified axis by a certain distance.
+	 * Function to translate one triangle, or the whole scene, along a specified axis by a certain distance.
 	 */
 	void translateTriangle();
 
 	/*
-	 * Function to display the current triangle's coordinates.
+	 * Function to display the coordinates of one triangle or of the whole scene.
 	 */
 	void displayTriangle();
 
 	/*
-	 * Function to calculate the area of the current triangle.
+	 * Function to calculate the area of one triangle or the total area of the whole scene.
 	 */
 	void calculateTriangleArea();
 
+	/*
+	 * Function to delete one triangle or the whole scene.
+	 */
+	void deleteTriangle();
+
+	/*
+	 * Function to load a mesh from a binary STL file and report its size, area, and bounds.
+	 */
+	void loadMesh();
+
 	/*
 	 * Helper function to validate if a given string input is a valid integer.
 	 *
@@ -55,6 +178,28 @@ public:
 	 * Function to display the main menu and handle user input for triangle operations.
 	 */
 	void menu();
+
+	/*
+	 * Function to run a script of scene commands without prompts or screen clearing, one command per line,
+	 * where a target is a triangle handle such as 0:1 or all for the whole scene:
+	 *   create x1 y1 z1 x2 y2 z2 x3 y3 z3   (writes the handle of the new triangle)
+	 *   translate target distance axis
+	 *   area target                          (writes the area, or the total area for all)
+	 *   display target                       (writes "handle x1 y1 z1 x2 y2 z2 x3 y3 z3" per triangle)
+	 *   erase target
+	 *   exit
+	 * Empty lines and lines starting with '#' are skipped. Errors name the line and go to std::cerr, and the script continues.
+	 * The number of commands and the throughput are reported on std::cerr at the end.
+	 * With a session open, the logged changes are handed to the operating system every few thousand commands and
+	 * when the script ends, so a crash of the program loses at most the last block of commands.
+	 *
+	 * @param input The stream to read commands from, such as a file or std::cin.
+	 * @param output The stream to write results to.
+	 * @param flushEachCommand Whether to hand the logged changes to the operating system after every command instead,
+	 *                         which costs a system call per command.
+	 * @return 0 if every command succeeded, -1 if any command failed.
+	 */
+	int runBatch(std::istream& input, std::ostream& output, bool flushEachCommand = false);
 };
 
 // End of the header guard to prevent multiple inclusions of this file.
@@ -0,0 +1,230 @@
+// Includes the ExactMath.h header file for function declarations.
+#include "ExactMath.h"
+
+// Includes cmath for the sqrt function used in area calculation and fabs used by the predicate filters.
+#include <cmath>
+
+// Edge components below this limit keep every double product under 2^52, so the cross product is exact.
+static const std::int64_t FAST_PATH_LIMIT = std::int64_t(1) << 26;
+// Half a unit in the last place of a double, 2^-53.
+static const double EPSILON = 1.1102230246251565e-16;
+// Relative error bounds of the double-precision orientation determinants, from Shewchuk's robust predicates.
+// The differences of int coordinates are exact in double precision, so only the products and sums round.
+static const double ORIENT2D_BOUND = (3.0 + 16.0 * EPSILON) * EPSILON;
+static const double ORIENT3D_BOUND = (7.0 + 56.0 * EPSILON) * EPSILON;
+static const double INCIRCLE_BOUND = (10.0 + 96.0 * EPSILON) * EPSILON;
+
+/*
+ * Returns the absolute value of a 64-bit integer.
+ *
+ * @param value The value.
+ * @return The absolute value.
+ */
+static std::int64_t absolute(std::int64_t value)
+{
+	return value < 0 ? -value : value;
+}
+
+/*
+ * Checks whether the double-precision cross product is exact for every triangle inside a box.
+ *
+ * @param extentX The largest x-coordinate minus the smallest one.
+ * @param extentY The largest y-coordinate minus the smallest one.
+ * @param extentZ The largest z-coordinate minus the smallest one.
+ * @return True if the fast double-precision area is exact inside the box.
+ */
+bool isAreaFastPathSafe(std::int64_t extentX, std::int64_t extentY, std::int64_t extentZ)
+{
+	return extentX < FAST_PATH_LIMIT && extentY < FAST_PATH_LIMIT && extentZ < FAST_PATH_LIMIT;
+}
+
+/*
+ * Calculates the area of a triangle given the integer coordinates of its three vertices.
+ * Uses the cross product of two vectors formed by the vertices to compute the area.
+ *
+ * @param aX The x-coordinate of the first vertex.
+ * @param aY The y-coordinate of the first vertex.
+ * @param aZ The z-coordinate of the first vertex.
+ * @param bX The x-coordinate of the second vertex.
+ * @param bY The y-coordinate of the second vertex.
+ * @param bZ The z-coordinate of the second vertex.
+ * @param cX The x-coordinate of the third vertex.
+ * @param cY The y-coordinate of the third vertex.
+ * @param cZ The z-coordinate of the third vertex.
+ * @return The area of the triangle.
+ */
+double calcTriangleArea(int aX, int aY, int aZ, int bX, int bY, int bZ, int cX, int cY, int cZ)
+{
+	// Compute Vector AB in 64 bits, which is exact for any pair of int coordinates.
+	std::int64_t abX = static_cast<std::int64_t>(bX) - aX;
+	std::int64_t abY = static_cast<std::int64_t>(bY) - aY;
+	std::int64_t abZ = static_cast<std::int64_t>(bZ) - aZ;
+
+	// Compute Vector AC in 64 bits.
+	std::int64_t acX = static_cast<std::int64_t>(cX) - aX;
+	std::int64_t acY = static_cast<std::int64_t>(cY) - aY;
+	std::int64_t acZ = static_cast<std::int64_t>(cZ) - aZ;
+
+	// Components of the cross product of vectors AB and AC.
+	double vX;
+	double vY;
+	double vZ;
+
+	// Fast filter: small edges keep every product exact in double precision.
+	if (absolute(abX) < FAST_PATH_LIMIT && absolute(abY) < FAST_PATH_LIMIT && absolute(abZ) < FAST_PATH_LIMIT &&
+		absolute(acX) < FAST_PATH_LIMIT && absolute(acY) < FAST_PATH_LIMIT && absolute(acZ) < FAST_PATH_LIMIT)
+	{
+		vX = static_cast<double>(abY) * acZ - static_cast<double>(acY) * abZ;
+		vY = static_cast<double>(acX) * abZ - static_cast<double>(abX) * acZ;
+		vZ = static_cast<double>(abX) * acY - static_cast<double>(acX) * abY;
+	}
+	// Exact path: products reach 2^64 and their differences 2^65, so compute them in 128 bits.
+	else
+	{
+		vX = (Int128(abY) * Int128(acZ) - Int128(acY) * Int128(abZ)).toDouble();
+		vY = (Int128(acX) * Int128(abZ) - Int128(abX) * Int128(acZ)).toDouble();
+		vZ = (Int128(abX) * Int128(acY) - Int128(acX) * Int128(abY)).toDouble();
+	}
+
+	// The area of the triangle is half the magnitude of the cross product.
+	return 0.5 * std::sqrt(vX * vX + vY * vY + vZ * vZ);
+}
+
+/*
+ * Finds on which side of the directed line through a and b the point c lies, exactly.
+ *
+ * @param aX The x-coordinate of the first point of the line.
+ * @param aY The y-coordinate of the first point of the line.
+ * @param bX The x-coordinate of the second point of the line.
+ * @param bY The y-coordinate of the second point of the line.
+ * @param cX The x-coordinate of the point to classify.
+ * @param cY The y-coordinate of the point to classify.
+ * @return 1 if a, b, c turn counterclockwise, -1 if clockwise, 0 if they are collinear.
+ */
+int orient2d(int aX, int aY, int bX, int bY, int cX, int cY)
+{
+	// The edge vectors, exact in 64 bits and in double precision.
+	std::int64_t abX = static_cast<std::int64_t>(bX) - aX;
+	std::int64_t abY = static_cast<std::int64_t>(bY) - aY;
+	std::int64_t acX = static_cast<std::int64_t>(cX) - aX;
+	std::int64_t acY = static_cast<std::int64_t>(cY) - aY;
+
+	// Fast filter: the rounded determinant has the right sign when it is larger than its error bound.
+	double left = static_cast<double>(abX) * static_cast<double>(acY);
+	double right = static_cast<double>(abY) * static_cast<double>(acX);
+	double determinant = left - right;
+	double bound = ORIENT2D_BOUND * (std::fabs(left) + std::fabs(right));
+	if (determinant > bound || -determinant > bound)
+	{
+		return determinant > 0.0 ? 1 : -1;
+	}
+
+	// Exact path: each product needs up to 66 bits.
+	return (Int128(abX) * Int128(acY) - Int128(abY) * Int128(acX)).sign();
+}
+
+/*
+ * Finds on which side of the plane through a, b, and c the point d lies, exactly.
+ *
+ * @param aX The x-coordinate of the first point of the plane.
+ * @param aY The y-coordinate of the first point of the plane.
+ * @param aZ The z-coordinate of the first point of the plane.
+ * @param bX The x-coordinate of the second point of the plane.
+ * @param bY The y-coordinate of the second point of the plane.
+ * @param bZ The z-coordinate of the second point of the plane.
+ * @param cX The x-coordinate of the third point of the plane.
+ * @param cY The y-coordinate of the third point of the plane.
+ * @param cZ The z-coordinate of the third point of the plane.
+ * @param dX The x-coordinate of the point to classify.
+ * @param dY The y-coordinate of the point to classify.
+ * @param dZ The z-coordinate of the point to classify.
+ * @return 1 if d lies on the side the normal points to, -1 if it lies on the other side, 0 if the points are coplanar.
+ */
+int orient3d(int aX, int aY, int aZ, int bX, int bY, int bZ, int cX, int cY, int cZ, int dX, int dY, int dZ)
+{
+	// The edge vectors from a, exact in 64 bits and in double precision.
+	std::int64_t abX = static_cast<std::int64_t>(bX) - aX;
+	std::int64_t abY = static_cast<std::int64_t>(bY) - aY;
+	std::int64_t abZ = static_cast<std::int64_t>(bZ) - aZ;
+	std::int64_t acX = static_cast<std::int64_t>(cX) - aX;
+	std::int64_t acY = static_cast<std::int64_t>(cY) - aY;
+	std::int64_t acZ = static_cast<std::int64_t>(cZ) - aZ;
+	std::int64_t adX = static_cast<std::int64_t>(dX) - aX;
+	std::int64_t adY = static_cast<std::int64_t>(dY) - aY;
+	std::int64_t adZ = static_cast<std::int64_t>(dZ) - aZ;
+
+	// Fast filter: expand the determinant along d - a and bound the rounding error by the permanent.
+	double yz = static_cast<double>(abY) * static_cast<double>(acZ);
+	double zy = static_cast<double>(abZ) * static_cast<double>(acY);
+	double zx = static_cast<double>(abZ) * static_cast<double>(acX);
+	double xz = static_cast<double>(abX) * static_cast<double>(acZ);
+	double xy = static_cast<double>(abX) * static_cast<double>(acY);
+	double yx = static_cast<double>(abY) * static_cast<double>(acX);
+	double determinant = static_cast<double>(adX) * (yz - zy) + static_cast<double>(adY) * (zx - xz) + static_cast<double>(adZ) * (xy - yx);
+	double permanent = std::fabs(static_cast<double>(adX)) * (std::fabs(yz) + std::fabs(zy))
+		+ std::fabs(static_cast<double>(adY)) * (std::fabs(zx) + std::fabs(xz))
+		+ std::fabs(static_cast<double>(adZ)) * (std::fabs(xy) + std::fabs(yx));
+	double bound = ORIENT3D_BOUND * permanent;
+	if (determinant > bound || -determinant > bound)
+	{
+		return determinant > 0.0 ? 1 : -1;
+	}
+
+	// Exact path: the cross product needs 67 bits and the final products about 101, well inside 128.
+	Int128 crossX = Int128(abY) * Int128(acZ) - Int128(abZ) * Int128(acY);
+	Int128 crossY = Int128(abZ) * Int128(acX) - Int128(abX) * Int128(acZ);
+	Int128 crossZ = Int128(abX) * Int128(acY) - Int128(abY) * Int128(acX);
+	return (Int128(adX) * crossX + Int128(adY) * crossY + Int128(adZ) * crossZ).sign();
+}
+
+/*
+ * Finds whether the point d lies inside the circle through a, b, and c, exactly, looking only at x and y.
+ *
+ * @param aX The x-coordinate of the first point on the circle.
+ * @param aY The y-coordinate of the first point on the circle.
+ * @param bX The x-coordinate of the second point on the circle.
+ * @param bY The y-coordinate of the second point on the circle.
+ * @param cX The x-coordinate of the third point on the circle.
+ * @param cY The y-coordinate of the third point on the circle.
+ * @param dX The x-coordinate of the point to classify.
+ * @param dY The y-coordinate of the point to classify.
+ * @return 1 if d lies inside the circle, -1 if outside, 0 if the four points are cocircular.
+ */
+int incircle(int aX, int aY, int bX, int bY, int cX, int cY, int dX, int dY)
+{
+	// The vectors from d to the points on the circle, exact in 64 bits and in double precision.
+	std::int64_t adX = static_cast<std::int64_t>(aX) - dX;
+	std::int64_t adY = static_cast<std::int64_t>(aY) - dY;
+	std::int64_t bdX = static_cast<std::int64_t>(bX) - dX;
+	std::int64_t bdY = static_cast<std::int64_t>(bY) - dY;
+	std::int64_t cdX = static_cast<std::int64_t>(cX) - dX;
+	std::int64_t cdY = static_cast<std::int64_t>(cY) - dY;
+
+	// Fast filter: expand the lifted determinant along the squared lengths and bound the error by the permanent.
+	double bc = static_cast<double>(bdX) * static_cast<double>(cdY);
+	double cb = static_cast<double>(cdX) * static_cast<double>(bdY);
+	double ca = static_cast<double>(cdX) * static_cast<double>(adY);
+	double ac = static_cast<double>(adX) * static_cast<double>(cdY);
+	double ab = static_cast<double>(adX) * static_cast<double>(bdY);
+	double ba = static_cast<double>(bdX) * static_cast<double>(adY);
+	double aLift = static_cast<double>(adX) * adX + static_cast<double>(adY) * adY;
+	double bLift = static_cast<double>(bdX) * bdX + static_cast<double>(bdY) * bdY;
+	double cLift = static_cast<double>(cdX) * cdX + static_cast<double>(cdY) * cdY;
+	double determinant = aLift * (bc - cb) + bLift * (ca - ac) + cLift * (ab - ba);
+	double permanent = aLift * (std::fabs(bc) + std::fabs(cb)) + bLift * (std::fabs(ca) + std::fabs(ac))
+		+ cLift * (std::fabs(ab) + std::fabs(ba));
+	double bound = INCIRCLE_BOUND * permanent;
+	if (determinant > bound || -determinant > bound)
+	{
+		return determinant > 0.0 ? 1 : -1;
+	}
+
+	// Exact path: the squared lengths need 67 bits and the cross products 67, so each term needs about 134 bits.
+	Int160 aSquared = Int160(adX) * Int160(adX) + Int160(adY) * Int160(adY);
+	Int160 bSquared = Int160(bdX) * Int160(bdX) + Int160(bdY) * Int160(bdY);
+	Int160 cSquared = Int160(cdX) * Int160(cdX) + Int160(cdY) * Int160(cdY);
+	Int160 bcCross = Int160(bdX) * Int160(cdY) - Int160(cdX) * Int160(bdY);
+	Int160 caCross = Int160(cdX) * Int160(adY) - Int160(adX) * Int160(cdY);
+	Int160 abCross = Int160(adX) * Int160(bdY) - Int160(bdX) * Int160(adY);
+	return (aSquared * bcCross + bSquared * caCross + cSquared * abCross).sign();
+}
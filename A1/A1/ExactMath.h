@@ -0,0 +1,268 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef EXACTMATH_H
+#define EXACTMATH_H
+
+// Includes the cstdint library for the fixed-width integer types used as limbs.
+#include <cstdint>
+
+/*
+ * Defines a fixed-width signed integer made of Limbs 32-bit words in two's complement.
+ * It is used where products of int coordinates no longer fit in 64 bits, for example
+ * the cross product of two edges whose coordinates span more than 2^31.
+ * Results wrap around like built-in unsigned integers, so the caller picks a width large
+ * enough for the values it computes.
+ */
+template <int Limbs>
+class WideInt
+{
+private:
+	// The words of the number, least significant first.
+	std::uint32_t limbs[Limbs];
+
+public:
+	/*
+	 * Default constructor that initializes the number to zero.
+	 */
+	WideInt()
+	{
+		for (int i = 0; i < Limbs; i++)
+		{
+			limbs[i] = 0;
+		}
+	}
+
+	/*
+	 * Constructor that converts a 64-bit integer, extending its sign into the upper words.
+	 *
+	 * @param value The value to convert.
+	 */
+	WideInt(std::int64_t value)
+	{
+		// Reinterpret the value as its two's complement bit pattern.
+		std::uint64_t bits = static_cast<std::uint64_t>(value);
+		// Negative numbers are padded with ones, positive numbers with zeros.
+		std::uint32_t fill = value < 0 ? 0xFFFFFFFFu : 0u;
+		for (int i = 0; i < Limbs; i++)
+		{
+			limbs[i] = i == 0 ? static_cast<std::uint32_t>(bits) : i == 1 ? static_cast<std::uint32_t>(bits >> 32) : fill;
+		}
+	}
+
+	/*
+	 * Adds two numbers.
+	 *
+	 * @param other The number to add.
+	 * @return The sum.
+	 */
+	WideInt operator+(const WideInt& other) const
+	{
+		WideInt result;
+		// Carry from the previous word.
+		std::uint64_t carry = 0;
+		for (int i = 0; i < Limbs; i++)
+		{
+			std::uint64_t sum = static_cast<std::uint64_t>(limbs[i]) + other.limbs[i] + carry;
+			result.limbs[i] = static_cast<std::uint32_t>(sum);
+			carry = sum >> 32;
+		}
+		return result;
+	}
+
+	/*
+	 * Negates the number.
+	 *
+	 * @return The negated number.
+	 */
+	WideInt operator-() const
+	{
+		// Two's complement negation: invert every bit, then add one.
+		WideInt inverted;
+		for (int i = 0; i < Limbs; i++)
+		{
+			inverted.limbs[i] = ~limbs[i];
+		}
+		return inverted + WideInt(1);
+	}
+
+	/*
+	 * Subtracts two numbers.
+	 *
+	 * @param other The number to subtract.
+	 * @return The difference.
+	 */
+	WideInt operator-(const WideInt& other) const
+	{
+		return *this + (-other);
+	}
+
+	/*
+	 * Multiplies two numbers, keeping the lowest Limbs words of the product.
+	 * Two's complement multiplication gives the right signed result whenever it fits.
+	 *
+	 * @param other The number to multiply by.
+	 * @return The product.
+	 */
+	WideInt operator*(const WideInt& other) const
+	{
+		WideInt result;
+		// Schoolbook multiplication, skipping partial products that fall above the top word.
+		for (int i = 0; i < Limbs; i++)
+		{
+			std::uint64_t carry = 0;
+			for (int j = 0; i + j < Limbs; j++)
+			{
+				std::uint64_t product = static_cast<std::uint64_t>(limbs[i]) * other.limbs[j] + result.limbs[i + j] + carry;
+				result.limbs[i + j] = static_cast<std::uint32_t>(product);
+				carry = product >> 32;
+			}
+		}
+		return result;
+	}
+
+	/*
+	 * Returns the sign of the number.
+	 *
+	 * @return -1 if negative, 0 if zero, 1 if positive.
+	 */
+	int sign() const
+	{
+		// The top bit of the top word is the sign bit.
+		if (limbs[Limbs - 1] & 0x80000000u)
+		{
+			return -1;
+		}
+		for (int i = 0; i < Limbs; i++)
+		{
+			if (limbs[i] != 0)
+			{
+				return 1;
+			}
+		}
+		return 0;
+	}
+
+	/*
+	 * Compares two numbers.
+	 *
+	 * @param other The number to compare with.
+	 * @return -1 if this number is smaller, 0 if equal, 1 if larger.
+	 */
+	int compare(const WideInt& other) const
+	{
+		return (*this - other).sign();
+	}
+
+	/*
+	 * Converts the number to the nearest double, within a few units in the last place.
+	 *
+	 * @return The value as a double.
+	 */
+	double toDouble() const
+	{
+		// Convert the magnitude and restore the sign afterwards.
+		if (sign() < 0)
+		{
+			return -(-*this).toDouble();
+		}
+		// Accumulate the words from the most significant down.
+		double result = 0.0;
+		for (int i = Limbs - 1; i >= 0; i--)
+		{
+			result = result * 4294967296.0 + limbs[i];
+		}
+		return result;
+	}
+};
+
+// A 128-bit signed integer, wide enough for any product of two int coordinate differences.
+typedef WideInt<4> Int128;
+// A 160-bit signed integer, wide enough for a squared distance times a cross product of int coordinate differences.
+typedef WideInt<5> Int160;
+
+/*
+ * Calculates the area of a triangle given the integer coordinates of its three vertices.
+ * A fast filter evaluates the cross product in double precision when every edge component is
+ * below 2^26, where the arithmetic is exact. Larger triangles fall back to 128-bit integer
+ * cross products, so the result is correct for the full int range.
+ *
+ * @param aX The x-coordinate of the first vertex.
+ * @param aY The y-coordinate of the first vertex.
+ * @param aZ The z-coordinate of the first vertex.
+ * @param bX The x-coordinate of the second vertex.
+ * @param bY The y-coordinate of the second vertex.
+ * @param bZ The z-coordinate of the second vertex.
+ * @param cX The x-coordinate of the third vertex.
+ * @param cY The y-coordinate of the third vertex.
+ * @param cZ The z-coordinate of the third vertex.
+ * @return The area of the triangle.
+ */
+double calcTriangleArea(int aX, int aY, int aZ, int bX, int bY, int bZ, int cX, int cY, int cZ);
+
+/*
+ * Checks whether the double-precision cross product is exact for every triangle inside a box.
+ * That holds when no coordinate differs from another by 2^26 or more on any axis.
+ *
+ * @param extentX The largest x-coordinate minus the smallest one.
+ * @param extentY The largest y-coordinate minus the smallest one.
+ * @param extentZ The largest z-coordinate minus the smallest one.
+ * @return True if the fast double-precision area is exact inside the box.
+ */
+bool isAreaFastPathSafe(std::int64_t extentX, std::int64_t extentY, std::int64_t extentZ);
+
+/*
+ * Finds on which side of the directed line through a and b the point c lies, exactly.
+ * The determinant is evaluated in double precision first, with an error bound that proves its sign
+ * in almost every case; only nearly collinear points are evaluated again in 128-bit integers.
+ *
+ * @param aX The x-coordinate of the first point of the line.
+ * @param aY The y-coordinate of the first point of the line.
+ * @param bX The x-coordinate of the second point of the line.
+ * @param bY The y-coordinate of the second point of the line.
+ * @param cX The x-coordinate of the point to classify.
+ * @param cY The y-coordinate of the point to classify.
+ * @return 1 if a, b, c turn counterclockwise (c lies to the left), -1 if clockwise, 0 if they are collinear.
+ */
+int orient2d(int aX, int aY, int bX, int bY, int cX, int cY);
+
+/*
+ * Finds on which side of the plane through a, b, and c the point d lies, exactly.
+ * The sign is that of the determinant of b - a, c - a, and d - a: positive when d lies on the side the
+ * normal (b - a) x (c - a) points to, that is, when a, b, c turn counterclockwise as seen from d.
+ * Like orient2d(), a double-precision filter settles almost every case before the 128-bit fallback.
+ *
+ * @param aX The x-coordinate of the first point of the plane.
+ * @param aY The y-coordinate of the first point of the plane.
+ * @param aZ The z-coordinate of the first point of the plane.
+ * @param bX The x-coordinate of the second point of the plane.
+ * @param bY The y-coordinate of the second point of the plane.
+ * @param bZ The z-coordinate of the second point of the plane.
+ * @param cX The x-coordinate of the third point of the plane.
+ * @param cY The y-coordinate of the third point of the plane.
+ * @param cZ The z-coordinate of the third point of the plane.
+ * @param dX The x-coordinate of the point to classify.
+ * @param dY The y-coordinate of the point to classify.
+ * @param dZ The z-coordinate of the point to classify.
+ * @return 1 if d lies on the side the normal points to, -1 if it lies on the other side, 0 if the four points are coplanar.
+ */
+int orient3d(int aX, int aY, int aZ, int bX, int bY, int bZ, int cX, int cY, int cZ, int dX, int dY, int dZ);
+
+/*
+ * Finds whether the point d lies inside the circle through a, b, and c, exactly, looking only at x and y.
+ * The points a, b, c must turn counterclockwise; for clockwise points the sign is reversed.
+ * A double-precision filter settles almost every case. The rest are evaluated again in 160-bit integers,
+ * since the lifted determinant of int coordinates needs up to 133 bits.
+ *
+ * @param aX The x-coordinate of the first point on the circle.
+ * @param aY The y-coordinate of the first point on the circle.
+ * @param bX The x-coordinate of the second point on the circle.
+ * @param bY The y-coordinate of the second point on the circle.
+ * @param cX The x-coordinate of the third point on the circle.
+ * @param cY The y-coordinate of the third point on the circle.
+ * @param dX The x-coordinate of the point to classify.
+ * @param dY The y-coordinate of the point to classify.
+ * @return 1 if d lies inside the circle, -1 if outside, 0 if the four points are cocircular.
+ */
+int incircle(int aX, int aY, int bX, int bY, int cX, int cY, int dX, int dY);
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -0,0 +1,132 @@
+// Includes the InputParser.h header file for function declarations.
+#include "InputParser.h"
+
+// Includes the charconv library for std::from_chars, which converts numbers without locales or allocations.
+#include <charconv>
+
+/*
+ * Checks whether a character separates tokens.
+ *
+ * @param character The character to check.
+ * @return True for spaces, tabs, and line endings.
+ */
+static bool isSpace(char character)
+{
+	return character == ' ' || character == '\t' || character == '\r' || character == '\n' || character == '\v' || character == '\f';
+}
+
+/*
+ * Converts a piece of text to a number of any integer type in a single pass.
+ * Leading spaces and a '+' followed by a digit are skipped; the number must use up the rest of the text.
+ *
+ * @param text The text to parse.
+ * @param value Receives the number.
+ * @return True if the text is a number within range of the type, false otherwise.
+ */
+template <typename Integer>
+static bool parseNumber(std::string_view text, Integer& value)
+{
+	const char* first = text.data();
+	const char* last = first + text.size();
+
+	// Skip leading spaces.
+	while (first != last && isSpace(*first))
+	{
+		first++;
+	}
+	// from_chars only accepts '-', so skip a '+' here, as long as a digit follows.
+	if (first != last && *first == '+' && last - first > 1 && first[1] != '-')
+	{
+		first++;
+	}
+
+	// Convert and validate in the same pass; the number must use up the whole text.
+	Integer result;
+	std::from_chars_result parsed = std::from_chars(first, last, result);
+	if (parsed.ec != std::errc() || parsed.ptr != last)
+	{
+		return false;
+	}
+	value = result;
+	return true;
+}
+
+/*
+ * Parses a whole piece of text as one int in a single pass.
+ *
+ * @param text The text to parse.
+ * @param value Receives the number.
+ * @return True if the text is an int within range, false otherwise.
+ */
+bool parseInt(std::string_view text, int& value)
+{
+	return parseNumber(text, value);
+}
+
+/*
+ * Parses a whole piece of text as one unsigned 32-bit number in a single pass.
+ *
+ * @param text The text to parse.
+ * @param value Receives the number.
+ * @return True if the text is a number within range, false otherwise.
+ */
+bool parseUnsigned(std::string_view text, std::uint32_t& value)
+{
+	return parseNumber(text, value);
+}
+
+/*
+ * Removes the next whitespace-separated token from the front of a piece of text.
+ *
+ * @param text The remaining text.
+ * @param token Receives the token.
+ * @return True if a token was found, false if only whitespace was left.
+ */
+bool nextToken(std::string_view& text, std::string_view& token)
+{
+	std::size_t start = 0;
+	// Skip the spaces in front of the token.
+	while (start < text.size() && isSpace(text[start]))
+	{
+		start++;
+	}
+	if (start == text.size())
+	{
+		text = std::string_view();
+		return false;
+	}
+
+	// The token runs until the next space or the end of the text.
+	std::size_t end = start;
+	while (end < text.size() && !isSpace(text[end]))
+	{
+		end++;
+	}
+	token = text.substr(start, end - start);
+	text.remove_prefix(end);
+	return true;
+}
+
+/*
+ * Parses whitespace-separated ints into a caller-provided array.
+ *
+ * @param text The text to parse.
+ * @param values The array receiving the numbers.
+ * @param maxCount The number of values the array can hold.
+ * @return The number of ints parsed, or -1 if a token is not an int or there are too many tokens.
+ */
+int parseInts(std::string_view text, int* values, int maxCount)
+{
+	int count = 0;
+	std::string_view token;
+	while (nextToken(text, token))
+	{
+		// Reject extra tokens and anything that is not an int.
+		if (count == maxCount || !parseInt(token, values[count]))
+		{
+			return -1;
+		}
+		count++;
+	}
+	return count;
+}
@@ -0,0 +1,49 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef INPUTPARSER_H
+#define INPUTPARSER_H
+
+// Includes the cstdint library for the std::uint32_t type.
+#include <cstdint>
+// Includes the string_view library to look at parts of the input without copying them.
+#include <string_view>
+
+/*
+ * Parses a whole piece of text as one int in a single pass, without allocating.
+ * Leading spaces and a leading '+' are accepted; anything after the digits is not.
+ *
+ * @param text The text to parse.
+ * @param value Receives the number. It is left unchanged if the text is not a valid int.
+ * @return True if the text is an int within range, false otherwise.
+ */
+bool parseInt(std::string_view text, int& value);
+
+/*
+ * Parses a whole piece of text as one unsigned 32-bit number, with the same rules as parseInt but no sign other than '+'.
+ *
+ * @param text The text to parse.
+ * @param value Receives the number. It is left unchanged if the text is not a valid number.
+ * @return True if the text is a number within range, false otherwise.
+ */
+bool parseUnsigned(std::string_view text, std::uint32_t& value);
+
+/*
+ * Removes the next whitespace-separated token from the front of a piece of text.
+ *
+ * @param text The remaining text. On success it is advanced past the token.
+ * @param token Receives the token, which points into the same memory as the text.
+ * @return True if a token was found, false if only whitespace was left.
+ */
+bool nextToken(std::string_view& text, std::string_view& token);
+
+/*
+ * Parses whitespace-separated ints into a caller-provided array, such as "x y z x y z x y z" for a triangle.
+ *
+ * @param text The text to parse.
+ * @param values The array receiving the numbers.
+ * @param maxCount The number of values the array can hold.
+ * @return The number of ints parsed, or -1 if a token is not an int or there are more than maxCount tokens.
+ */
+int parseInts(std::string_view text, int* values, int maxCount);
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -2,6 +2,8 @@
 #include "Array.h"
 // Includes the Driver.h header file for the driver class and menu-related functions.
 #include "Driver.h"
+// Includes the InputParser.h header file to validate and convert integer input in one pass.
+#include "InputParser.h"
 
 
 // Includes the input/output stream library for console IO operations.
@@ -10,13 +12,74 @@
 #include <string>
 // Includes the C standard library to work with system-specific functions.
 #include <cstdlib>
+// Includes the file stream library to read batch scripts from files.
+#include <fstream>
 
 
  // The main function where the program starts executing.
-int main()
+ // Running "A1 --batch [script]" runs a command script, or standard input, instead of the interactive menus.
+ // Adding "--session path" restores the scene saved in path.snap and path.wal, and saves every change back to them.
+ // Adding "--flush-each" makes batch mode hand every logged change to the operating system before the next command.
+int main(int argc, char* argv[])
 {
 	// Create an instance of the Driver class to handle the user menu and triangle operations.
 	Driver driver;
+
+	// Read the options: "--session path" keeps the scene in path.snap and path.wal across runs,
+	// "--batch [script]" runs a script instead of the menus, and "--flush-each" flushes the log after every batch command.
+	bool batch = false;
+	bool flushEachCommand = false;
+	const char* scriptPath = nullptr;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string option(argv[i]);
+		if (option == "--session" && i + 1 < argc)
+		{
+			// Restore the saved scene before anything else runs.
+			if (!driver.openSession(argv[++i]))
+			{
+				return 1;
+			}
+		}
+		else if (option == "--batch")
+		{
+			batch = true;
+			// The script file is optional, so only take the next argument if it is not an option.
+			if (i + 1 < argc && argv[i + 1][0] != '-')
+			{
+				scriptPath = argv[++i];
+			}
+		}
+		else if (option == "--flush-each")
+		{
+			flushEachCommand = true;
+		}
+		else
+		{
+			std::cerr << "Usage: " << argv[0] << " [--session path] [--batch [script]] [--flush-each]\n";
+			return 1;
+		}
+	}
+
+	// Run in batch mode if requested, without any prompts.
+	if (batch)
+	{
+		// Batch mode never mixes C and C++ output, so the streams do not need to be synchronized.
+		std::ios::sync_with_stdio(false);
+
+		// Read the script from standard input unless a file is given.
+		if (scriptPath == nullptr)
+		{
+			return driver.runBatch(std::cin, std::cout, flushEachCommand) == 0 ? 0 : 1;
+		}
+		std::ifstream script(scriptPath);
+		if (!script)
+		{
+			std::cerr << "Could not open the script " << scriptPath << "\n";
+			return 1;
+		}
+		return driver.runBatch(script, std::cout, flushEachCommand) == 0 ? 0 : 1;
+	}
 	// Declare a variable to capture the user's choice for creating another array.
 	char choice;
 
@@ -44,11 +107,9 @@ int main()
 			// Read the user input for the size of the array.
 			std::getline(std::cin, input);
 
-			// Check if the input is a valid integer.
-			if (driver.isValidInputInt(input))
+			// Validate and convert the input in a single pass, storing the result in the size variable.
+			if (parseInt(input, size))
 			{
-				// Convert the string input to an integer and store it in the size variable.
-				size = std::stoi(input);
 				// If the size is a positive integer, proceed to validate the size.
 				if (size <= 0)
 				{
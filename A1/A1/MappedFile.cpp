@@ -0,0 +1,170 @@
+// Includes the MappedFile.h header file for function declarations.
+#include "MappedFile.h"
+
+// Includes the operating system's file mapping functions.
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Default constructor for the MappedFile class.
+ * Creates an object that does not map any file yet.
+ */
+#ifdef _WIN32
+MappedFile::MappedFile() : bytes(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+#else
+MappedFile::MappedFile() : bytes(nullptr), length(0)
+#endif
+{
+	// Constructor body is empty since no file is open yet.
+}
+
+/*
+ * Destructor for the MappedFile class.
+ * It unmaps the file if one is open.
+ */
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+/*
+ * Opens a file and maps all of it into memory.
+ *
+ * @param path The path of the file to map.
+ * @return True if the file was mapped, false if it could not be opened or mapped.
+ */
+bool MappedFile::open(const char* path)
+{
+	// Release the previous file first.
+	close();
+
+#ifdef _WIN32
+	// Open the file for reading, hinting that it will be read front to back.
+	fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	// Read the size of the file.
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		close();
+		return false;
+	}
+	length = static_cast<std::size_t>(fileSize.QuadPart);
+
+	// An empty file cannot be mapped, but it is still a valid file.
+	if (length == 0)
+	{
+		return true;
+	}
+
+	// Map the whole file read-only.
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr)
+	{
+		close();
+		return false;
+	}
+	bytes = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (bytes == nullptr)
+	{
+		close();
+		return false;
+	}
+#else
+	// Open the file for reading.
+	int descriptor = ::open(path, O_RDONLY);
+	if (descriptor < 0)
+	{
+		return false;
+	}
+
+	// Read the size of the file, refusing anything that is not a regular file.
+	struct stat status;
+	if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode))
+	{
+		::close(descriptor);
+		return false;
+	}
+	length = static_cast<std::size_t>(status.st_size);
+
+	// Map the whole file read-only; an empty file cannot be mapped but is still valid.
+	if (length > 0)
+	{
+		void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if (address == MAP_FAILED)
+		{
+			::close(descriptor);
+			length = 0;
+			return false;
+		}
+		bytes = static_cast<const unsigned char*>(address);
+		// The file is read front to back, so ask the kernel to read ahead aggressively.
+		madvise(address, length, MADV_SEQUENTIAL);
+	}
+
+	// The mapping stays valid after the descriptor is closed.
+	::close(descriptor);
+#endif
+	return true;
+}
+
+/*
+ * Unmaps the file and closes it. Does nothing if no file is open.
+ */
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (bytes != nullptr)
+	{
+		UnmapViewOfFile(bytes);
+	}
+	if (mappingHandle != nullptr)
+	{
+		CloseHandle(mappingHandle);
+		mappingHandle = nullptr;
+	}
+	if (fileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(fileHandle);
+		fileHandle = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (bytes != nullptr)
+	{
+		munmap(const_cast<unsigned char*>(bytes), length);
+	}
+#endif
+	bytes = nullptr;
+	length = 0;
+}
+
+/*
+ * Returns the mapped bytes of the file.
+ *
+ * @return A pointer to the first byte, or nullptr if no file is mapped or the file is empty.
+ */
+const unsigned char* MappedFile::data() const
+{
+	return bytes;
+}
+
+/*
+ * Returns the size of the mapped file.
+ *
+ * @return The number of bytes in the file.
+ */
+std::size_t MappedFile::size() const
+{
+	return length;
+}
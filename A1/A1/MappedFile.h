@@ -0,0 +1,73 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+
+/*
+ * Defines a MappedFile class that maps a whole file read-only into memory.
+ * The operating system pages the file in on demand, so multi-gigabyte files can be read
+ * without copying them into a buffer first. It uses mmap on Unix and file mappings on Windows.
+ */
+class MappedFile
+{
+private:
+	// Address of the first byte of the mapped file, or nullptr if nothing is mapped.
+	const unsigned char* bytes;
+	// Size of the mapped file in bytes.
+	std::size_t length;
+#ifdef _WIN32
+	// Windows handles of the open file and of its mapping object.
+	void* fileHandle;
+	void* mappingHandle;
+#endif
+
+public:
+	/*
+	 * Default constructor for the MappedFile class.
+	 * Creates an object that does not map any file yet.
+	 */
+	MappedFile();
+
+	/*
+	 * Destructor for the MappedFile class.
+	 * It unmaps the file if one is open.
+	 */
+	~MappedFile();
+
+	// The mapping is owned by exactly one object, so it cannot be copied.
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/*
+	 * Opens a file and maps all of it into memory, closing any file mapped before.
+	 * An empty file opens successfully with a size of 0 and no data.
+	 *
+	 * @param path The path of the file to map.
+	 * @return True if the file was mapped, false if it could not be opened or mapped.
+	 */
+	bool open(const char* path);
+
+	/*
+	 * Unmaps the file and closes it. Does nothing if no file is open.
+	 */
+	void close();
+
+	/*
+	 * Returns the mapped bytes of the file.
+	 *
+	 * @return A pointer to the first byte, or nullptr if no file is mapped or the file is empty.
+	 */
+	const unsigned char* data() const;
+
+	/*
+	 * Returns the size of the mapped file.
+	 *
+	 * @return The number of bytes in the file.
+	 */
+	std::size_t size() const;
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -0,0 +1,994 @@
+// Includes the MeshBvh.h header file for function declarations.
+#include "MeshBvh.h"
+
+// Includes the algorithm library for std::partition and std::nth_element.
+#include <algorithm>
+// Includes the cmath library for std::nextafter when rounding boxes outward.
+#include <cmath>
+// Includes the limits library for the infinities of empty boxes.
+#include <limits>
+
+// Number of bins per axis when evaluating the surface area heuristic.
+static const int BIN_COUNT = 16;
+// Nodes with more triangles than this are always split, even when the heuristic prefers a leaf.
+static const std::uint32_t MAX_LEAF_SIZE = 8;
+// Cost of visiting a node, relative to the cost of testing one triangle.
+static const double TRAVERSAL_COST = 1.0;
+// Below this depth, nodes are split at the median instead, so the tree can never get deeper than MeshBvh::MAX_DEPTH.
+static const int MEDIAN_SPLIT_DEPTH = MeshBvh::MAX_DEPTH - 32;
+// Nodes with at least this many triangles are scanned in parallel chunks of this size.
+static const std::size_t BUILD_CHUNK = 16384;
+
+/*
+ * An axis-aligned box in floats, used while building the tree.
+ */
+struct BuildBox
+{
+	float min[3];
+	float max[3];
+};
+
+/*
+ * Returns a box that contains nothing, so growing it by any box gives that box.
+ *
+ * @return The empty box.
+ */
+static BuildBox emptyBox()
+{
+	const float infinity = std::numeric_limits<float>::infinity();
+	return BuildBox{ { infinity, infinity, infinity }, { -infinity, -infinity, -infinity } };
+}
+
+/*
+ * Grows a box to contain another box.
+ *
+ * @param box The box to grow.
+ * @param other The box to include.
+ */
+static void growBox(BuildBox& box, const BuildBox& other)
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		box.min[axis] = other.min[axis] < box.min[axis] ? other.min[axis] : box.min[axis];
+		box.max[axis] = other.max[axis] > box.max[axis] ? other.max[axis] : box.max[axis];
+	}
+}
+
+/*
+ * Grows a box to contain the centre of another box.
+ *
+ * @param box The box to grow.
+ * @param other The box whose centre to include.
+ */
+static void growByCentre(BuildBox& box, const BuildBox& other)
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float centre = (other.min[axis] + other.max[axis]) * 0.5f;
+		box.min[axis] = centre < box.min[axis] ? centre : box.min[axis];
+		box.max[axis] = centre > box.max[axis] ? centre : box.max[axis];
+	}
+}
+
+/*
+ * Calculates the surface area of a box, which is proportional to the chance that a random ray hits it.
+ *
+ * @param box The box to measure. It must not be empty.
+ * @return The surface area.
+ */
+static double boxArea(const BuildBox& box)
+{
+	double dx = static_cast<double>(box.max[0]) - box.min[0];
+	double dy = static_cast<double>(box.max[1]) - box.min[1];
+	double dz = static_cast<double>(box.max[2]) - box.min[2];
+	return 2.0 * (dx * dy + dy * dz + dz * dx);
+}
+
+/*
+ * Converts a coordinate to the largest float not above it, so a box built from it never shrinks.
+ *
+ * @param value The coordinate.
+ * @return The coordinate rounded down to a float.
+ */
+static float roundDown(double value)
+{
+	float rounded = static_cast<float>(value);
+	return rounded > value ? std::nextafter(rounded, -std::numeric_limits<float>::infinity()) : rounded;
+}
+
+/*
+ * Converts a coordinate to the smallest float not below it.
+ *
+ * @param value The coordinate.
+ * @return The coordinate rounded up to a float.
+ */
+static float roundUp(double value)
+{
+	float rounded = static_cast<float>(value);
+	return rounded < value ? std::nextafter(rounded, std::numeric_limits<float>::infinity()) : rounded;
+}
+
+/*
+ * Calculates the bin of a triangle along one axis from the centre of its box.
+ * Binning and partitioning both call this, so they always agree on which side a triangle goes.
+ *
+ * @param box The box of the triangle.
+ * @param axis The axis to bin along.
+ * @param origin The smallest centre coordinate along the axis.
+ * @param scale The number of bins per unit along the axis.
+ * @return The bin, from 0 to BIN_COUNT - 1.
+ */
+static int binOf(const BuildBox& box, int axis, float origin, float scale)
+{
+	float centre = (box.min[axis] + box.max[axis]) * 0.5f;
+	int bin = static_cast<int>((centre - origin) * scale);
+	return bin < 0 ? 0 : bin >= BIN_COUNT ? BIN_COUNT - 1 : bin;
+}
+
+/*
+ * A triangle and its box. The builder reorders these directly, so its scans read memory in order.
+ */
+struct BuildReference
+{
+	BuildBox box;
+	std::uint32_t triangle;
+};
+
+/*
+ * The triangles and boxes collected in one bin.
+ */
+struct Bin
+{
+	BuildBox box;
+	std::uint32_t count;
+};
+
+/*
+ * Runs function(first, last) over a range of triangle positions: in parallel chunks for large ranges,
+ * on the calling thread for small ones. Each chunk gets its own index, so results can be combined in order.
+ *
+ * @param pool The thread pool.
+ * @param begin The first position.
+ * @param end One past the last position.
+ * @param function The function to run for each chunk; it receives the chunk index and its range.
+ * @return The number of chunks.
+ */
+template <typename Function>
+static std::size_t forEachChunk(ThreadPool& pool, std::size_t begin, std::size_t end, const Function& function)
+{
+	pool.parallelForChunks(end - begin, BUILD_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+	{
+		function(chunk, begin + first, begin + last);
+	});
+	return ThreadPool::getChunkCount(end - begin, BUILD_CHUNK);
+}
+
+/*
+ * Default constructor for the MeshBvh class.
+ * Starts without a mesh and without nodes.
+ */
+MeshBvh::MeshBvh() : mesh(nullptr), depth(0)
+{
+	// Constructor body is empty since initialization is done in the initialization list.
+}
+
+/*
+ * Reads the effective coordinates of the three vertices of a triangle, including the mesh's pending offset.
+ *
+ * @param triangle The index of the triangle.
+ * @param coordinates Receives the x, y, and z coordinates of the three vertices, in that order.
+ */
+void MeshBvh::getTriangleCoordinates(std::uint32_t triangle, double coordinates[9]) const
+{
+	const PointBuffer& vertices = mesh->getVertices();
+	const std::uint32_t* indices = mesh->getIndices() + static_cast<std::size_t>(triangle) * 3;
+	int offset[3];
+	mesh->getPendingOffset(offset[0], offset[1], offset[2]);
+	for (int i = 0; i < 3; i++)
+	{
+		// Add in double, which holds the sum of two ints exactly.
+		coordinates[i * 3] = static_cast<double>(vertices.getCoordinateX(indices[i])) + offset[0];
+		coordinates[i * 3 + 1] = static_cast<double>(vertices.getCoordinateY(indices[i])) + offset[1];
+		coordinates[i * 3 + 2] = static_cast<double>(vertices.getCoordinateZ(indices[i])) + offset[2];
+	}
+}
+
+/*
+ * Builds the hierarchy over every triangle of a mesh with the binned surface area heuristic.
+ *
+ * @param target The mesh to build over.
+ * @param pool The thread pool that bins the triangles of large nodes.
+ */
+void MeshBvh::build(const TriangleMesh& target, ThreadPool& pool)
+{
+	clear();
+	mesh = &target;
+	std::size_t triangleCount = target.getTriangleCount();
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	// Compute the box of every triangle once, in parallel; the builder only looks at these boxes.
+	std::vector<BuildReference> references(triangleCount);
+	forEachChunk(pool, 0, triangleCount, [&](std::size_t, std::size_t first, std::size_t last)
+	{
+		double coordinates[9];
+		for (std::size_t i = first; i < last; i++)
+		{
+			getTriangleCoordinates(static_cast<std::uint32_t>(i), coordinates);
+			for (int axis = 0; axis < 3; axis++)
+			{
+				double low = std::min(coordinates[axis], std::min(coordinates[3 + axis], coordinates[6 + axis]));
+				double high = std::max(coordinates[axis], std::max(coordinates[3 + axis], coordinates[6 + axis]));
+				references[i].box.min[axis] = roundDown(low);
+				references[i].box.max[axis] = roundUp(high);
+			}
+			references[i].triangle = static_cast<std::uint32_t>(i);
+		}
+	});
+
+	// A binary tree over n leaves has fewer than 2n nodes.
+	nodes.reserve(2 * triangleCount);
+	nodes.push_back(BvhNode{ 0.0f, 0.0f, 0.0f, 0, 0.0f, 0.0f, 0.0f, static_cast<std::uint32_t>(triangleCount) });
+
+	// Nodes waiting to be split, with their depth; the root is at depth 1.
+	struct PendingNode
+	{
+		std::uint32_t node;
+		int depth;
+	};
+	std::vector<PendingNode> pending;
+	pending.push_back(PendingNode{ 0, 1 });
+
+	// Per-chunk results of the scans below, reused for every node.
+	std::vector<BuildBox> chunkBoxes;
+	std::vector<BuildBox> chunkCentres;
+	std::vector<Bin> chunkBins;
+
+	while (!pending.empty())
+	{
+		PendingNode current = pending.back();
+		pending.pop_back();
+		depth = current.depth > depth ? current.depth : depth;
+		std::size_t begin = nodes[current.node].first;
+		std::size_t count = nodes[current.node].count;
+		std::size_t end = begin + count;
+
+		// Find the box of the node and the box of its triangle centres, in chunks combined in order.
+		std::size_t chunkCount = ThreadPool::getChunkCount(count, BUILD_CHUNK);
+		chunkBoxes.assign(chunkCount, emptyBox());
+		chunkCentres.assign(chunkCount, emptyBox());
+		forEachChunk(pool, begin, end, [&](std::size_t chunk, std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; i++)
+			{
+				growBox(chunkBoxes[chunk], references[i].box);
+				growByCentre(chunkCentres[chunk], references[i].box);
+			}
+		});
+		BuildBox nodeBox = emptyBox();
+		BuildBox centres = emptyBox();
+		for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+		{
+			growBox(nodeBox, chunkBoxes[chunk]);
+			growBox(centres, chunkCentres[chunk]);
+		}
+		BvhNode& node = nodes[current.node];
+		node.minX = nodeBox.min[0];
+		node.minY = nodeBox.min[1];
+		node.minZ = nodeBox.min[2];
+		node.maxX = nodeBox.max[0];
+		node.maxY = nodeBox.max[1];
+		node.maxZ = nodeBox.max[2];
+
+		// A single triangle is always a leaf.
+		if (count == 1)
+		{
+			continue;
+		}
+
+		// The widest axis of the centres; if every centre is the same point, the triangles cannot be told apart.
+		int widestAxis = 0;
+		for (int axis = 1; axis < 3; axis++)
+		{
+			if (centres.max[axis] - centres.min[axis] > centres.max[widestAxis] - centres.min[widestAxis])
+			{
+				widestAxis = axis;
+			}
+		}
+		bool separable = centres.max[widestAxis] > centres.min[widestAxis];
+
+		// Number of triangles that go to the left child, or 0 to make the node a leaf.
+		std::size_t leftCount = 0;
+		if (!separable || current.depth >= MEDIAN_SPLIT_DEPTH)
+		{
+			// Deep or inseparable nodes are split in half, which bounds the depth of the tree.
+			if (count > MAX_LEAF_SIZE)
+			{
+				leftCount = count / 2;
+				if (separable)
+				{
+					std::nth_element(references.begin() + begin, references.begin() + begin + leftCount, references.begin() + end,
+						[&](const BuildReference& a, const BuildReference& b)
+						{
+							return a.box.min[widestAxis] + a.box.max[widestAxis] < b.box.min[widestAxis] + b.box.max[widestAxis];
+						});
+				}
+			}
+		}
+		else
+		{
+			// Sort the triangles into bins along every axis where the centres are spread out.
+			float scale[3];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				float extent = centres.max[axis] - centres.min[axis];
+				scale[axis] = extent > 0.0f ? BIN_COUNT / extent : 0.0f;
+			}
+			auto binRange = [&](Bin* bins, std::size_t first, std::size_t last)
+			{
+				for (std::size_t i = first; i < last; i++)
+				{
+					const BuildBox& box = references[i].box;
+					for (int axis = 0; axis < 3; axis++)
+					{
+						Bin& bin = bins[axis * BIN_COUNT + binOf(box, axis, centres.min[axis], scale[axis])];
+						growBox(bin.box, box);
+						bin.count++;
+					}
+				}
+			};
+			Bin bins[3][BIN_COUNT];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				for (int b = 0; b < BIN_COUNT; b++)
+				{
+					bins[axis][b] = Bin{ emptyBox(), 0 };
+				}
+			}
+			if (chunkCount == 1)
+			{
+				binRange(&bins[0][0], begin, end);
+			}
+			else
+			{
+				// Large nodes are binned in parallel chunks, whose bins are then added up in chunk order.
+				chunkBins.assign(chunkCount * 3 * BIN_COUNT, Bin{ emptyBox(), 0 });
+				forEachChunk(pool, begin, end, [&](std::size_t chunk, std::size_t first, std::size_t last)
+				{
+					binRange(&chunkBins[chunk * 3 * BIN_COUNT], first, last);
+				});
+				for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+				{
+					for (int b = 0; b < 3 * BIN_COUNT; b++)
+					{
+						const Bin& partial = chunkBins[chunk * 3 * BIN_COUNT + b];
+						growBox(bins[b / BIN_COUNT][b % BIN_COUNT].box, partial.box);
+						bins[b / BIN_COUNT][b % BIN_COUNT].count += partial.count;
+					}
+				}
+			}
+
+			// Evaluate every split between two bins: the cost of a child is its area times its triangle count.
+			double bestCost = std::numeric_limits<double>::infinity();
+			int bestAxis = -1;
+			int bestSplit = 0;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if (scale[axis] == 0.0f)
+				{
+					continue;
+				}
+
+				// Sweep from the right to get the cost of every right side, then from the left to combine them.
+				double rightCosts[BIN_COUNT];
+				BuildBox rightBox = emptyBox();
+				std::uint32_t rightCount = 0;
+				for (int b = BIN_COUNT - 1; b > 0; b--)
+				{
+					// An empty bin changes nothing, which saves most of the work in small nodes.
+					if (bins[axis][b].count == 0)
+					{
+						rightCosts[b] = b + 1 < BIN_COUNT ? rightCosts[b + 1] : 0.0;
+						continue;
+					}
+					growBox(rightBox, bins[axis][b].box);
+					rightCount += bins[axis][b].count;
+					rightCosts[b] = boxArea(rightBox) * rightCount;
+				}
+				BuildBox leftBox = emptyBox();
+				std::uint32_t leftSideCount = 0;
+				for (int split = 1; split < BIN_COUNT; split++)
+				{
+					// Splitting after an empty bin gives the same children as splitting before it.
+					if (bins[axis][split - 1].count == 0)
+					{
+						continue;
+					}
+					growBox(leftBox, bins[axis][split - 1].box);
+					leftSideCount += bins[axis][split - 1].count;
+					if (leftSideCount == 0 || leftSideCount == count)
+					{
+						continue;
+					}
+					double cost = boxArea(leftBox) * leftSideCount + rightCosts[split];
+					if (cost < bestCost)
+					{
+						bestCost = cost;
+						bestAxis = axis;
+						bestSplit = split;
+					}
+				}
+			}
+
+			// Split if that is cheaper than testing every triangle of the node, or if the node is too big for a leaf.
+			double nodeArea = boxArea(nodeBox);
+			if (bestAxis >= 0 && (TRAVERSAL_COST * nodeArea + bestCost < count * nodeArea || count > MAX_LEAF_SIZE))
+			{
+				std::vector<BuildReference>::iterator middle = std::partition(references.begin() + begin, references.begin() + end,
+					[&](const BuildReference& reference)
+					{
+						return binOf(reference.box, bestAxis, centres.min[bestAxis], scale[bestAxis]) < bestSplit;
+					});
+				leftCount = static_cast<std::size_t>(middle - (references.begin() + begin));
+			}
+			else if (count > MAX_LEAF_SIZE)
+			{
+				leftCount = count / 2;
+			}
+		}
+
+		// Make the node an inner node with two adjacent children, which are split in turn.
+		if (leftCount == 0)
+		{
+			continue;
+		}
+		std::uint32_t left = static_cast<std::uint32_t>(nodes.size());
+		nodes[current.node].first = left;
+		nodes[current.node].count = 0;
+		nodes.push_back(BvhNode{ 0.0f, 0.0f, 0.0f, static_cast<std::uint32_t>(begin), 0.0f, 0.0f, 0.0f, static_cast<std::uint32_t>(leftCount) });
+		nodes.push_back(BvhNode{ 0.0f, 0.0f, 0.0f, static_cast<std::uint32_t>(begin + leftCount), 0.0f, 0.0f, 0.0f, static_cast<std::uint32_t>(count - leftCount) });
+		pending.push_back(PendingNode{ left + 1, current.depth + 1 });
+		pending.push_back(PendingNode{ left, current.depth + 1 });
+	}
+
+	// Give back the room reserved for nodes that were never needed, and keep only the triangle order of the leaves.
+	nodes.shrink_to_fit();
+	triangleOrder.resize(triangleCount);
+	for (std::size_t i = 0; i < triangleCount; i++)
+	{
+		triangleOrder[i] = references[i].triangle;
+	}
+}
+
+/*
+ * Builds the hierarchy over every triangle of a mesh on the program's shared thread pool.
+ *
+ * @param target The mesh to build over.
+ */
+void MeshBvh::build(const TriangleMesh& target)
+{
+	build(target, ThreadPool::getShared());
+}
+
+/*
+ * Removes every node, leaving an empty hierarchy.
+ */
+void MeshBvh::clear()
+{
+	nodes.clear();
+	triangleOrder.clear();
+	depth = 0;
+}
+
+/*
+ * Returns the number of nodes in the hierarchy.
+ *
+ * @return The number of nodes.
+ */
+std::size_t MeshBvh::getNodeCount() const
+{
+	return nodes.size();
+}
+
+/*
+ * Returns the number of levels in the hierarchy.
+ *
+ * @return The depth of the tree, 0 if it is empty.
+ */
+int MeshBvh::getDepth() const
+{
+	return depth;
+}
+
+/*
+ * Read-only access to the nodes, root first.
+ *
+ * @return A pointer to the first node, or nullptr if the hierarchy is empty.
+ */
+const BvhNode* MeshBvh::getNodes() const
+{
+	return nodes.empty() ? nullptr : nodes.data();
+}
+
+/*
+ * Read-only access to the triangle order the leaves refer to.
+ *
+ * @return A pointer to the first triangle index, or nullptr if the hierarchy is empty.
+ */
+const std::uint32_t* MeshBvh::getTriangleOrder() const
+{
+	return triangleOrder.empty() ? nullptr : triangleOrder.data();
+}
+
+/*
+ * Returns the mesh the hierarchy was built over.
+ *
+ * @return A pointer to the mesh, or nullptr before the first build.
+ */
+const TriangleMesh* MeshBvh::getMesh() const
+{
+	return mesh;
+}
+
+/*
+ * Clips a ray against the box of a node.
+ *
+ * @param node The node.
+ * @param origin The start of the ray.
+ * @param inverse The inverse of each direction component, or 0 where the component is 0.
+ * @param direction The direction of the ray.
+ * @param maxDistance The end of the part of the ray still of interest.
+ * @param entry Receives the distance at which the ray enters the box.
+ * @return True if the ray passes through the box between 0 and maxDistance.
+ */
+static bool intersectBox(const BvhNode& node, const double origin[3], const double inverse[3], const double direction[3], double maxDistance, double& entry)
+{
+	const float low[3] = { node.minX, node.minY, node.minZ };
+	const float high[3] = { node.maxX, node.maxY, node.maxZ };
+	double entering = 0.0;
+	double leaving = maxDistance;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		// A ray parallel to a slab either always or never lies inside it.
+		if (direction[axis] == 0.0)
+		{
+			if (origin[axis] < low[axis] || origin[axis] > high[axis])
+			{
+				return false;
+			}
+			continue;
+		}
+		double t0 = (low[axis] - origin[axis]) * inverse[axis];
+		double t1 = (high[axis] - origin[axis]) * inverse[axis];
+		if (t0 > t1)
+		{
+			std::swap(t0, t1);
+		}
+		entering = t0 > entering ? t0 : entering;
+		leaving = t1 < leaving ? t1 : leaving;
+		if (entering > leaving)
+		{
+			return false;
+		}
+	}
+	entry = entering;
+	return true;
+}
+
+/*
+ * Intersects a ray with a triangle using the Moller-Trumbore test.
+ *
+ * @param coordinates The x, y, and z coordinates of the three vertices.
+ * @param origin The start of the ray.
+ * @param direction The direction of the ray.
+ * @param maxDistance The farthest distance of interest.
+ * @param distance Receives the distance of the hit.
+ * @param u Receives the weight of the second vertex at the hit.
+ * @param v Receives the weight of the third vertex at the hit.
+ * @return True if the ray hits the triangle between 0 and maxDistance.
+ */
+static bool intersectTriangle(const double coordinates[9], const double origin[3], const double direction[3], double maxDistance,
+	double& distance, double& u, double& v)
+{
+	double edge1[3], edge2[3], toOrigin[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		edge1[axis] = coordinates[3 + axis] - coordinates[axis];
+		edge2[axis] = coordinates[6 + axis] - coordinates[axis];
+		toOrigin[axis] = origin[axis] - coordinates[axis];
+	}
+
+	// A ray in the plane of the triangle, or a degenerate triangle, gives no hit.
+	double p[3] = { direction[1] * edge2[2] - direction[2] * edge2[1], direction[2] * edge2[0] - direction[0] * edge2[2], direction[0] * edge2[1] - direction[1] * edge2[0] };
+	double determinant = edge1[0] * p[0] + edge1[1] * p[1] + edge1[2] * p[2];
+	if (determinant == 0.0)
+	{
+		return false;
+	}
+	double inverse = 1.0 / determinant;
+
+	// The hit must lie inside the triangle: both weights and their sum between 0 and 1.
+	u = (toOrigin[0] * p[0] + toOrigin[1] * p[1] + toOrigin[2] * p[2]) * inverse;
+	if (u < 0.0 || u > 1.0)
+	{
+		return false;
+	}
+	double q[3] = { toOrigin[1] * edge1[2] - toOrigin[2] * edge1[1], toOrigin[2] * edge1[0] - toOrigin[0] * edge1[2], toOrigin[0] * edge1[1] - toOrigin[1] * edge1[0] };
+	v = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * inverse;
+	if (v < 0.0 || u + v > 1.0)
+	{
+		return false;
+	}
+	distance = (edge2[0] * q[0] + edge2[1] * q[1] + edge2[2] * q[2]) * inverse;
+	return distance >= 0.0 && distance <= maxDistance;
+}
+
+/*
+ * Finds the nearest triangle hit by a ray, visiting the nearer child of each node first.
+ *
+ * @param origin The x, y, and z coordinates of the start of the ray.
+ * @param direction The x, y, and z components of the direction of the ray.
+ * @param maxDistance The farthest distance along the ray to search.
+ * @param hit Receives the nearest hit.
+ * @return True if the ray hits a triangle within maxDistance, false otherwise.
+ */
+bool MeshBvh::intersectRay(const double origin[3], const double direction[3], double maxDistance, RayHit& hit) const
+{
+	if (nodes.empty())
+	{
+		return false;
+	}
+	double inverse[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		inverse[axis] = direction[axis] != 0.0 ? 1.0 / direction[axis] : 0.0;
+	}
+
+	// The nearest hit so far shortens the ray, so farther boxes are skipped.
+	bool found = false;
+	double nearest = maxDistance;
+	double entry;
+	if (!intersectBox(nodes[0], origin, inverse, direction, nearest, entry))
+	{
+		return false;
+	}
+
+	// The tree is at most MAX_DEPTH levels deep, so the stack cannot overflow.
+	std::uint32_t stack[MAX_DEPTH];
+	int stackSize = 0;
+	std::uint32_t current = 0;
+	double coordinates[9];
+	while (true)
+	{
+		const BvhNode& node = nodes[current];
+		if (node.count > 0)
+		{
+			// Test every triangle of the leaf.
+			for (std::uint32_t i = node.first; i < node.first + node.count; i++)
+			{
+				double distance, u, v;
+				getTriangleCoordinates(triangleOrder[i], coordinates);
+				if (intersectTriangle(coordinates, origin, direction, nearest, distance, u, v))
+				{
+					found = true;
+					nearest = distance;
+					hit = RayHit{ triangleOrder[i], distance, u, v };
+				}
+			}
+		}
+		else
+		{
+			// Descend into the nearer child the ray passes through and keep the other one for later.
+			double leftEntry, rightEntry;
+			bool hitsLeft = intersectBox(nodes[node.first], origin, inverse, direction, nearest, leftEntry);
+			bool hitsRight = intersectBox(nodes[node.first + 1], origin, inverse, direction, nearest, rightEntry);
+			if (hitsLeft && hitsRight)
+			{
+				bool leftFirst = leftEntry <= rightEntry;
+				stack[stackSize++] = leftFirst ? node.first + 1 : node.first;
+				current = leftFirst ? node.first : node.first + 1;
+				continue;
+			}
+			if (hitsLeft || hitsRight)
+			{
+				current = hitsLeft ? node.first : node.first + 1;
+				continue;
+			}
+		}
+
+		// Take the next node that the ray might still hit before the nearest hit.
+		bool next = false;
+		while (stackSize > 0)
+		{
+			current = stack[--stackSize];
+			if (intersectBox(nodes[current], origin, inverse, direction, nearest, entry))
+			{
+				next = true;
+				break;
+			}
+		}
+		if (!next)
+		{
+			return found;
+		}
+	}
+}
+
+/*
+ * Checks whether a ray hits any triangle, stopping at the first one found.
+ *
+ * @param origin The x, y, and z coordinates of the start of the ray.
+ * @param direction The x, y, and z components of the direction of the ray.
+ * @param maxDistance The farthest distance along the ray to search.
+ * @return True if the ray hits a triangle within maxDistance, false otherwise.
+ */
+bool MeshBvh::intersectsAny(const double origin[3], const double direction[3], double maxDistance) const
+{
+	if (nodes.empty())
+	{
+		return false;
+	}
+	double inverse[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		inverse[axis] = direction[axis] != 0.0 ? 1.0 / direction[axis] : 0.0;
+	}
+
+	// Any hit ends the search, so the order of the children does not matter.
+	std::uint32_t stack[MAX_DEPTH + 1];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	double coordinates[9];
+	while (stackSize > 0)
+	{
+		const BvhNode& node = nodes[stack[--stackSize]];
+		double entry;
+		if (!intersectBox(node, origin, inverse, direction, maxDistance, entry))
+		{
+			continue;
+		}
+		if (node.count == 0)
+		{
+			stack[stackSize++] = node.first + 1;
+			stack[stackSize++] = node.first;
+			continue;
+		}
+		for (std::uint32_t i = node.first; i < node.first + node.count; i++)
+		{
+			double distance, u, v;
+			getTriangleCoordinates(triangleOrder[i], coordinates);
+			if (intersectTriangle(coordinates, origin, direction, maxDistance, distance, u, v))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/*
+ * Calculates the squared distance from a point to the box of a node, 0 if the point is inside.
+ *
+ * @param node The node.
+ * @param point The point.
+ * @return The squared distance.
+ */
+static double boxDistanceSquared(const BvhNode& node, const double point[3])
+{
+	const float low[3] = { node.minX, node.minY, node.minZ };
+	const float high[3] = { node.maxX, node.maxY, node.maxZ };
+	double sum = 0.0;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		double gap = point[axis] < low[axis] ? low[axis] - point[axis] : point[axis] > high[axis] ? point[axis] - high[axis] : 0.0;
+		sum += gap * gap;
+	}
+	return sum;
+}
+
+/*
+ * Finds the point of a segment nearest to a point.
+ *
+ * @param a The start of the segment.
+ * @param b The end of the segment.
+ * @param point The query point.
+ * @param result Receives the nearest point.
+ */
+static void closestOnSegment(const double a[3], const double b[3], const double point[3], double result[3])
+{
+	double direction[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+	double length = direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2];
+	double t = 0.0;
+	if (length > 0.0)
+	{
+		t = ((point[0] - a[0]) * direction[0] + (point[1] - a[1]) * direction[1] + (point[2] - a[2]) * direction[2]) / length;
+		t = t < 0.0 ? 0.0 : t > 1.0 ? 1.0 : t;
+	}
+	for (int axis = 0; axis < 3; axis++)
+	{
+		result[axis] = a[axis] + t * direction[axis];
+	}
+}
+
+/*
+ * Finds the point of a triangle nearest to a point, by working out which vertex, edge, or face region the point projects into.
+ *
+ * @param coordinates The x, y, and z coordinates of the three vertices.
+ * @param point The query point.
+ * @param result Receives the nearest point.
+ */
+static void closestOnTriangle(const double coordinates[9], const double point[3], double result[3])
+{
+	const double* a = coordinates;
+	const double* b = coordinates + 3;
+	const double* c = coordinates + 6;
+	double ab[3], ac[3], ap[3], bp[3], cp[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		ab[axis] = b[axis] - a[axis];
+		ac[axis] = c[axis] - a[axis];
+		ap[axis] = point[axis] - a[axis];
+		bp[axis] = point[axis] - b[axis];
+		cp[axis] = point[axis] - c[axis];
+	}
+	auto dot = [](const double* x, const double* y) { return x[0] * y[0] + x[1] * y[1] + x[2] * y[2]; };
+	auto set = [&](const double* origin, const double* edge, double t)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			result[axis] = origin[axis] + t * edge[axis];
+		}
+	};
+
+	// Vertex regions, then edge regions, then the face.
+	double d1 = dot(ab, ap);
+	double d2 = dot(ac, ap);
+	if (d1 <= 0.0 && d2 <= 0.0)
+	{
+		set(a, ab, 0.0);
+		return;
+	}
+	double d3 = dot(ab, bp);
+	double d4 = dot(ac, bp);
+	if (d3 >= 0.0 && d4 <= d3)
+	{
+		set(b, ab, 0.0);
+		return;
+	}
+	double d5 = dot(ab, cp);
+	double d6 = dot(ac, cp);
+	if (d6 >= 0.0 && d5 <= d6)
+	{
+		set(c, ab, 0.0);
+		return;
+	}
+	double vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 && d1 - d3 > 0.0)
+	{
+		set(a, ab, d1 / (d1 - d3));
+		return;
+	}
+	double vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 && d2 - d6 > 0.0)
+	{
+		set(a, ac, d2 / (d2 - d6));
+		return;
+	}
+	double va = d3 * d6 - d5 * d4;
+	if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0 && (d4 - d3) + (d5 - d6) > 0.0)
+	{
+		double bc[3] = { c[0] - b[0], c[1] - b[1], c[2] - b[2] };
+		set(b, bc, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+		return;
+	}
+
+	// A degenerate triangle has no face region; its nearest point lies on one of its edges.
+	double sum = va + vb + vc;
+	if (sum <= 0.0)
+	{
+		double candidate[3];
+		double best = std::numeric_limits<double>::infinity();
+		const double* ends[3][2] = { { a, b }, { b, c }, { c, a } };
+		for (int edge = 0; edge < 3; edge++)
+		{
+			closestOnSegment(ends[edge][0], ends[edge][1], point, candidate);
+			double distance = (candidate[0] - point[0]) * (candidate[0] - point[0]) + (candidate[1] - point[1]) * (candidate[1] - point[1])
+				+ (candidate[2] - point[2]) * (candidate[2] - point[2]);
+			if (distance < best)
+			{
+				best = distance;
+				result[0] = candidate[0];
+				result[1] = candidate[1];
+				result[2] = candidate[2];
+			}
+		}
+		return;
+	}
+	double v = vb / sum;
+	double w = vc / sum;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		result[axis] = a[axis] + ab[axis] * v + ac[axis] * w;
+	}
+}
+
+/*
+ * Finds the point of the mesh nearest to a query point, visiting the nearer child of each node first
+ * and skipping every box farther away than the best point found so far.
+ *
+ * @param point The x, y, and z coordinates of the query point.
+ * @param result Receives the nearest point and the triangle it lies on.
+ * @return True if the mesh has a triangle, false if the hierarchy is empty.
+ */
+bool MeshBvh::findClosestPoint(const double point[3], ClosestPoint& result) const
+{
+	if (nodes.empty())
+	{
+		return false;
+	}
+
+	double best = std::numeric_limits<double>::infinity();
+	std::uint32_t stack[MAX_DEPTH];
+	int stackSize = 0;
+	std::uint32_t current = 0;
+	double coordinates[9];
+	double candidate[3];
+	while (true)
+	{
+		const BvhNode& node = nodes[current];
+		if (node.count > 0)
+		{
+			// Measure every triangle of the leaf.
+			for (std::uint32_t i = node.first; i < node.first + node.count; i++)
+			{
+				getTriangleCoordinates(triangleOrder[i], coordinates);
+				closestOnTriangle(coordinates, point, candidate);
+				double dx = candidate[0] - point[0];
+				double dy = candidate[1] - point[1];
+				double dz = candidate[2] - point[2];
+				double distance = dx * dx + dy * dy + dz * dz;
+				if (distance < best)
+				{
+					best = distance;
+					result = ClosestPoint{ triangleOrder[i], candidate[0], candidate[1], candidate[2], distance };
+				}
+			}
+		}
+		else
+		{
+			// Descend into the nearer child and keep the other one for later, unless it is already too far.
+			double leftDistance = boxDistanceSquared(nodes[node.first], point);
+			double rightDistance = boxDistanceSquared(nodes[node.first + 1], point);
+			std::uint32_t nearChild = leftDistance <= rightDistance ? node.first : node.first + 1;
+			double nearDistance = leftDistance <= rightDistance ? leftDistance : rightDistance;
+			double farDistance = leftDistance <= rightDistance ? rightDistance : leftDistance;
+			if (nearDistance < best)
+			{
+				if (farDistance < best)
+				{
+					stack[stackSize++] = nearChild == node.first ? node.first + 1 : node.first;
+				}
+				current = nearChild;
+				continue;
+			}
+		}
+
+		// Take the next node that could still hold a nearer point.
+		bool next = false;
+		while (stackSize > 0)
+		{
+			current = stack[--stackSize];
+			if (boxDistanceSquared(nodes[current], point) < best)
+			{
+				next = true;
+				break;
+			}
+		}
+		if (!next)
+		{
+			return true;
+		}
+	}
+}
@@ -0,0 +1,186 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef MESHBVH_H
+#define MESHBVH_H
+
+// Includes the TriangleMesh.h header file to build the hierarchy over a mesh and read its triangles during queries.
+#include "TriangleMesh.h"
+// Includes the ThreadPool.h header file to spread the binning of large nodes across all cores.
+#include "ThreadPool.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the cstdint library for the fixed-width fields of a node.
+#include <cstdint>
+// Includes the vector library for the nodes and the triangle order.
+#include <vector>
+
+/*
+ * One node of a bounding volume hierarchy, packed into 32 bytes so two nodes share a cache line.
+ * The box is stored in floats rounded outward, so it always contains the exact integer coordinates.
+ * An inner node has count 0 and its children are the nodes first and first + 1.
+ * A leaf holds the count triangles listed from position first of the hierarchy's triangle order.
+ */
+struct BvhNode
+{
+	float minX, minY, minZ;
+	std::uint32_t first;
+	float maxX, maxY, maxZ;
+	std::uint32_t count;
+};
+
+/*
+ * The nearest triangle hit by a ray.
+ */
+struct RayHit
+{
+	// Index of the triangle in the mesh.
+	std::uint32_t triangle;
+	// Distance along the ray, in multiples of its direction vector.
+	double distance;
+	// Barycentric coordinates of the hit point: the weights of the second and third vertex.
+	double u;
+	double v;
+};
+
+/*
+ * The point of a mesh nearest to a query point.
+ */
+struct ClosestPoint
+{
+	// Index of the triangle the point lies on.
+	std::uint32_t triangle;
+	// Coordinates of the point.
+	double x;
+	double y;
+	double z;
+	// Squared distance from the query point.
+	double distanceSquared;
+};
+
+/*
+ * Defines a MeshBvh class, a bounding volume hierarchy over the triangles of a TriangleMesh.
+ * It is built top-down with the surface area heuristic evaluated over 16 bins per axis, and answers
+ * ray, any-hit, and closest-point queries by walking the tree with a small fixed stack, visiting only
+ * the nodes whose boxes can contain an answer instead of testing every triangle.
+ * The hierarchy keeps a pointer to the mesh: the mesh must outlive it, and it must be rebuilt when the
+ * mesh's triangles change. Translations that are still pending in the mesh are taken into account.
+ */
+class MeshBvh
+{
+private:
+	// The mesh the hierarchy was built over, or nullptr before the first build.
+	const TriangleMesh* mesh;
+	// The nodes, root first; the two children of a node are always next to each other.
+	std::vector<BvhNode> nodes;
+	// Triangle indices in the order the leaves refer to them.
+	std::vector<std::uint32_t> triangleOrder;
+	// Number of levels in the tree, 0 when it is empty.
+	int depth;
+
+	/*
+	 * Reads the effective coordinates of the three vertices of a triangle.
+	 *
+	 * @param triangle The index of the triangle.
+	 * @param coordinates Receives the x, y, and z coordinates of the three vertices, in that order.
+	 */
+	void getTriangleCoordinates(std::uint32_t triangle, double coordinates[9]) const;
+
+public:
+	// Deepest tree the builder produces, which is also the size of the traversal stack.
+	static const int MAX_DEPTH = 64;
+
+	/*
+	 * Default constructor for the MeshBvh class.
+	 * Creates an empty hierarchy that finds nothing until build() is called.
+	 */
+	MeshBvh();
+
+	/*
+	 * Builds the hierarchy over every triangle of a mesh, replacing the previous one.
+	 *
+	 * @param mesh The mesh to build over. It must stay alive and unchanged while the hierarchy is used.
+	 * @param pool The thread pool that bins the triangles of large nodes.
+	 */
+	void build(const TriangleMesh& mesh, ThreadPool& pool);
+
+	/*
+	 * Builds the hierarchy over every triangle of a mesh on the program's shared thread pool.
+	 *
+	 * @param mesh The mesh to build over. It must stay alive and unchanged while the hierarchy is used.
+	 */
+	void build(const TriangleMesh& mesh);
+
+	/*
+	 * Removes every node, leaving an empty hierarchy.
+	 */
+	void clear();
+
+	/*
+	 * Returns the number of nodes in the hierarchy.
+	 *
+	 * @return The number of nodes.
+	 */
+	std::size_t getNodeCount() const;
+
+	/*
+	 * Returns the number of levels in the hierarchy.
+	 *
+	 * @return The depth of the tree, 0 if it is empty.
+	 */
+	int getDepth() const;
+
+	/*
+	 * Read-only access to the nodes, root first.
+	 *
+	 * @return A pointer to the first node, or nullptr if the hierarchy is empty.
+	 */
+	const BvhNode* getNodes() const;
+
+	/*
+	 * Read-only access to the triangle order: a leaf holds the triangles listed at positions first to first + count - 1.
+	 *
+	 * @return A pointer to the first triangle index, or nullptr if the hierarchy is empty.
+	 */
+	const std::uint32_t* getTriangleOrder() const;
+
+	/*
+	 * Returns the mesh the hierarchy was built over.
+	 *
+	 * @return A pointer to the mesh, or nullptr before the first build.
+	 */
+	const TriangleMesh* getMesh() const;
+
+	/*
+	 * Finds the nearest triangle hit by a ray. Both sides of a triangle count as hits.
+	 *
+	 * @param origin The x, y, and z coordinates of the start of the ray.
+	 * @param direction The x, y, and z components of the direction of the ray; it does not need to be normalized.
+	 * @param maxDistance The farthest distance along the ray to search, in multiples of the direction.
+	 * @param hit Receives the nearest hit.
+	 * @return True if the ray hits a triangle within maxDistance, false otherwise.
+	 */
+	bool intersectRay(const double origin[3], const double direction[3], double maxDistance, RayHit& hit) const;
+
+	/*
+	 * Checks whether a ray hits any triangle, stopping at the first one found. This is cheaper than
+	 * intersectRay() for visibility checks that do not need the nearest hit.
+	 *
+	 * @param origin The x, y, and z coordinates of the start of the ray.
+	 * @param direction The x, y, and z components of the direction of the ray.
+	 * @param maxDistance The farthest distance along the ray to search, in multiples of the direction.
+	 * @return True if the ray hits a triangle within maxDistance, false otherwise.
+	 */
+	bool intersectsAny(const double origin[3], const double direction[3], double maxDistance) const;
+
+	/*
+	 * Finds the point of the mesh nearest to a query point.
+	 *
+	 * @param point The x, y, and z coordinates of the query point.
+	 * @param result Receives the nearest point and the triangle it lies on.
+	 * @return True if the mesh has a triangle, false if the hierarchy is empty.
+	 */
+	bool findClosestPoint(const double point[3], ClosestPoint& result) const;
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -0,0 +1,591 @@
+// Includes the MeshIntersect.h header file for function declarations.
+#include "MeshIntersect.h"
+// Includes the ExactMath.h header file for the exact orientation predicates.
+#include "ExactMath.h"
+
+// Includes the algorithm library to sort the pairs found.
+#include <algorithm>
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+
+// Number of pairs of subtrees to split the walk into before handing it to the thread pool.
+static const std::size_t TASK_TARGET = 1024;
+
+/*
+ * A pair of nodes, one from each hierarchy, whose boxes overlap.
+ */
+struct NodePair
+{
+	std::uint32_t first;
+	std::uint32_t second;
+};
+
+/*
+ * A triangle of a leaf with its exact effective coordinates, read once per leaf pair.
+ */
+struct LeafTriangle
+{
+	// Index of the triangle in its mesh, and the indices of its vertices.
+	std::uint32_t triangle;
+	std::uint32_t vertex[3];
+	// The x, y, and z coordinates of the three vertices, in that order.
+	int coordinates[9];
+	// The box of the triangle.
+	int low[3];
+	int high[3];
+	// Whether the triangle has no area.
+	bool degenerate;
+};
+
+/*
+ * Finds a coordinate axis the triangle can be dropped along without collapsing it: the projection onto the other two
+ * axes keeps every point of the triangle's plane apart, so coplanar tests can be done in 2D.
+ *
+ * @param triangle The coordinates of the triangle.
+ * @return The axis to drop, or -1 if the triangle has no area.
+ */
+static int projectionAxis(const int triangle[9])
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		int u = (axis + 1) % 3;
+		int v = (axis + 2) % 3;
+		if (orient2d(triangle[u], triangle[v], triangle[3 + u], triangle[3 + v], triangle[6 + u], triangle[6 + v]) != 0)
+		{
+			return axis;
+		}
+	}
+	return -1;
+}
+
+/*
+ * Finds on which side of the directed line through a and b the point c lies, after dropping an axis.
+ *
+ * @param a The first point of the line.
+ * @param b The second point of the line.
+ * @param c The point to classify.
+ * @param axis The axis to drop.
+ * @return 1 if the projected points turn counterclockwise, -1 if clockwise, 0 if they are collinear.
+ */
+static int orientProjected(const int a[3], const int b[3], const int c[3], int axis)
+{
+	int u = (axis + 1) % 3;
+	int v = (axis + 2) % 3;
+	return orient2d(a[u], a[v], b[u], b[v], c[u], c[v]);
+}
+
+/*
+ * Checks whether a point lies in a closed triangle, after dropping an axis. Both turning directions are accepted.
+ *
+ * @param triangle The coordinates of the triangle.
+ * @param point The point.
+ * @param axis The axis to drop.
+ * @return True if the projected point lies inside or on the border of the projected triangle.
+ */
+static bool containsProjected(const int triangle[9], const int point[3], int axis)
+{
+	int first = orientProjected(triangle, triangle + 3, point, axis);
+	int second = orientProjected(triangle + 3, triangle + 6, point, axis);
+	int third = orientProjected(triangle + 6, triangle, point, axis);
+	return !((first > 0 || second > 0 || third > 0) && (first < 0 || second < 0 || third < 0));
+}
+
+/*
+ * Checks whether two closed segments meet, after dropping an axis.
+ *
+ * @param p The start of the first segment.
+ * @param q The end of the first segment.
+ * @param r The start of the second segment.
+ * @param s The end of the second segment.
+ * @param axis The axis to drop.
+ * @return True if the projected segments share a point.
+ */
+static bool segmentsMeetProjected(const int p[3], const int q[3], const int r[3], const int s[3], int axis)
+{
+	int sideR = orientProjected(p, q, r, axis);
+	int sideS = orientProjected(p, q, s, axis);
+	int sideP = orientProjected(r, s, p, axis);
+	int sideQ = orientProjected(r, s, q, axis);
+	if (sideR * sideS > 0 || sideP * sideQ > 0)
+	{
+		return false;
+	}
+	if (sideR != 0 || sideS != 0 || sideP != 0 || sideQ != 0)
+	{
+		return true;
+	}
+	// All four points on one line: the segments meet if their ranges overlap on both remaining axes.
+	for (int k = 1; k <= 2; k++)
+	{
+		int c = (axis + k) % 3;
+		int lowFirst = std::min(p[c], q[c]);
+		int highFirst = std::max(p[c], q[c]);
+		int lowSecond = std::min(r[c], s[c]);
+		int highSecond = std::max(r[c], s[c]);
+		if (highFirst < lowSecond || highSecond < lowFirst)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * Checks whether a closed segment meets a closed triangle, given the sides of the triangle's plane its ends lie on.
+ *
+ * @param triangle The coordinates of the triangle, which must have an area.
+ * @param p The start of the segment.
+ * @param q The end of the segment.
+ * @param sideP The orient3d() sign of p against the triangle.
+ * @param sideQ The orient3d() sign of q against the triangle.
+ * @return True if the segment and the triangle share a point.
+ */
+static bool segmentMeetsTriangle(const int triangle[9], const int p[3], const int q[3], int sideP, int sideQ)
+{
+	if (sideP * sideQ > 0)
+	{
+		return false;
+	}
+	if (sideP == 0 && sideQ == 0)
+	{
+		// The segment lies in the plane: compare in a projection that keeps the triangle whole.
+		int axis = projectionAxis(triangle);
+		return containsProjected(triangle, p, axis) || containsProjected(triangle, q, axis)
+			|| segmentsMeetProjected(p, q, triangle, triangle + 3, axis)
+			|| segmentsMeetProjected(p, q, triangle + 3, triangle + 6, axis)
+			|| segmentsMeetProjected(p, q, triangle + 6, triangle, axis);
+	}
+	// The segment reaches the plane at one point; it lies in the triangle if the line passes every edge the same way.
+	const int* a = triangle;
+	const int* b = triangle + 3;
+	const int* c = triangle + 6;
+	int first = orient3d(p[0], p[1], p[2], q[0], q[1], q[2], a[0], a[1], a[2], b[0], b[1], b[2]);
+	int second = orient3d(p[0], p[1], p[2], q[0], q[1], q[2], b[0], b[1], b[2], c[0], c[1], c[2]);
+	int third = orient3d(p[0], p[1], p[2], q[0], q[1], q[2], c[0], c[1], c[2], a[0], a[1], a[2]);
+	return !((first > 0 || second > 0 || third > 0) && (first < 0 || second < 0 || third < 0));
+}
+
+/*
+ * Finds on which side of the plane of a triangle each vertex of another triangle lies.
+ *
+ * @param plane The coordinates of the triangle whose plane is used.
+ * @param triangle The coordinates of the triangle whose vertices are classified.
+ * @param sides Receives the orient3d() sign of each vertex.
+ * @return True if the vertices lie strictly on one side, so the triangles cannot meet.
+ */
+static bool classifyAgainstPlane(const int plane[9], const int triangle[9], int sides[3])
+{
+	for (int i = 0; i < 3; i++)
+	{
+		const int* point = triangle + i * 3;
+		sides[i] = orient3d(plane[0], plane[1], plane[2], plane[3], plane[4], plane[5], plane[6], plane[7], plane[8],
+			point[0], point[1], point[2]);
+	}
+	return (sides[0] > 0 && sides[1] > 0 && sides[2] > 0) || (sides[0] < 0 && sides[1] < 0 && sides[2] < 0);
+}
+
+/*
+ * Checks exactly whether two triangles that both have an area intersect, touching included.
+ *
+ * @param first The coordinates of the first triangle.
+ * @param second The coordinates of the second triangle.
+ * @return True if the triangles share at least one point.
+ */
+static bool intersectSolidTriangles(const int first[9], const int second[9])
+{
+	int secondSides[3];
+	int firstSides[3];
+	if (classifyAgainstPlane(first, second, secondSides) || classifyAgainstPlane(second, first, firstSides))
+	{
+		return false;
+	}
+	// Where the triangles meet, some edge of one of them meets the other triangle.
+	for (int i = 0; i < 3; i++)
+	{
+		int j = (i + 1) % 3;
+		if (segmentMeetsTriangle(first, second + i * 3, second + j * 3, secondSides[i], secondSides[j])
+			|| segmentMeetsTriangle(second, first + i * 3, first + j * 3, firstSides[i], firstSides[j]))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Checks exactly whether two triangles intersect, touching included.
+ *
+ * @param first The coordinates of the first triangle.
+ * @param second The coordinates of the second triangle.
+ * @return True if the triangles share at least one point.
+ */
+bool intersectTriangles(const int first[9], const int second[9])
+{
+	if (projectionAxis(first) < 0 || projectionAxis(second) < 0)
+	{
+		return false;
+	}
+	return intersectSolidTriangles(first, second);
+}
+
+/*
+ * Checks whether two triangles of the same mesh intersect beyond the vertices they share.
+ *
+ * @param first The first triangle.
+ * @param second The second triangle.
+ * @return True if the triangles meet anywhere their shared vertices do not explain.
+ */
+static bool intersectNeighbors(const LeafTriangle& first, const LeafTriangle& second)
+{
+	// Match the vertices by index.
+	int sharedFirst[3];
+	int sharedSecond[3];
+	int shared = 0;
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			if (first.vertex[i] == second.vertex[j])
+			{
+				sharedFirst[shared] = i;
+				sharedSecond[shared] = j;
+				shared++;
+			}
+		}
+	}
+	if (shared == 0)
+	{
+		return intersectSolidTriangles(first.coordinates, second.coordinates);
+	}
+	// The same three vertices twice: the triangles cover each other.
+	if (shared == 3)
+	{
+		return true;
+	}
+
+	if (shared == 2)
+	{
+		// Across an edge the triangles only overlap when they are coplanar with their third vertices on the same side.
+		const int* p = first.coordinates + sharedFirst[0] * 3;
+		const int* q = first.coordinates + sharedFirst[1] * 3;
+		const int* r = first.coordinates + (3 - sharedFirst[0] - sharedFirst[1]) * 3;
+		const int* s = second.coordinates + (3 - sharedSecond[0] - sharedSecond[1]) * 3;
+		if (orient3d(p[0], p[1], p[2], q[0], q[1], q[2], r[0], r[1], r[2], s[0], s[1], s[2]) != 0)
+		{
+			return false;
+		}
+		int axis = projectionAxis(first.coordinates);
+		return orientProjected(p, q, r, axis) * orientProjected(p, q, s, axis) > 0;
+	}
+
+	// Around one vertex, anything more than the vertex reaches the edge opposite it in one of the triangles.
+	// If either opposite edge lies strictly on one side of the other triangle's plane, only the vertex is shared.
+	const int* firstFar = first.coordinates + (sharedFirst[0] + 1) % 3 * 3;
+	const int* firstFarNext = first.coordinates + (sharedFirst[0] + 2) % 3 * 3;
+	const int* secondFar = second.coordinates + (sharedSecond[0] + 1) % 3 * 3;
+	const int* secondFarNext = second.coordinates + (sharedSecond[0] + 2) % 3 * 3;
+	const int* a = second.coordinates;
+	const int* b = first.coordinates;
+	int firstFarSide = orient3d(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], firstFar[0], firstFar[1], firstFar[2]);
+	int firstFarNextSide = orient3d(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], firstFarNext[0], firstFarNext[1], firstFarNext[2]);
+	if (firstFarSide * firstFarNextSide > 0)
+	{
+		return false;
+	}
+	int secondFarSide = orient3d(b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], b[8], secondFar[0], secondFar[1], secondFar[2]);
+	int secondFarNextSide = orient3d(b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], b[8], secondFarNext[0], secondFarNext[1], secondFarNext[2]);
+	if (secondFarSide * secondFarNextSide > 0)
+	{
+		return false;
+	}
+	return segmentMeetsTriangle(second.coordinates, firstFar, firstFarNext, firstFarSide, firstFarNextSide)
+		|| segmentMeetsTriangle(first.coordinates, secondFar, secondFarNext, secondFarSide, secondFarNextSide);
+}
+
+/*
+ * Reads the triangles of a leaf with their effective coordinates.
+ *
+ * @param hierarchy The hierarchy the leaf belongs to.
+ * @param node The leaf.
+ * @param triangles Receives the triangles, replacing its previous contents.
+ */
+static void loadLeaf(const MeshBvh& hierarchy, const BvhNode& node, std::vector<LeafTriangle>& triangles)
+{
+	const TriangleMesh& mesh = *hierarchy.getMesh();
+	const PointBuffer& vertices = mesh.getVertices();
+	const std::uint32_t* indices = mesh.getIndices();
+	const std::uint32_t* order = hierarchy.getTriangleOrder();
+	int offset[3];
+	mesh.getPendingOffset(offset[0], offset[1], offset[2]);
+
+	triangles.resize(node.count);
+	for (std::uint32_t i = 0; i < node.count; i++)
+	{
+		LeafTriangle& triangle = triangles[i];
+		triangle.triangle = order[node.first + i];
+		for (int k = 0; k < 3; k++)
+		{
+			std::uint32_t vertex = indices[static_cast<std::size_t>(triangle.triangle) * 3 + k];
+			triangle.vertex[k] = vertex;
+			// Add the offset the way flushTransform() would, wrapping around in unsigned arithmetic.
+			int stored[3] = { vertices.getCoordinateX(vertex), vertices.getCoordinateY(vertex), vertices.getCoordinateZ(vertex) };
+			for (int axis = 0; axis < 3; axis++)
+			{
+				triangle.coordinates[k * 3 + axis] = static_cast<int>(static_cast<std::uint32_t>(stored[axis]) + static_cast<std::uint32_t>(offset[axis]));
+			}
+		}
+		for (int axis = 0; axis < 3; axis++)
+		{
+			triangle.low[axis] = std::min(triangle.coordinates[axis], std::min(triangle.coordinates[3 + axis], triangle.coordinates[6 + axis]));
+			triangle.high[axis] = std::max(triangle.coordinates[axis], std::max(triangle.coordinates[3 + axis], triangle.coordinates[6 + axis]));
+		}
+		triangle.degenerate = projectionAxis(triangle.coordinates) < 0;
+	}
+}
+
+/*
+ * Checks whether two leaf triangles intersect, rejecting them by their exact boxes first.
+ *
+ * @param first The first triangle.
+ * @param second The second triangle.
+ * @param sameMesh Whether both triangles belong to the same mesh, so shared vertices do not count.
+ * @return True if the triangles intersect.
+ */
+static bool testPair(const LeafTriangle& first, const LeafTriangle& second, bool sameMesh)
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (first.high[axis] < second.low[axis] || second.high[axis] < first.low[axis])
+		{
+			return false;
+		}
+	}
+	if (first.degenerate || second.degenerate)
+	{
+		return false;
+	}
+	return sameMesh ? intersectNeighbors(first, second) : intersectSolidTriangles(first.coordinates, second.coordinates);
+}
+
+/*
+ * Checks whether the boxes of two nodes overlap.
+ *
+ * @param first The first node.
+ * @param second The second node.
+ * @return True if the boxes share a point.
+ */
+static bool boxesOverlap(const BvhNode& first, const BvhNode& second)
+{
+	return first.minX <= second.maxX && second.minX <= first.maxX && first.minY <= second.maxY && second.minY <= first.maxY
+		&& first.minZ <= second.maxZ && second.minZ <= first.maxZ;
+}
+
+/*
+ * Returns half the surface area of the box of a node, to decide which node of a pair to open.
+ *
+ * @param node The node.
+ * @return Half the surface area.
+ */
+static double halfArea(const BvhNode& node)
+{
+	double x = static_cast<double>(node.maxX) - node.minX;
+	double y = static_cast<double>(node.maxY) - node.minY;
+	double z = static_cast<double>(node.maxZ) - node.minZ;
+	return x * y + y * z + z * x;
+}
+
+/*
+ * Opens one node of a pair and adds the pairs of children whose boxes still overlap.
+ * A node paired with itself splits into its two children paired with themselves and with each other.
+ *
+ * @param firstNodes The nodes of the first hierarchy.
+ * @param secondNodes The nodes of the second hierarchy.
+ * @param pair The pair to open.
+ * @param selfPairs Whether both hierarchies are the same one.
+ * @param out Receives the pairs of children.
+ * @return True if the pair was opened, false if both nodes are leaves.
+ */
+static bool openPair(const BvhNode* firstNodes, const BvhNode* secondNodes, const NodePair& pair, bool selfPairs, std::vector<NodePair>& out)
+{
+	const BvhNode& first = firstNodes[pair.first];
+	const BvhNode& second = secondNodes[pair.second];
+	if (first.count > 0 && second.count > 0)
+	{
+		return false;
+	}
+	if (selfPairs && pair.first == pair.second)
+	{
+		std::uint32_t left = first.first;
+		out.push_back(NodePair{ left, left });
+		out.push_back(NodePair{ left + 1, left + 1 });
+		if (boxesOverlap(firstNodes[left], firstNodes[left + 1]))
+		{
+			out.push_back(NodePair{ left, left + 1 });
+		}
+		return true;
+	}
+	// Open the inner node with the larger box, so both sides shrink at a similar pace.
+	bool openFirst = second.count > 0 || (first.count == 0 && halfArea(first) >= halfArea(second));
+	if (openFirst)
+	{
+		for (std::uint32_t child = first.first; child < first.first + 2; child++)
+		{
+			if (boxesOverlap(firstNodes[child], second))
+			{
+				out.push_back(NodePair{ child, pair.second });
+			}
+		}
+	}
+	else
+	{
+		for (std::uint32_t child = second.first; child < second.first + 2; child++)
+		{
+			if (boxesOverlap(first, secondNodes[child]))
+			{
+				out.push_back(NodePair{ pair.first, child });
+			}
+		}
+	}
+	return true;
+}
+
+/*
+ * Walks two hierarchies together and collects the intersecting triangle pairs. The pairs of nodes near the roots
+ * are opened breadth-first until there are enough of them, then each one is walked depth-first as a parallel task.
+ *
+ * @param first The first hierarchy.
+ * @param second The second hierarchy, which is the first one for self-intersections.
+ * @param selfPairs Whether to look for self-intersections, pairing each node with itself once and ignoring shared vertices.
+ * @param pairs Receives the intersecting pairs, sorted.
+ * @param pool The thread pool that walks the pairs of subtrees.
+ */
+static void collectPairs(const MeshBvh& first, const MeshBvh& second, bool selfPairs, std::vector<TrianglePair>& pairs, ThreadPool& pool)
+{
+	pairs.clear();
+	const BvhNode* firstNodes = first.getNodes();
+	const BvhNode* secondNodes = second.getNodes();
+	if (firstNodes == nullptr || secondNodes == nullptr || !boxesOverlap(firstNodes[0], secondNodes[0]))
+	{
+		return;
+	}
+
+	// Open the pairs level by level until there are enough tasks or only leaf pairs are left.
+	std::vector<NodePair> tasks(1, NodePair{ 0, 0 });
+	std::vector<NodePair> opened;
+	bool changed = true;
+	while (changed && tasks.size() < TASK_TARGET)
+	{
+		changed = false;
+		opened.clear();
+		for (std::size_t i = 0; i < tasks.size(); i++)
+		{
+			if (openPair(firstNodes, secondNodes, tasks[i], selfPairs, opened))
+			{
+				changed = true;
+			}
+			else
+			{
+				opened.push_back(tasks[i]);
+			}
+		}
+		tasks.swap(opened);
+	}
+
+	// Walk each task depth-first into its own list.
+	std::vector<std::vector<TrianglePair>> found(tasks.size());
+	pool.parallelFor(tasks.size(), [&](std::size_t task)
+	{
+		std::vector<NodePair> stack(1, tasks[task]);
+		std::vector<LeafTriangle> firstLeaf;
+		std::vector<LeafTriangle> secondLeaf;
+		std::vector<TrianglePair>& result = found[task];
+		while (!stack.empty())
+		{
+			NodePair pair = stack.back();
+			stack.pop_back();
+			if (openPair(firstNodes, secondNodes, pair, selfPairs, stack))
+			{
+				continue;
+			}
+
+			// Two leaves: compare their triangles. A leaf paired with itself compares each pair once.
+			loadLeaf(first, firstNodes[pair.first], firstLeaf);
+			bool sameLeaf = selfPairs && pair.first == pair.second;
+			if (!sameLeaf)
+			{
+				loadLeaf(second, secondNodes[pair.second], secondLeaf);
+			}
+			const std::vector<LeafTriangle>& other = sameLeaf ? firstLeaf : secondLeaf;
+			for (std::size_t i = 0; i < firstLeaf.size(); i++)
+			{
+				for (std::size_t j = sameLeaf ? i + 1 : 0; j < other.size(); j++)
+				{
+					if (testPair(firstLeaf[i], other[j], selfPairs))
+					{
+						std::uint32_t a = firstLeaf[i].triangle;
+						std::uint32_t b = other[j].triangle;
+						result.push_back(selfPairs && b < a ? TrianglePair{ b, a } : TrianglePair{ a, b });
+					}
+				}
+			}
+		}
+	});
+
+	// Join the lists and sort them, so the result does not depend on the tasks or the thread count.
+	for (std::size_t task = 0; task < found.size(); task++)
+	{
+		pairs.insert(pairs.end(), found[task].begin(), found[task].end());
+	}
+	std::sort(pairs.begin(), pairs.end(), [](const TrianglePair& a, const TrianglePair& b)
+	{
+		return a.first != b.first ? a.first < b.first : a.second < b.second;
+	});
+}
+
+/*
+ * Finds every pair of intersecting triangles between two meshes, one from each.
+ *
+ * @param first The hierarchy over the first mesh.
+ * @param second The hierarchy over the second mesh.
+ * @param pairs Receives the intersecting pairs, sorted by the first triangle and then by the second.
+ * @param pool The thread pool that walks the pairs of subtrees.
+ */
+void findIntersectingTriangles(const MeshBvh& first, const MeshBvh& second, std::vector<TrianglePair>& pairs, ThreadPool& pool)
+{
+	collectPairs(first, second, false, pairs, pool);
+}
+
+/*
+ * Finds every pair of intersecting triangles between two meshes on the program's shared thread pool.
+ *
+ * @param first The hierarchy over the first mesh.
+ * @param second The hierarchy over the second mesh.
+ * @param pairs Receives the intersecting pairs, sorted by the first triangle and then by the second.
+ */
+void findIntersectingTriangles(const MeshBvh& first, const MeshBvh& second, std::vector<TrianglePair>& pairs)
+{
+	findIntersectingTriangles(first, second, pairs, ThreadPool::getShared());
+}
+
+/*
+ * Finds every pair of triangles of one mesh that intersect each other.
+ *
+ * @param hierarchy The hierarchy over the mesh.
+ * @param pairs Receives the intersecting pairs, each with the smaller triangle index first, sorted.
+ * @param pool The thread pool that walks the pairs of subtrees.
+ */
+void findSelfIntersections(const MeshBvh& hierarchy, std::vector<TrianglePair>& pairs, ThreadPool& pool)
+{
+	collectPairs(hierarchy, hierarchy, true, pairs, pool);
+}
+
+/*
+ * Finds every pair of triangles of one mesh that intersect each other on the program's shared thread pool.
+ *
+ * @param hierarchy The hierarchy over the mesh.
+ * @param pairs Receives the intersecting pairs, each with the smaller triangle index first, sorted.
+ */
+void findSelfIntersections(const MeshBvh& hierarchy, std::vector<TrianglePair>& pairs)
+{
+	findSelfIntersections(hierarchy, pairs, ThreadPool::getShared());
+}
@@ -0,0 +1,80 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef MESHINTERSECT_H
+#define MESHINTERSECT_H
+
+// Includes the MeshBvh.h header file to prune the triangle pairs with two bounding volume hierarchies.
+#include "MeshBvh.h"
+// Includes the ThreadPool.h header file to walk the pairs of subtrees in parallel.
+#include "ThreadPool.h"
+
+// Includes the cstdint library for the 32-bit triangle indices.
+#include <cstdint>
+// Includes the vector library for the list of intersecting pairs.
+#include <vector>
+
+/*
+ * Two triangles that intersect.
+ */
+struct TrianglePair
+{
+	// Index of the triangle in the first mesh, or the smaller index when both lie in the same mesh.
+	std::uint32_t first;
+	// Index of the triangle in the second mesh, or the larger index when both lie in the same mesh.
+	std::uint32_t second;
+};
+
+/*
+ * Checks exactly whether two triangles intersect, touching included. Each triangle first has to reach the plane
+ * of the other; if it does, one of the six edges crosses the other triangle, which the exact orient3d() predicate
+ * decides, or the triangles are coplanar and are compared in a projection with orient2d().
+ * Triangles with no area never intersect anything.
+ *
+ * @param first The x, y, and z coordinates of the three vertices of the first triangle, in that order.
+ * @param second The coordinates of the second triangle, laid out the same way.
+ * @return True if the triangles share at least one point.
+ */
+bool intersectTriangles(const int first[9], const int second[9]);
+
+/*
+ * Finds every pair of intersecting triangles between two meshes, one from each. The two hierarchies are walked
+ * together, so only triangles in leaves whose boxes overlap are compared: first by their exact integer boxes,
+ * then with intersectTriangles(). The pairs of subtrees near the roots are handed to the thread pool as tasks.
+ *
+ * @param first The hierarchy over the first mesh.
+ * @param second The hierarchy over the second mesh.
+ * @param pairs Receives the intersecting pairs, sorted by the first triangle and then by the second.
+ * @param pool The thread pool that walks the pairs of subtrees.
+ */
+void findIntersectingTriangles(const MeshBvh& first, const MeshBvh& second, std::vector<TrianglePair>& pairs, ThreadPool& pool);
+
+/*
+ * Finds every pair of intersecting triangles between two meshes on the program's shared thread pool.
+ *
+ * @param first The hierarchy over the first mesh.
+ * @param second The hierarchy over the second mesh.
+ * @param pairs Receives the intersecting pairs, sorted by the first triangle and then by the second.
+ */
+void findIntersectingTriangles(const MeshBvh& first, const MeshBvh& second, std::vector<TrianglePair>& pairs);
+
+/*
+ * Finds every pair of triangles of one mesh that intersect each other, walking the hierarchy against itself.
+ * Triangles that share vertices by index only count when they meet beyond what they share: neighbours across
+ * an edge only when they fold onto each other, and triangles around a vertex only when they cross somewhere else.
+ * Copies of a vertex at the same position but with another index are not shared, so weld the mesh first.
+ *
+ * @param hierarchy The hierarchy over the mesh.
+ * @param pairs Receives the intersecting pairs, each with the smaller triangle index first, sorted.
+ * @param pool The thread pool that walks the pairs of subtrees.
+ */
+void findSelfIntersections(const MeshBvh& hierarchy, std::vector<TrianglePair>& pairs, ThreadPool& pool);
+
+/*
+ * Finds every pair of triangles of one mesh that intersect each other on the program's shared thread pool.
+ *
+ * @param hierarchy The hierarchy over the mesh.
+ * @param pairs Receives the intersecting pairs, each with the smaller triangle index first, sorted.
+ */
+void findSelfIntersections(const MeshBvh& hierarchy, std::vector<TrianglePair>& pairs);
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
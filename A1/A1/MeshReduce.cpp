@@ -0,0 +1,145 @@
+// Includes the MeshReduce.h header file for function declarations.
+#include "MeshReduce.h"
+// Includes the AreaKernels.h header file to measure each chunk with the SIMD area kernels.
+#include "AreaKernels.h"
+
+// Includes the vector library for the per-chunk partial results.
+#include <vector>
+
+// Number of triangles in one chunk of the area reduction. It does not depend on the thread count,
+// so the chunks, and therefore the order of the additions, are the same on every machine.
+static const std::size_t TRIANGLE_CHUNK = 16384;
+// Number of vertices in one chunk of the bounding box reduction.
+static const std::size_t VERTEX_CHUNK = 65536;
+
+/*
+ * Partial area results of one chunk of triangles.
+ */
+struct AreaPartial
+{
+	double sum;
+	double min;
+	double max;
+};
+
+/*
+ * Partial bounding box of one chunk of vertices.
+ */
+struct BoundsPartial
+{
+	int minX, minY, minZ;
+	int maxX, maxY, maxZ;
+};
+
+/*
+ * Computes the area statistics and bounding box of a mesh in parallel.
+ *
+ * @param mesh The mesh to reduce.
+ * @param pool The thread pool that runs the chunks.
+ * @return The statistics of the mesh.
+ */
+MeshStatistics computeMeshStatistics(const TriangleMesh& mesh, ThreadPool& pool)
+{
+	// Start from an empty result.
+	MeshStatistics statistics = {};
+	statistics.triangleCount = mesh.getTriangleCount();
+	statistics.vertexCount = mesh.getVertexCount();
+
+	// Reduce the triangle areas.
+	if (statistics.triangleCount > 0)
+	{
+		// Pick the area kernel once for the whole mesh.
+		AreaKernel kernel = selectAreaKernel(mesh);
+		std::size_t chunkCount = ThreadPool::getChunkCount(statistics.triangleCount, TRIANGLE_CHUNK);
+		std::vector<AreaPartial> partials(chunkCount);
+
+		// Each task measures one chunk and sums it in triangle order.
+		pool.parallelForChunks(statistics.triangleCount, TRIANGLE_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+		{
+			// Measure the chunk into a thread-local scratch buffer.
+			std::vector<double> areas(last - first);
+			calcAreaRange(mesh, first, last, areas.data(), kernel);
+
+			// Reduce the chunk.
+			AreaPartial partial = { 0.0, areas[0], areas[0] };
+			for (std::size_t i = 0; i < areas.size(); i++)
+			{
+				partial.sum += areas[i];
+				partial.min = areas[i] < partial.min ? areas[i] : partial.min;
+				partial.max = areas[i] > partial.max ? areas[i] : partial.max;
+			}
+			partials[chunk] = partial;
+		});
+
+		// Combine the chunks in order so the floating-point sum is reproducible.
+		statistics.minArea = partials[0].min;
+		statistics.maxArea = partials[0].max;
+		for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+		{
+			statistics.totalArea += partials[chunk].sum;
+			statistics.minArea = partials[chunk].min < statistics.minArea ? partials[chunk].min : statistics.minArea;
+			statistics.maxArea = partials[chunk].max > statistics.maxArea ? partials[chunk].max : statistics.maxArea;
+		}
+	}
+
+	// Reduce the vertex coordinates to a bounding box.
+	if (statistics.vertexCount > 0)
+	{
+		const PointBuffer& vertices = mesh.getVertices();
+		const int* xs = vertices.dataX();
+		const int* ys = vertices.dataY();
+		const int* zs = vertices.dataZ();
+		std::size_t chunkCount = ThreadPool::getChunkCount(statistics.vertexCount, VERTEX_CHUNK);
+		std::vector<BoundsPartial> partials(chunkCount);
+
+		// Each task scans one chunk of the coordinate arrays.
+		pool.parallelForChunks(statistics.vertexCount, VERTEX_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+		{
+			BoundsPartial partial = { xs[first], ys[first], zs[first], xs[first], ys[first], zs[first] };
+			for (std::size_t i = first + 1; i < last; i++)
+			{
+				partial.minX = xs[i] < partial.minX ? xs[i] : partial.minX;
+				partial.minY = ys[i] < partial.minY ? ys[i] : partial.minY;
+				partial.minZ = zs[i] < partial.minZ ? zs[i] : partial.minZ;
+				partial.maxX = xs[i] > partial.maxX ? xs[i] : partial.maxX;
+				partial.maxY = ys[i] > partial.maxY ? ys[i] : partial.maxY;
+				partial.maxZ = zs[i] > partial.maxZ ? zs[i] : partial.maxZ;
+			}
+			partials[chunk] = partial;
+		});
+
+		// Combine the chunks into the box of the whole mesh.
+		BoundsPartial bounds = partials[0];
+		for (std::size_t chunk = 1; chunk < chunkCount; chunk++)
+		{
+			bounds.minX = partials[chunk].minX < bounds.minX ? partials[chunk].minX : bounds.minX;
+			bounds.minY = partials[chunk].minY < bounds.minY ? partials[chunk].minY : bounds.minY;
+			bounds.minZ = partials[chunk].minZ < bounds.minZ ? partials[chunk].minZ : bounds.minZ;
+			bounds.maxX = partials[chunk].maxX > bounds.maxX ? partials[chunk].maxX : bounds.maxX;
+			bounds.maxY = partials[chunk].maxY > bounds.maxY ? partials[chunk].maxY : bounds.maxY;
+			bounds.maxZ = partials[chunk].maxZ > bounds.maxZ ? partials[chunk].maxZ : bounds.maxZ;
+		}
+		// The box was found from the stored coordinates, so move it by the translation the mesh has not applied yet.
+		int dx, dy, dz;
+		mesh.getPendingOffset(dx, dy, dz);
+		statistics.minX = bounds.minX + dx;
+		statistics.minY = bounds.minY + dy;
+		statistics.minZ = bounds.minZ + dz;
+		statistics.maxX = bounds.maxX + dx;
+		statistics.maxY = bounds.maxY + dy;
+		statistics.maxZ = bounds.maxZ + dz;
+	}
+
+	return statistics;
+}
+
+/*
+ * Computes the statistics of a mesh on the program's shared thread pool.
+ *
+ * @param mesh The mesh to reduce.
+ * @return The statistics of the mesh.
+ */
+MeshStatistics computeMeshStatistics(const TriangleMesh& mesh)
+{
+	return computeMeshStatistics(mesh, ThreadPool::getShared());
+}
@@ -0,0 +1,59 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef MESHREDUCE_H
+#define MESHREDUCE_H
+
+// Includes the TriangleMesh.h header file to reduce over whole meshes.
+#include "TriangleMesh.h"
+// Includes the ThreadPool.h header file to spread the reductions across all cores.
+#include "ThreadPool.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+
+/*
+ * Holds the aggregate values computed over a whole mesh.
+ */
+struct MeshStatistics
+{
+	// Number of triangles that were measured.
+	std::size_t triangleCount;
+	// Sum of the areas of all triangles.
+	double totalArea;
+	// Area of the smallest triangle, or 0.0 for a mesh without triangles.
+	double minArea;
+	// Area of the largest triangle, or 0.0 for a mesh without triangles.
+	double maxArea;
+
+	// Number of vertices that were scanned for the bounding box.
+	std::size_t vertexCount;
+	// Smallest coordinates on each axis; the corner of the axis-aligned bounding box. 0 for an empty mesh.
+	int minX;
+	int minY;
+	int minZ;
+	// Largest coordinates on each axis; the opposite corner of the bounding box. 0 for an empty mesh.
+	int maxX;
+	int maxY;
+	int maxZ;
+};
+
+/*
+ * Computes the total, smallest, and largest triangle area and the axis-aligned bounding box of a mesh in parallel.
+ * The work is cut into fixed-size chunks that threads pick up as they become free, and the per-chunk
+ * results are combined in chunk order, so the result is identical on every run and for any thread count.
+ *
+ * @param mesh The mesh to reduce.
+ * @param pool The thread pool that runs the chunks.
+ * @return The statistics of the mesh.
+ */
+MeshStatistics computeMeshStatistics(const TriangleMesh& mesh, ThreadPool& pool);
+
+/*
+ * Computes the statistics of a mesh on the program's shared thread pool.
+ *
+ * @param mesh The mesh to reduce.
+ * @return The statistics of the mesh.
+ */
+MeshStatistics computeMeshStatistics(const TriangleMesh& mesh);
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -0,0 +1,166 @@
+// Includes the MeshReorder.h header file for function declarations.
+#include "MeshReorder.h"
+// Includes the MeshSort.h header file to sort the codes with the parallel radix sort.
+#include "MeshSort.h"
+
+// Includes the algorithm library for std::min and std::max.
+#include <algorithm>
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the vector library for the codes and the new orders.
+#include <vector>
+
+// Number of vertices or triangles handled by one parallel task. The chunks are fixed, so the new vertex and
+// triangle orders are the same for any thread count.
+static const std::size_t REORDER_CHUNK = 65536;
+// Largest cell coordinate on each axis of the grid the positions are scaled onto.
+static const std::uint64_t MORTON_CELL_MAX = (std::uint64_t(1) << 21) - 1;
+
+/*
+ * Spreads the lowest 21 bits of a value so two zero bits follow each of them.
+ *
+ * @param value The value to spread.
+ * @return The spread bits.
+ */
+static std::uint64_t spreadBits(std::uint32_t value)
+{
+	std::uint64_t bits = value & 0x1FFFFFu;
+	bits = (bits | bits << 32) & 0x1F00000000FFFFull;
+	bits = (bits | bits << 16) & 0x1F0000FF0000FFull;
+	bits = (bits | bits << 8) & 0x100F00F00F00F00Full;
+	bits = (bits | bits << 4) & 0x10C30C30C30C30C3ull;
+	bits = (bits | bits << 2) & 0x1249249249249249ull;
+	return bits;
+}
+
+/*
+ * Interleaves the bits of three 21-bit cell coordinates into a 63-bit Morton code.
+ *
+ * @param x The x cell coordinate.
+ * @param y The y cell coordinate.
+ * @param z The z cell coordinate.
+ * @return The Morton code.
+ */
+std::uint64_t encodeMorton(std::uint32_t x, std::uint32_t y, std::uint32_t z)
+{
+	return spreadBits(x) | spreadBits(y) << 1 | spreadBits(z) << 2;
+}
+
+/*
+ * Scales an offset from the low corner of the bounding box onto the Morton grid.
+ *
+ * @param offset The distance from the low corner, between 0 and extent.
+ * @param extent The size of the box along the axis.
+ * @return The cell coordinate, between 0 and MORTON_CELL_MAX.
+ */
+static std::uint32_t quantize(std::uint64_t offset, std::uint64_t extent)
+{
+	// Offsets stay below 2^34 and the grid has 2^21 cells, so the product fits in 64 bits.
+	return extent == 0 ? 0 : static_cast<std::uint32_t>(offset * MORTON_CELL_MAX / extent);
+}
+
+/*
+ * Reorders the vertices and triangles of a mesh by Morton code.
+ *
+ * @param mesh The mesh to reorder.
+ * @param pool The thread pool that computes and sorts the codes.
+ */
+void reorderMeshByMortonCode(TriangleMesh& mesh, ThreadPool& pool)
+{
+	std::size_t vertexCount = mesh.getVertexCount();
+	std::size_t triangleCount = mesh.getTriangleCount();
+	if (vertexCount == 0)
+	{
+		return;
+	}
+
+	// The stored coordinates are used as they are: a pending offset moves every vertex alike and changes no order.
+	const PointBuffer& vertices = static_cast<const TriangleMesh&>(mesh).getVertices();
+	const int* coordinates[3] = { vertices.dataX(), vertices.dataY(), vertices.dataZ() };
+
+	// Find the bounding box, one chunk of vertices per task.
+	std::size_t vertexChunks = ThreadPool::getChunkCount(vertexCount, REORDER_CHUNK);
+	std::vector<int> chunkBounds(vertexChunks * 6);
+	pool.parallelForChunks(vertexCount, REORDER_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+	{
+		int* bounds = &chunkBounds[chunk * 6];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			const int* values = coordinates[axis];
+			int low = values[first];
+			int high = values[first];
+			for (std::size_t v = first + 1; v < last; v++)
+			{
+				low = values[v] < low ? values[v] : low;
+				high = values[v] > high ? values[v] : high;
+			}
+			bounds[axis] = low;
+			bounds[axis + 3] = high;
+		}
+	});
+	long long low[3];
+	std::uint64_t extent[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		int lowest = chunkBounds[axis];
+		int highest = chunkBounds[axis + 3];
+		for (std::size_t chunk = 1; chunk < vertexChunks; chunk++)
+		{
+			lowest = std::min(lowest, chunkBounds[chunk * 6 + axis]);
+			highest = std::max(highest, chunkBounds[chunk * 6 + axis + 3]);
+		}
+		low[axis] = lowest;
+		extent[axis] = static_cast<std::uint64_t>(static_cast<long long>(highest) - lowest);
+	}
+
+	// Sort the triangles by the code of their centroids. The centroid is kept as the sum of the three vertices,
+	// measured from three times the low corner, so it stays exact in integers.
+	if (triangleCount > 0)
+	{
+		const std::uint32_t* indices = mesh.getIndices();
+		std::vector<std::uint64_t> codes(triangleCount);
+		pool.parallelForChunks(triangleCount, REORDER_CHUNK, [&](std::size_t, std::size_t first, std::size_t last)
+		{
+			for (std::size_t t = first; t < last; t++)
+			{
+				std::uint32_t cell[3];
+				for (int axis = 0; axis < 3; axis++)
+				{
+					const int* values = coordinates[axis];
+					long long sum = static_cast<long long>(values[indices[t * 3]]) + values[indices[t * 3 + 1]] + values[indices[t * 3 + 2]];
+					cell[axis] = quantize(static_cast<std::uint64_t>(sum - 3 * low[axis]), 3 * extent[axis]);
+				}
+				codes[t] = encodeMorton(cell[0], cell[1], cell[2]);
+			}
+		});
+		sortTriangles(mesh, codes, pool);
+	}
+
+	// Sort the vertices by the code of their positions.
+	std::vector<std::uint64_t> codes(vertexCount);
+	pool.parallelForChunks(vertexCount, REORDER_CHUNK, [&](std::size_t, std::size_t first, std::size_t last)
+	{
+		for (std::size_t v = first; v < last; v++)
+		{
+			std::uint32_t cell[3];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				cell[axis] = quantize(static_cast<std::uint64_t>(coordinates[axis][v] - low[axis]), extent[axis]);
+			}
+			codes[v] = encodeMorton(cell[0], cell[1], cell[2]);
+		}
+	});
+	std::vector<std::uint32_t> order;
+	radixSortKeys(codes, order, pool);
+	mesh.reorderVertices(order);
+}
+
+/*
+ * Reorders the vertices and triangles of a mesh by Morton code on the program's shared thread pool.
+ *
+ * @param mesh The mesh to reorder.
+ */
+void reorderMeshByMortonCode(TriangleMesh& mesh)
+{
+	reorderMeshByMortonCode(mesh, ThreadPool::getShared());
+}
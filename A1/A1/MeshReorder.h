@@ -0,0 +1,46 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef MESHREORDER_H
+#define MESHREORDER_H
+
+// Includes the TriangleMesh.h header file to reorder the vertices and triangles of indexed meshes.
+#include "TriangleMesh.h"
+// Includes the ThreadPool.h header file to compute and sort the codes in parallel.
+#include "ThreadPool.h"
+
+// Includes the cstdint library for the 64-bit Morton codes.
+#include <cstdint>
+
+/*
+ * Interleaves the bits of three 21-bit cell coordinates into a 63-bit Morton code: bit i of x lands in bit 3i,
+ * of y in bit 3i + 1, and of z in bit 3i + 2. Sorting by the code walks space along a Z-shaped curve,
+ * so points with nearby codes are usually close together. Bits above the lowest 21 are ignored.
+ *
+ * @param x The x cell coordinate.
+ * @param y The y cell coordinate.
+ * @param z The z cell coordinate.
+ * @return The Morton code.
+ */
+std::uint64_t encodeMorton(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+
+/*
+ * Reorders the vertices of a mesh by the Morton code of their positions, and its triangles by the Morton code
+ * of their centroids, so primitives that are close in space are also close in memory.
+ * Positions are scaled onto a 2^21 grid over the mesh's bounding box before they are encoded, and ties keep
+ * their previous order, so the result is the same on every run and for any thread count.
+ * The shape of the mesh does not change, but every vertex and triangle index does: structures built
+ * over the mesh, such as a MeshBvh, must be rebuilt.
+ *
+ * @param mesh The mesh to reorder.
+ * @param pool The thread pool that computes and sorts the codes.
+ */
+void reorderMeshByMortonCode(TriangleMesh& mesh, ThreadPool& pool);
+
+/*
+ * Reorders the vertices and triangles of a mesh by Morton code on the program's shared thread pool.
+ *
+ * @param mesh The mesh to reorder.
+ */
+void reorderMeshByMortonCode(TriangleMesh& mesh);
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
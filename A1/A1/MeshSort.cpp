@@ -0,0 +1,219 @@
+// Includes the MeshSort.h header file for function declarations.
+#include "MeshSort.h"
+// Includes the AreaKernels.h header file to measure the triangles with the SIMD area kernels.
+#include "AreaKernels.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the cstring library to read the bits of a double with memcpy.
+#include <cstring>
+
+// Number of keys counted and scattered by one parallel task.
+static const std::size_t SORT_CHUNK = 131072;
+// Number of bits sorted per pass, and the number of different digits that gives. Six passes of 11 bits
+// cover 64 bits, and 2048 counters per chunk still fit in the first-level cache.
+static const int DIGIT_BITS = 11;
+static const std::size_t DIGIT_COUNT = std::size_t(1) << DIGIT_BITS;
+
+/*
+ * Turns a double into an integer that sorts in the same order: the sign bit is flipped for positive numbers,
+ * and every bit is flipped for negative ones, whose magnitudes grow the other way.
+ *
+ * @param value The number to convert.
+ * @return The key.
+ */
+static std::uint64_t doubleToKey(double value)
+{
+	std::uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits & 0x8000000000000000ull ? ~bits : bits | 0x8000000000000000ull;
+}
+
+/*
+ * Sorts 64-bit keys with a parallel least-significant-digit radix sort.
+ *
+ * @param keys The keys to sort.
+ * @param order Receives, for each sorted position, the index the key had before.
+ * @param pool The thread pool that counts and scatters the chunks.
+ */
+void radixSortKeys(std::vector<std::uint64_t>& keys, std::vector<std::uint32_t>& order, ThreadPool& pool)
+{
+	std::size_t count = keys.size();
+	std::size_t chunkCount = ThreadPool::getChunkCount(count, SORT_CHUNK);
+	order.resize(count);
+	pool.parallelForChunks(count, SORT_CHUNK, [&](std::size_t, std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; i++)
+		{
+			order[i] = static_cast<std::uint32_t>(i);
+		}
+	});
+
+	// Each pass scatters from the current arrays into the spare ones, then swaps them.
+	std::vector<std::uint64_t> spareKeys(count);
+	std::vector<std::uint32_t> spareOrder(count);
+	// The digit counts of every chunk, which the prefix sum turns into the chunk's write positions.
+	std::vector<std::size_t> positions(chunkCount * DIGIT_COUNT);
+
+	for (int shift = 0; shift < 64; shift += DIGIT_BITS)
+	{
+		// Count the digits of each chunk.
+		const std::uint64_t* source = keys.data();
+		pool.parallelForChunks(count, SORT_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+		{
+			std::size_t* counts = &positions[chunk * DIGIT_COUNT];
+			for (std::size_t digit = 0; digit < DIGIT_COUNT; digit++)
+			{
+				counts[digit] = 0;
+			}
+			for (std::size_t i = first; i < last; i++)
+			{
+				counts[(source[i] >> shift) & (DIGIT_COUNT - 1)]++;
+			}
+		});
+
+		// Lay the digits out in order, each digit's chunks one after another; a digit shared by every key changes nothing.
+		std::size_t position = 0;
+		bool trivial = false;
+		for (std::size_t digit = 0; digit < DIGIT_COUNT && !trivial; digit++)
+		{
+			std::size_t digitStart = position;
+			for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+			{
+				std::size_t digitCount = positions[chunk * DIGIT_COUNT + digit];
+				positions[chunk * DIGIT_COUNT + digit] = position;
+				position += digitCount;
+			}
+			trivial = position - digitStart == count;
+		}
+		if (trivial)
+		{
+			continue;
+		}
+
+		// Scatter each chunk; keys with the same digit keep their order, which keeps the sort stable.
+		const std::uint32_t* sourceOrder = order.data();
+		std::uint64_t* targetKeys = spareKeys.data();
+		std::uint32_t* targetOrder = spareOrder.data();
+		pool.parallelForChunks(count, SORT_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+		{
+			// Read the shift once; the compiler cannot tell that the stores below leave it alone.
+			std::size_t* next = &positions[chunk * DIGIT_COUNT];
+			int digitShift = shift;
+			for (std::size_t i = first; i < last; i++)
+			{
+				std::uint64_t key = source[i];
+				std::size_t target = next[(key >> digitShift) & (DIGIT_COUNT - 1)]++;
+				targetKeys[target] = key;
+				targetOrder[target] = sourceOrder[i];
+			}
+		});
+		keys.swap(spareKeys);
+		order.swap(spareOrder);
+	}
+}
+
+/*
+ * Computes a sort key for every triangle of a mesh.
+ *
+ * @param mesh The mesh whose triangles are keyed.
+ * @param key What to sort the triangles by.
+ * @param keys Receives one key per triangle.
+ * @param pool The thread pool that computes the keys.
+ */
+void computeTriangleKeys(const TriangleMesh& mesh, TriangleSortKey key, std::vector<std::uint64_t>& keys, ThreadPool& pool)
+{
+	std::size_t triangleCount = mesh.getTriangleCount();
+	keys.resize(triangleCount);
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	if (key == TriangleSortKey::Area)
+	{
+		// Pick the area kernel once, then measure each chunk into a scratch buffer and convert it.
+		AreaKernel kernel = selectAreaKernel(mesh);
+		pool.parallelForChunks(triangleCount, SORT_CHUNK, [&](std::size_t, std::size_t first, std::size_t last)
+		{
+			std::vector<double> areas(last - first);
+			calcAreaRange(mesh, first, last, areas.data(), kernel);
+			for (std::size_t t = first; t < last; t++)
+			{
+				keys[t] = doubleToKey(areas[t - first]);
+			}
+		});
+		return;
+	}
+
+	// The stored coordinates are used as they are: a pending offset moves every centroid alike and changes no order.
+	const PointBuffer& vertices = mesh.getVertices();
+	const int* values = key == TriangleSortKey::CentroidX ? vertices.dataX() : key == TriangleSortKey::CentroidY ? vertices.dataY() : vertices.dataZ();
+	const std::uint32_t* indices = mesh.getIndices();
+	pool.parallelForChunks(triangleCount, SORT_CHUNK, [&](std::size_t, std::size_t first, std::size_t last)
+	{
+		for (std::size_t t = first; t < last; t++)
+		{
+			// Three times the centroid, shifted up by three times 2^31 so it is never negative.
+			long long sum = static_cast<long long>(values[indices[t * 3]]) + values[indices[t * 3 + 1]] + values[indices[t * 3 + 2]];
+			keys[t] = static_cast<std::uint64_t>(sum + 3 * 2147483648LL);
+		}
+	});
+}
+
+/*
+ * Sorts the triangles of a mesh in ascending order of a built-in key.
+ *
+ * @param mesh The mesh whose triangles are sorted.
+ * @param key What to sort the triangles by.
+ * @param pool The thread pool that computes and sorts the keys.
+ */
+void sortTriangles(TriangleMesh& mesh, TriangleSortKey key, ThreadPool& pool)
+{
+	std::vector<std::uint64_t> keys;
+	computeTriangleKeys(mesh, key, keys, pool);
+	sortTriangles(mesh, keys, pool);
+}
+
+/*
+ * Sorts the triangles of a mesh by a built-in key on the program's shared thread pool.
+ *
+ * @param mesh The mesh whose triangles are sorted.
+ * @param key What to sort the triangles by.
+ */
+void sortTriangles(TriangleMesh& mesh, TriangleSortKey key)
+{
+	sortTriangles(mesh, key, ThreadPool::getShared());
+}
+
+/*
+ * Sorts the triangles of a mesh in ascending order of keys chosen by the caller.
+ *
+ * @param mesh The mesh whose triangles are sorted.
+ * @param keys One key per triangle.
+ * @param pool The thread pool that sorts the keys.
+ * @return True if the triangles were sorted, false if there is not exactly one key per triangle.
+ */
+bool sortTriangles(TriangleMesh& mesh, std::vector<std::uint64_t>& keys, ThreadPool& pool)
+{
+	if (keys.size() != mesh.getTriangleCount())
+	{
+		return false;
+	}
+	// Sort the triangle numbers, then move the index triples once.
+	std::vector<std::uint32_t> order;
+	radixSortKeys(keys, order, pool);
+	return mesh.reorderTriangles(order);
+}
+
+/*
+ * Sorts the triangles of a mesh by keys chosen by the caller on the program's shared thread pool.
+ *
+ * @param mesh The mesh whose triangles are sorted.
+ * @param keys One key per triangle.
+ * @return True if the triangles were sorted, false if there is not exactly one key per triangle.
+ */
+bool sortTriangles(TriangleMesh& mesh, std::vector<std::uint64_t>& keys)
+{
+	return sortTriangles(mesh, keys, ThreadPool::getShared());
+}
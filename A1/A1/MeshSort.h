@@ -0,0 +1,89 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef MESHSORT_H
+#define MESHSORT_H
+
+// Includes the TriangleMesh.h header file to sort the triangles of indexed meshes.
+#include "TriangleMesh.h"
+// Includes the ThreadPool.h header file to count and scatter the keys in parallel.
+#include "ThreadPool.h"
+
+// Includes the cstdint library for the 64-bit keys and 32-bit triangle indices.
+#include <cstdint>
+// Includes the vector library for the keys and the sorted order.
+#include <vector>
+
+/*
+ * Lists the built-in keys triangles can be sorted by.
+ */
+enum class TriangleSortKey
+{
+	Area,
+	CentroidX,
+	CentroidY,
+	CentroidZ
+};
+
+/*
+ * Sorts 64-bit keys in ascending order with a parallel least-significant-digit radix sort, 11 bits per pass.
+ * The keys are cut into fixed-size chunks, and each pass counts the digits of every chunk in parallel,
+ * then scatters the chunks in parallel to the positions the counts give them. A pass in which every key
+ * has the same digit is skipped, so keys that use only their low bits cost fewer passes.
+ * The sort is stable, and the result is the same for any thread count.
+ *
+ * @param keys The keys to sort. They are left sorted.
+ * @param order Receives, for each sorted position, the index the key had before.
+ * @param pool The thread pool that counts and scatters the chunks.
+ */
+void radixSortKeys(std::vector<std::uint64_t>& keys, std::vector<std::uint32_t>& order, ThreadPool& pool);
+
+/*
+ * Computes a sort key for every triangle of a mesh. Areas are measured with the fastest area kernel
+ * and turned into integers that sort in the same order as the doubles. Centroids are kept exact as the sum
+ * of the three vertex coordinates.
+ *
+ * @param mesh The mesh whose triangles are keyed.
+ * @param key What to sort the triangles by.
+ * @param keys Receives one key per triangle.
+ * @param pool The thread pool that computes the keys.
+ */
+void computeTriangleKeys(const TriangleMesh& mesh, TriangleSortKey key, std::vector<std::uint64_t>& keys, ThreadPool& pool);
+
+/*
+ * Sorts the triangles of a mesh in ascending order of a built-in key. Only the index buffer and the cached
+ * areas move; the vertices stay where they are. Triangles with equal keys keep their previous order.
+ *
+ * @param mesh The mesh whose triangles are sorted.
+ * @param key What to sort the triangles by.
+ * @param pool The thread pool that computes and sorts the keys.
+ */
+void sortTriangles(TriangleMesh& mesh, TriangleSortKey key, ThreadPool& pool);
+
+/*
+ * Sorts the triangles of a mesh by a built-in key on the program's shared thread pool.
+ *
+ * @param mesh The mesh whose triangles are sorted.
+ * @param key What to sort the triangles by.
+ */
+void sortTriangles(TriangleMesh& mesh, TriangleSortKey key);
+
+/*
+ * Sorts the triangles of a mesh in ascending order of keys chosen by the caller.
+ *
+ * @param mesh The mesh whose triangles are sorted.
+ * @param keys One key per triangle. They are left sorted.
+ * @param pool The thread pool that sorts the keys.
+ * @return True if the triangles were sorted, false if there is not exactly one key per triangle.
+ */
+bool sortTriangles(TriangleMesh& mesh, std::vector<std::uint64_t>& keys, ThreadPool& pool);
+
+/*
+ * Sorts the triangles of a mesh by keys chosen by the caller on the program's shared thread pool.
+ *
+ * @param mesh The mesh whose triangles are sorted.
+ * @param keys One key per triangle. They are left sorted.
+ * @return True if the triangles were sorted, false if there is not exactly one key per triangle.
+ */
+bool sortTriangles(TriangleMesh& mesh, std::vector<std::uint64_t>& keys);
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -0,0 +1,292 @@
+// Includes the MeshWeld.h header file for function declarations.
+#include "MeshWeld.h"
+// Includes the SpatialHashGrid.h header file to find the earlier vertices within the tolerance.
+#include "SpatialHashGrid.h"
+
+// Includes the algorithm library for the earliest of several nearby vertices.
+#include <algorithm>
+// Includes the cstdint library for the fixed-width hashes and vertex indices.
+#include <cstdint>
+// Includes the utility library for std::move.
+#include <utility>
+// Includes the vector library for the partitions, the hash tables, and the index maps.
+#include <vector>
+
+// Number of vertices or indices handled by one parallel task. The chunks are fixed, so the welded vertices
+// are numbered the same way for any thread count.
+static const std::size_t WELD_CHUNK = 65536;
+// The top bits of a vertex hash pick its partition; equal vertices always share one.
+static const int PARTITION_BITS = 6;
+static const std::size_t PARTITION_COUNT = std::size_t(1) << PARTITION_BITS;
+// Marks an empty entry of a partition's hash table.
+static const std::uint32_t EMPTY_ENTRY = 0xFFFFFFFFu;
+
+/*
+ * Mixes the three coordinates of a vertex into a hash whose high and low bits are both well spread,
+ * so the high bits can pick the partition and the low bits the table entry inside it.
+ *
+ * @param x The x-coordinate of the vertex.
+ * @param y The y-coordinate of the vertex.
+ * @param z The z-coordinate of the vertex.
+ * @return The hash.
+ */
+static std::uint64_t hashVertex(int x, int y, int z)
+{
+	std::uint64_t hash = static_cast<std::uint32_t>(x) * 0x9E3779B97F4A7C15ull;
+	hash ^= static_cast<std::uint32_t>(y) * 0xC2B2AE3D27D4EB4Full;
+	hash ^= static_cast<std::uint32_t>(z) * 0x165667B19E3779F9ull;
+	// Fold the high bits back down and mix again, so the low bits depend on every bit of the coordinates.
+	hash ^= hash >> 32;
+	hash *= 0xD6E8FEB86659FD93ull;
+	return hash ^ (hash >> 32);
+}
+
+/*
+ * Points every vertex at the earliest vertex with exactly the same coordinates, in parallel.
+ * The vertices are counted and scattered into partitions by hash, keeping their order inside each partition,
+ * then every partition is welded on its own with a private open-addressing table.
+ *
+ * @param vertices The vertex pool.
+ * @param remap Receives, for each vertex, the index of the earliest vertex with the same coordinates.
+ * @param pool The thread pool that runs the passes.
+ */
+static void findExactDuplicates(const PointBuffer& vertices, std::vector<std::uint32_t>& remap, ThreadPool& pool)
+{
+	const int* xs = vertices.dataX();
+	const int* ys = vertices.dataY();
+	const int* zs = vertices.dataZ();
+	std::size_t vertexCount = vertices.size();
+	std::size_t chunkCount = ThreadPool::getChunkCount(vertexCount, WELD_CHUNK);
+
+	// Hash every vertex and count how many of each chunk fall into each partition.
+	std::vector<unsigned char> partitionOf(vertexCount);
+	std::vector<std::size_t> offsets(chunkCount * PARTITION_COUNT, 0);
+	pool.parallelForChunks(vertexCount, WELD_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+	{
+		std::size_t* counts = &offsets[chunk * PARTITION_COUNT];
+		for (std::size_t v = first; v < last; v++)
+		{
+			unsigned char partition = static_cast<unsigned char>(hashVertex(xs[v], ys[v], zs[v]) >> (64 - PARTITION_BITS));
+			partitionOf[v] = partition;
+			counts[partition]++;
+		}
+	});
+
+	// Turn the counts into the position where each chunk starts writing each partition.
+	// Partitions are laid out one after another, and inside a partition the chunks follow in order.
+	std::vector<std::size_t> partitionStart(PARTITION_COUNT + 1, 0);
+	std::size_t position = 0;
+	for (std::size_t partition = 0; partition < PARTITION_COUNT; partition++)
+	{
+		partitionStart[partition] = position;
+		for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+		{
+			std::size_t count = offsets[chunk * PARTITION_COUNT + partition];
+			offsets[chunk * PARTITION_COUNT + partition] = position;
+			position += count;
+		}
+	}
+	partitionStart[PARTITION_COUNT] = position;
+
+	// Scatter the vertex indices into their partitions; each chunk writes its own disjoint slots.
+	std::vector<std::uint32_t> partitioned(vertexCount);
+	pool.parallelForChunks(vertexCount, WELD_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+	{
+		std::size_t* next = &offsets[chunk * PARTITION_COUNT];
+		for (std::size_t v = first; v < last; v++)
+		{
+			partitioned[next[partitionOf[v]]++] = static_cast<std::uint32_t>(v);
+		}
+	});
+	// The partition numbers are no longer needed; free them before the tables are allocated.
+	std::vector<unsigned char>().swap(partitionOf);
+
+	// Weld each partition. Its vertices are visited in index order, so the first one stored for a position is its earliest copy.
+	pool.parallelFor(PARTITION_COUNT, [&](std::size_t partition)
+	{
+		std::size_t first = partitionStart[partition];
+		std::size_t last = partitionStart[partition + 1];
+
+		// Keep the table at most half full, so probe sequences stay short.
+		std::size_t tableSize = 16;
+		while (tableSize < (last - first) * 2)
+		{
+			tableSize *= 2;
+		}
+		std::size_t mask = tableSize - 1;
+		std::vector<std::uint32_t> table(tableSize, EMPTY_ENTRY);
+
+		for (std::size_t i = first; i < last; i++)
+		{
+			std::uint32_t v = partitioned[i];
+			// Probe linearly until the position is found or an empty entry proves it is new.
+			std::size_t entry = hashVertex(xs[v], ys[v], zs[v]) & mask;
+			while (table[entry] != EMPTY_ENTRY)
+			{
+				std::uint32_t other = table[entry];
+				if (xs[other] == xs[v] && ys[other] == ys[v] && zs[other] == zs[v])
+				{
+					break;
+				}
+				entry = (entry + 1) & mask;
+			}
+			if (table[entry] == EMPTY_ENTRY)
+			{
+				table[entry] = v;
+			}
+			remap[v] = table[entry];
+		}
+	});
+}
+
+/*
+ * Points every vertex at the earliest surviving vertex within a distance, visiting the vertices in order.
+ * A vertex with no surviving vertex that close survives itself.
+ *
+ * @param vertices The vertex pool.
+ * @param tolerance The largest distance between two vertices that are merged; at least 1.
+ * @param remap Receives, for each vertex, the index of the vertex it is merged into.
+ */
+static void findNearDuplicates(const PointBuffer& vertices, int tolerance, std::vector<std::uint32_t>& remap)
+{
+	const int* xs = vertices.dataX();
+	const int* ys = vertices.dataY();
+	const int* zs = vertices.dataZ();
+
+	// Cells as wide as the tolerance keep each search to the 27 cells around the vertex.
+	SpatialHashGrid survivors(tolerance);
+	std::vector<std::uint32_t> nearby;
+	for (std::size_t v = 0; v < vertices.size(); v++)
+	{
+		survivors.queryRadius(xs[v], ys[v], zs[v], tolerance, nearby);
+		if (nearby.empty())
+		{
+			survivors.insert(static_cast<std::uint32_t>(v), xs[v], ys[v], zs[v]);
+			remap[v] = static_cast<std::uint32_t>(v);
+		}
+		else
+		{
+			remap[v] = *std::min_element(nearby.begin(), nearby.end());
+		}
+	}
+}
+
+/*
+ * Merges the duplicate vertices of a mesh and rewrites its triangles.
+ *
+ * @param mesh The mesh whose vertices are merged.
+ * @param tolerance The largest distance between two vertices that are merged.
+ * @param pool The thread pool that runs the parallel passes.
+ * @return The vertex counts before and after welding.
+ */
+WeldStatistics weldMeshVertices(TriangleMesh& mesh, int tolerance, ThreadPool& pool)
+{
+	// The writable pool applies a pending translation, so the welded pool holds the effective coordinates.
+	PointBuffer& vertices = mesh.getVertices();
+	std::size_t vertexCount = vertices.size();
+	WeldStatistics statistics = { vertexCount, vertexCount, 1.0 };
+	if (vertexCount == 0)
+	{
+		return statistics;
+	}
+
+	// Find the vertex each vertex is merged into; it is always the vertex itself or an earlier one.
+	std::vector<std::uint32_t> remap(vertexCount);
+	if (tolerance > 0)
+	{
+		findNearDuplicates(vertices, tolerance, remap);
+	}
+	else
+	{
+		findExactDuplicates(vertices, remap, pool);
+	}
+
+	// Count the surviving vertices of each chunk, then give each chunk the first new index of its survivors.
+	std::size_t chunkCount = ThreadPool::getChunkCount(vertexCount, WELD_CHUNK);
+	std::vector<std::size_t> firstKept(chunkCount + 1, 0);
+	pool.parallelForChunks(vertexCount, WELD_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+	{
+		std::size_t kept = 0;
+		for (std::size_t v = first; v < last; v++)
+		{
+			kept += remap[v] == v;
+		}
+		firstKept[chunk + 1] = kept;
+	});
+	for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+	{
+		firstKept[chunk + 1] += firstKept[chunk];
+	}
+	std::size_t keptCount = firstKept[chunkCount];
+
+	// Number the survivors in their original order and copy them into a compact pool.
+	std::vector<std::uint32_t> newIndex(vertexCount);
+	PointBuffer welded(keptCount);
+	welded.resize(keptCount);
+	const int* xs = vertices.dataX();
+	const int* ys = vertices.dataY();
+	const int* zs = vertices.dataZ();
+	int* weldedXs = welded.dataX();
+	int* weldedYs = welded.dataY();
+	int* weldedZs = welded.dataZ();
+	pool.parallelForChunks(vertexCount, WELD_CHUNK, [&](std::size_t chunk, std::size_t first, std::size_t last)
+	{
+		std::size_t next = firstKept[chunk];
+		for (std::size_t v = first; v < last; v++)
+		{
+			if (remap[v] == v)
+			{
+				weldedXs[next] = xs[v];
+				weldedYs[next] = ys[v];
+				weldedZs[next] = zs[v];
+				newIndex[v] = static_cast<std::uint32_t>(next++);
+			}
+		}
+	});
+
+	// Give every merged vertex the new index of its survivor. This pass starts only once every survivor is numbered,
+	// since a survivor can lie in an earlier chunk.
+	pool.parallelForChunks(vertexCount, WELD_CHUNK, [&](std::size_t, std::size_t first, std::size_t last)
+	{
+		for (std::size_t v = first; v < last; v++)
+		{
+			if (remap[v] != v)
+			{
+				newIndex[v] = newIndex[remap[v]];
+			}
+		}
+	});
+	// The survivor table is no longer needed; free it before the indices are rewritten.
+	std::vector<std::uint32_t>().swap(remap);
+
+	// Rewrite the triangles to use the merged vertices.
+	std::uint32_t* indices = mesh.getIndices();
+	std::size_t indexCount = mesh.getTriangleCount() * 3;
+	pool.parallelForChunks(indexCount, WELD_CHUNK, [&](std::size_t, std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; i++)
+		{
+			indices[i] = newIndex[indices[i]];
+		}
+	});
+
+	// Replace the pool, and let resize drop the cached areas, which no longer match once vertices have snapped together.
+	vertices = std::move(welded);
+	mesh.resize(keptCount, mesh.getTriangleCount());
+
+	statistics.weldedVertexCount = keptCount;
+	statistics.compressionRatio = static_cast<double>(vertexCount) / static_cast<double>(keptCount);
+	return statistics;
+}
+
+/*
+ * Merges the duplicate vertices of a mesh on the program's shared thread pool.
+ *
+ * @param mesh The mesh whose vertices are merged.
+ * @param tolerance The largest distance between two vertices that are merged.
+ * @return The vertex counts before and after welding.
+ */
+WeldStatistics weldMeshVertices(TriangleMesh& mesh, int tolerance)
+{
+	return weldMeshVertices(mesh, tolerance, ThreadPool::getShared());
+}
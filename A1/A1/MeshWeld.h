@@ -0,0 +1,54 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef MESHWELD_H
+#define MESHWELD_H
+
+// Includes the TriangleMesh.h header file to weld the vertices of indexed meshes.
+#include "TriangleMesh.h"
+// Includes the ThreadPool.h header file to spread the hashing and the rewriting across all cores.
+#include "ThreadPool.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+
+/*
+ * Holds the outcome of welding the vertices of a mesh.
+ */
+struct WeldStatistics
+{
+	// Number of vertices in the pool before welding.
+	std::size_t originalVertexCount;
+	// Number of vertices left after welding.
+	std::size_t weldedVertexCount;
+	// How many times smaller the pool became: originalVertexCount / weldedVertexCount, or 1.0 for an empty mesh.
+	double compressionRatio;
+};
+
+/*
+ * Merges the duplicate vertices of a mesh into one shared vertex and rewrites the triangles to use it.
+ * Each vertex is merged into the earliest vertex it matches, and the surviving vertices keep their order,
+ * so the result is the same on every run and for any thread count.
+ *
+ * With a tolerance of 0, only vertices with exactly the same coordinates are merged. Their positions are
+ * hashed into an open-addressing table, split by hash into independent partitions that are welded in parallel.
+ * With a positive tolerance, a vertex is merged into the earliest surviving vertex within that distance,
+ * which snaps the small gaps left by rounding float coordinates. This search runs on one thread, because
+ * whether a vertex survives depends on the vertices before it. Triangles that collapse are kept.
+ *
+ * @param mesh The mesh whose vertices are merged. A pending translation is applied first.
+ * @param tolerance The largest distance between two vertices that are merged. Negative values are treated as 0.
+ * @param pool The thread pool that runs the parallel passes.
+ * @return The vertex counts before and after welding.
+ */
+WeldStatistics weldMeshVertices(TriangleMesh& mesh, int tolerance, ThreadPool& pool);
+
+/*
+ * Merges the duplicate vertices of a mesh on the program's shared thread pool.
+ *
+ * @param mesh The mesh whose vertices are merged. A pending translation is applied first.
+ * @param tolerance The largest distance between two vertices that are merged; 0 merges only exact duplicates.
+ * @return The vertex counts before and after welding.
+ */
+WeldStatistics weldMeshVertices(TriangleMesh& mesh, int tolerance = 0);
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -2,67 +2,273 @@
 #ifndef POINT_H
 #define POINT_H
 
+// Includes the input/output stream library for displaying points.
+#include <iostream>
+// Includes the cstdint library for the 64-bit coordinate type.
+#include <cstdint>
+// Includes the type_traits library to restrict coordinates to arithmetic types and to count constructor arguments.
+#include <type_traits>
+
+/*
+ * Names the axes of a point, so an axis can be chosen at compile time.
+ */
+enum class Axis
+{
+    X = 0,
+    Y = 1,
+    Z = 2,
+    W = 3
+};
+
 /*
- * Defines a Point class to represent a 3D point in space with x, y, and z coordinates.
+ * Defines a BasicPoint class template to represent a point in N-dimensional space with coordinates of type T.
+ * The axis of translate<Axis>() and getCoordinate<Axis>() is checked and resolved at compile time,
+ * so hot loops have no branch and no error code to check.
  */
-class Point
+template <typename T, int N>
+class BasicPoint
 {
+    // Only numeric coordinates and 2D, 3D or 4D points are supported.
+    static_assert(std::is_arithmetic<T>::value, "Point coordinates must be an arithmetic type");
+    static_assert(N >= 2 && N <= 4, "Points must have 2, 3, or 4 dimensions");
+
 private:
-    // Integer member variable x initialized to 0, representing the x-coordinate.
-    int x = 0;
-    // Integer member variable y initialized to 0, representing the y-coordinate.
-    int y = 0;
-    // Integer member variable z initialized to 0, representing the z-coordinate.
-    int z = 0;
-
-public:  
+    // The coordinates of the point in axis order (x, y, z, w), all initialized to 0.
+    T coordinates[N] = {};
+
+public:
+    // The type of each coordinate.
+    typedef T CoordinateType;
+    // The number of dimensions of the point.
+    static const int DIMENSIONS = N;
+
+    /*
+     * Default constructor that places the point at the origin.
+     */
+    constexpr BasicPoint() = default;
+
     /*
-     * Constructor that initializes the x, y, and z coordinates of the point.
+     * Constructor that initializes every coordinate of the point, in axis order.
+     * It takes exactly N values; for a 3D point they are the x, y, and z coordinates.
      *
-     * @param xParameter The x-coordinate of the point.
-     * @param yParameter The y-coordinate of the point.
-     * @param zParameter The z-coordinate of the point.
+     * @param values The coordinates of the point.
      */
-    Point(int xParameter, int yParameter, int zParameter);
+    template <typename... Values, typename = typename std::enable_if<sizeof...(Values) == N>::type>
+    constexpr BasicPoint(Values... values) : coordinates{ static_cast<T>(values)... }
+    {
+        // The constructor body is empty as the initialization is done in the initialization list.
+    }
 
     /*
-     * Destructor for the Point class.
+     * Getter for the coordinate on an axis chosen at compile time.
+     *
+     * @return The coordinate on axis A.
+     */
+    template <Axis A>
+    constexpr T getCoordinate() const
+    {
+        static_assert(static_cast<int>(A) < N, "Axis does not exist in this point");
+        return coordinates[static_cast<int>(A)];
+    }
+
+    /*
+     * Getter for the coordinate at a runtime index.
+     *
+     * @param index The index of the axis (0 for x, 1 for y, ...). Must be below N.
+     * @return The coordinate on that axis.
      */
-    ~Point();
+    constexpr T getCoordinate(int index) const
+    {
+        return coordinates[index];
+    }
 
     /*
      * Getter for the x-coordinate of the point.
      *
      * @return The x-coordinate.
      */
-    int getCoordinateX() const;
+    constexpr T getCoordinateX() const
+    {
+        return getCoordinate<Axis::X>();
+    }
     /*
      * Getter for the y-coordinate of the point.
      *
      * @return The y-coordinate.
      */
-    int getCoordinateY() const;
+    constexpr T getCoordinateY() const
+    {
+        return getCoordinate<Axis::Y>();
+    }
     /*
      * Getter for the z-coordinate of the point.
      *
      * @return The z-coordinate.
      */
-    int getCoordinateZ() const;
+    constexpr T getCoordinateZ() const
+    {
+        return getCoordinate<Axis::Z>();
+    }
 
     /*
-     * Translates the point by a specified distance along a given axis.
+     * Translates the point by a specified distance along an axis chosen at compile time.
      *
      * @param d The distance by which to translate the point.
-     * @param axis The axis along which to translate ('x', 'y', or 'z').
-     * @return 0 if successful, -1 if the axis is invalid.
      */
-    int translate(int d, char axis);
+    template <Axis A>
+    constexpr void translate(T d)
+    {
+        static_assert(static_cast<int>(A) < N, "Axis does not exist in this point");
+        coordinates[static_cast<int>(A)] += d;
+    }
+
+    /*
+     * Translates the point by a specified distance along an axis chosen at runtime.
+     *
+     * @param d The distance by which to translate the point.
+     * @param axis The axis along which to translate ('x', 'y', 'z', or 'w').
+     * @return 0 if successful, -1 if the axis is invalid or does not exist in this point.
+     */
+    int translate(T d, char axis)
+    {
+        // Convert the axis letter to an index.
+        int index;
+        switch (axis)
+        {
+        case 'x':
+            index = 0;
+            break;
+        case 'y':
+            index = 1;
+            break;
+        case 'z':
+            index = 2;
+            break;
+        case 'w':
+            index = 3;
+            break;
+        // If the axis is invalid, return -1 indicating an error.
+        default:
+            return -1;
+        }
+
+        // Reject axes beyond the point's dimensions.
+        if (index >= N)
+        {
+            return -1;
+        }
+
+        // Adjust the coordinate on the selected axis.
+        coordinates[index] += d;
+        return 0;
+    }
+
+    /*
+     * Adds two points coordinate by coordinate.
+     *
+     * @param other The point to add.
+     * @return The sum of the two points.
+     */
+    constexpr BasicPoint operator+(const BasicPoint& other) const
+    {
+        BasicPoint result = *this;
+        for (int i = 0; i < N; i++)
+        {
+            result.coordinates[i] += other.coordinates[i];
+        }
+        return result;
+    }
+
+    /*
+     * Subtracts two points coordinate by coordinate, giving the vector from other to this point.
+     *
+     * @param other The point to subtract.
+     * @return The difference of the two points.
+     */
+    constexpr BasicPoint operator-(const BasicPoint& other) const
+    {
+        BasicPoint result = *this;
+        for (int i = 0; i < N; i++)
+        {
+            result.coordinates[i] -= other.coordinates[i];
+        }
+        return result;
+    }
+
+    /*
+     * Checks whether two points have the same coordinates.
+     *
+     * @param other The point to compare with.
+     * @return True if every coordinate is equal.
+     */
+    constexpr bool operator==(const BasicPoint& other) const
+    {
+        for (int i = 0; i < N; i++)
+        {
+            if (coordinates[i] != other.coordinates[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     * Setter for the coordinate at a runtime index.
+     *
+     * @param index The index of the axis (0 for x, 1 for y, ...). Must be below N.
+     * @param value The new coordinate.
+     */
+    constexpr void setCoordinate(int index, T value)
+    {
+        coordinates[index] = value;
+    }
+
+    /*
+     * Converts the point to another coordinate type, for example to feed int data to a float renderer.
+     *
+     * @return A point with the same coordinates converted to type U.
+     */
+    template <typename U>
+    constexpr BasicPoint<U, N> convert() const
+    {
+        BasicPoint<U, N> result;
+        for (int i = 0; i < N; i++)
+        {
+            result.setCoordinate(i, static_cast<U>(coordinates[i]));
+        }
+        return result;
+    }
 
     /*
      * Displays the point's coordinates in the format (x, y, z).
      */
-    void displayPoint() const;
+    void displayPoint() const
+    {
+        std::cout << "(";
+        for (int i = 0; i < N; i++)
+        {
+            std::cout << (i > 0 ? ", " : "") << coordinates[i];
+        }
+        std::cout << ")\n";
+    }
 };
 
+// The point type used throughout the project: three int coordinates.
+typedef BasicPoint<int, 3> Point;
+// 2D point with int coordinates.
+typedef BasicPoint<int, 2> Point2i;
+// 3D point with 64-bit integer coordinates.
+typedef BasicPoint<std::int64_t, 3> Point3i64;
+// 3D point with float coordinates, the layout renderers expect.
+typedef BasicPoint<float, 3> Point3f;
+// 3D point with double coordinates.
+typedef BasicPoint<double, 3> Point3d;
+// 4D point with float coordinates, for homogeneous coordinates.
+typedef BasicPoint<float, 4> Point4f;
+
+// The int point is compiled once in Point.cpp rather than in every file that includes this header.
+extern template class BasicPoint<int, 3>;
+
 // End of the header guard to prevent multiple inclusions of this file.
-#endif
\ No newline at end of file
+#endif
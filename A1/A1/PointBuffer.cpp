@@ -0,0 +1,452 @@
+// Includes the PointBuffer.h header file for function declarations.
+#include "PointBuffer.h"
+
+// Includes the input/output stream library for IO operations.
+#include <iostream>
+// Includes the new library for aligned allocation through std::align_val_t.
+#include <new>
+// Includes the cstring library for std::memcpy and std::memset.
+#include <cstring>
+// Includes the utility library for std::swap.
+#include <utility>
+
+/*
+ * Allocates an uninitialized integer array aligned to PointBuffer::ALIGNMENT.
+ *
+ * @param size The number of integers to allocate.
+ * @return A pointer to the aligned array, or nullptr if the size is 0.
+ */
+static int* allocateAligned(std::size_t size)
+{
+	// Nothing to allocate for an empty array.
+	if (size == 0)
+	{
+		return nullptr;
+	}
+	// Request raw memory with the buffer's alignment so vector loads never split a cache line.
+	return static_cast<int*>(::operator new(size * sizeof(int), std::align_val_t(PointBuffer::ALIGNMENT)));
+}
+
+/*
+ * Frees an array previously returned by allocateAligned.
+ *
+ * @param array The pointer to the array to free. May be nullptr.
+ */
+static void freeAligned(int* array)
+{
+	// Only release memory that was actually allocated.
+	if (array != nullptr)
+	{
+		::operator delete(array, std::align_val_t(PointBuffer::ALIGNMENT));
+	}
+}
+
+/*
+ * Adds the same value to every element of an array.
+ * The loop has no branches and no aliasing, so the compiler turns it into packed SIMD additions.
+ *
+ * @param values The pointer to the array to update.
+ * @param size The number of elements in the array.
+ * @param d The value to add to each element.
+ */
+static void addToEach(int* values, std::size_t size, int d)
+{
+	// Loop through every element and add the offset.
+	for (std::size_t i = 0; i < size; i++)
+	{
+		values[i] += d;
+	}
+}
+
+/*
+ * Default constructor for the PointBuffer class.
+ * Starts with no points and no allocated memory.
+ */
+PointBuffer::PointBuffer() : coordinatesX(nullptr), coordinatesY(nullptr), coordinatesZ(nullptr), count(0), capacity(0)
+{
+	// Constructor body is empty since initialization is done in the initialization list.
+}
+
+/*
+ * Constructor that reserves space for a number of points.
+ *
+ * @param initialCapacity The number of points to reserve space for.
+ */
+PointBuffer::PointBuffer(std::size_t initialCapacity) : PointBuffer()
+{
+	// Allocate the arrays up front so the first additions do not reallocate.
+	reserve(initialCapacity);
+}
+
+/*
+ * Copy constructor that duplicates the coordinates of another buffer.
+ *
+ * @param other The buffer to copy from.
+ */
+PointBuffer::PointBuffer(const PointBuffer& other) : PointBuffer(other.count)
+{
+	// Copy each coordinate array in one block.
+	if (other.count > 0)
+	{
+		std::memcpy(coordinatesX, other.coordinatesX, other.count * sizeof(int));
+		std::memcpy(coordinatesY, other.coordinatesY, other.count * sizeof(int));
+		std::memcpy(coordinatesZ, other.coordinatesZ, other.count * sizeof(int));
+	}
+	// The copy holds as many points as the original.
+	count = other.count;
+}
+
+/*
+ * Move constructor that takes over the arrays of another buffer.
+ *
+ * @param other The buffer to move from.
+ */
+PointBuffer::PointBuffer(PointBuffer&& other) noexcept : PointBuffer()
+{
+	// Swap with the empty buffer so the other buffer ends up empty.
+	*this = std::move(other);
+}
+
+/*
+ * Copy assignment operator that replaces the contents with a copy of another buffer.
+ *
+ * @param other The buffer to copy from.
+ * @return A reference to this buffer.
+ */
+PointBuffer& PointBuffer::operator=(const PointBuffer& other)
+{
+	// Copy into a temporary first, then take over its arrays.
+	if (this != &other)
+	{
+		PointBuffer copy(other);
+		*this = std::move(copy);
+	}
+	return *this;
+}
+
+/*
+ * Move assignment operator that takes over the arrays of another buffer.
+ *
+ * @param other The buffer to move from.
+ * @return A reference to this buffer.
+ */
+PointBuffer& PointBuffer::operator=(PointBuffer&& other) noexcept
+{
+	// Exchange every member; the old arrays are freed when the other buffer is destroyed.
+	std::swap(coordinatesX, other.coordinatesX);
+	std::swap(coordinatesY, other.coordinatesY);
+	std::swap(coordinatesZ, other.coordinatesZ);
+	std::swap(count, other.count);
+	std::swap(capacity, other.capacity);
+	// Leave the moved-from buffer without points.
+	other.clear();
+	return *this;
+}
+
+/*
+ * Destructor for the PointBuffer class.
+ * Frees the three coordinate arrays.
+ */
+PointBuffer::~PointBuffer()
+{
+	freeAligned(coordinatesX);
+	freeAligned(coordinatesY);
+	freeAligned(coordinatesZ);
+}
+
+/*
+ * Reallocates the coordinate arrays so they can hold at least newCapacity points.
+ * The capacity is rounded up to a whole number of aligned blocks.
+ *
+ * @param newCapacity The minimum number of points to hold.
+ */
+void PointBuffer::grow(std::size_t newCapacity)
+{
+	// Number of integers that fit in one aligned block.
+	const std::size_t blockInts = ALIGNMENT / sizeof(int);
+	// Round the requested capacity up to a multiple of the block size.
+	newCapacity = (newCapacity + blockInts - 1) / blockInts * blockInts;
+
+	// Allocate the new arrays. If a later allocation throws, the earlier ones are freed before the exception
+	// leaves, and the buffer keeps its old arrays untouched.
+	int* newX = allocateAligned(newCapacity);
+	int* newY = nullptr;
+	int* newZ = nullptr;
+	try
+	{
+		newY = allocateAligned(newCapacity);
+		newZ = allocateAligned(newCapacity);
+	}
+	catch (...)
+	{
+		freeAligned(newX);
+		freeAligned(newY);
+		throw;
+	}
+
+	// Copy the existing points into the new arrays.
+	if (count > 0)
+	{
+		std::memcpy(newX, coordinatesX, count * sizeof(int));
+		std::memcpy(newY, coordinatesY, count * sizeof(int));
+		std::memcpy(newZ, coordinatesZ, count * sizeof(int));
+	}
+
+	// Release the old arrays.
+	freeAligned(coordinatesX);
+	freeAligned(coordinatesY);
+	freeAligned(coordinatesZ);
+
+	// Start using the new arrays.
+	coordinatesX = newX;
+	coordinatesY = newY;
+	coordinatesZ = newZ;
+	capacity = newCapacity;
+}
+
+/*
+ * Returns the number of points stored in the buffer.
+ *
+ * @return The number of points.
+ */
+std::size_t PointBuffer::size() const
+{
+	return count;
+}
+
+/*
+ * Returns the number of points the buffer can hold without reallocating.
+ *
+ * @return The capacity of the buffer.
+ */
+std::size_t PointBuffer::getCapacity() const
+{
+	return capacity;
+}
+
+/*
+ * Makes sure the buffer can hold at least newCapacity points.
+ *
+ * @param newCapacity The number of points to reserve space for.
+ */
+void PointBuffer::reserve(std::size_t newCapacity)
+{
+	// Only grow; reserving less than the current capacity does nothing.
+	if (newCapacity > capacity)
+	{
+		grow(newCapacity);
+	}
+}
+
+/*
+ * Changes the number of points in the buffer. New points are placed at the origin.
+ *
+ * @param newSize The new number of points.
+ */
+void PointBuffer::resize(std::size_t newSize)
+{
+	// Make room for the new points.
+	reserve(newSize);
+	// Zero the coordinates of any points added at the end.
+	if (newSize > count)
+	{
+		std::memset(coordinatesX + count, 0, (newSize - count) * sizeof(int));
+		std::memset(coordinatesY + count, 0, (newSize - count) * sizeof(int));
+		std::memset(coordinatesZ + count, 0, (newSize - count) * sizeof(int));
+	}
+	count = newSize;
+}
+
+/*
+ * Removes all points from the buffer while keeping its memory.
+ */
+void PointBuffer::clear()
+{
+	count = 0;
+}
+
+/*
+ * Appends a point to the end of the buffer, doubling the capacity when it is full.
+ *
+ * @param x The x-coordinate of the new point.
+ * @param y The y-coordinate of the new point.
+ * @param z The z-coordinate of the new point.
+ * @return The index of the new point.
+ */
+std::size_t PointBuffer::addPoint(int x, int y, int z)
+{
+	// Grow geometrically so appending millions of points stays amortized O(1).
+	if (count == capacity)
+	{
+		grow(capacity == 0 ? ALIGNMENT / sizeof(int) : capacity * 2);
+	}
+
+	// Store each coordinate in its own array.
+	coordinatesX[count] = x;
+	coordinatesY[count] = y;
+	coordinatesZ[count] = z;
+
+	// Return the index of the point just added.
+	return count++;
+}
+
+/*
+ * Appends a copy of an existing Point to the end of the buffer.
+ *
+ * @param point The point to copy.
+ * @return The index of the new point.
+ */
+std::size_t PointBuffer::addPoint(const Point& point)
+{
+	return addPoint(point.getCoordinateX(), point.getCoordinateY(), point.getCoordinateZ());
+}
+
+/*
+ * Overwrites the coordinates of the point at the given index.
+ *
+ * @param index The index of the point to change.
+ * @param x The new x-coordinate.
+ * @param y The new y-coordinate.
+ * @param z The new z-coordinate.
+ */
+void PointBuffer::setPoint(std::size_t index, int x, int y, int z)
+{
+	coordinatesX[index] = x;
+	coordinatesY[index] = y;
+	coordinatesZ[index] = z;
+}
+
+/*
+ * Builds a Point object from the coordinates stored at the given index.
+ *
+ * @param index The index of the point.
+ * @return A Point holding the same coordinates.
+ */
+Point PointBuffer::getPoint(std::size_t index) const
+{
+	return Point(coordinatesX[index], coordinatesY[index], coordinatesZ[index]);
+}
+
+/*
+ * Getter for the x-coordinate of the point at the given index.
+ *
+ * @param index The index of the point.
+ * @return The x-coordinate.
+ */
+int PointBuffer::getCoordinateX(std::size_t index) const
+{
+	return coordinatesX[index];
+}
+
+/*
+ * Getter for the y-coordinate of the point at the given index.
+ *
+ * @param index The index of the point.
+ * @return The y-coordinate.
+ */
+int PointBuffer::getCoordinateY(std::size_t index) const
+{
+	return coordinatesY[index];
+}
+
+/*
+ * Getter for the z-coordinate of the point at the given index.
+ *
+ * @param index The index of the point.
+ * @return The z-coordinate.
+ */
+int PointBuffer::getCoordinateZ(std::size_t index) const
+{
+	return coordinatesZ[index];
+}
+
+/*
+ * Direct access to the coordinate arrays.
+ */
+int* PointBuffer::dataX()
+{
+	return coordinatesX;
+}
+
+const int* PointBuffer::dataX() const
+{
+	return coordinatesX;
+}
+
+int* PointBuffer::dataY()
+{
+	return coordinatesY;
+}
+
+const int* PointBuffer::dataY() const
+{
+	return coordinatesY;
+}
+
+int* PointBuffer::dataZ()
+{
+	return coordinatesZ;
+}
+
+const int* PointBuffer::dataZ() const
+{
+	return coordinatesZ;
+}
+
+/*
+ * Translates every point in the buffer by a specified distance along a given axis.
+ *
+ * @param d The distance to translate along the axis.
+ * @param axis The axis along which to translate ('x', 'y', or 'z').
+ * @return 0 if the translation is successful, -1 if the axis is invalid.
+ */
+int PointBuffer::translate(int d, char axis)
+{
+	// Pick the coordinate array once, then update it in a single linear pass.
+	switch (axis)
+	{
+	// If the axis is 'x', adjust every x-coordinate.
+	case 'x':
+		addToEach(coordinatesX, count, d);
+		return 0;
+
+	// If the axis is 'y', adjust every y-coordinate.
+	case 'y':
+		addToEach(coordinatesY, count, d);
+		return 0;
+
+	// If the axis is 'z', adjust every z-coordinate.
+	case 'z':
+		addToEach(coordinatesZ, count, d);
+		return 0;
+
+	// If the axis is invalid, return -1 indicating an error.
+	default:
+		return -1;
+	}
+}
+
+/*
+ * Translates every point in the buffer by an offset on all three axes.
+ *
+ * @param dx The distance to translate along the x-axis.
+ * @param dy The distance to translate along the y-axis.
+ * @param dz The distance to translate along the z-axis.
+ */
+void PointBuffer::translate(int dx, int dy, int dz)
+{
+	// Each array is streamed separately so every pass is a simple contiguous loop.
+	addToEach(coordinatesX, count, dx);
+	addToEach(coordinatesY, count, dy);
+	addToEach(coordinatesZ, count, dz);
+}
+
+/*
+ * Displays the coordinates of the point at the given index in the format (x, y, z).
+ *
+ * @param index The index of the point.
+ */
+void PointBuffer::displayPoint(std::size_t index) const
+{
+	std::cout << "(" << coordinatesX[index] << ", " << coordinatesY[index] << ", " << coordinatesZ[index] << ")\n";
+}
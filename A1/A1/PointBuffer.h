@@ -0,0 +1,251 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef POINTBUFFER_H
+#define POINTBUFFER_H
+
+// Includes the Point.h header file to convert between buffer entries and Point objects.
+#include "Point.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+
+/*
+ * Defines a PointBuffer class that stores many 3D points in a structure-of-arrays layout.
+ * The x, y, and z coordinates live in three separate contiguous and aligned arrays,
+ * so whole-buffer operations such as translation stream through memory in vectorized loops
+ * instead of visiting one heap-allocated Point object at a time.
+ */
+class PointBuffer
+{
+private:
+	// Pointer to the aligned array holding the x-coordinates of all points.
+	int* coordinatesX;
+	// Pointer to the aligned array holding the y-coordinates of all points.
+	int* coordinatesY;
+	// Pointer to the aligned array holding the z-coordinates of all points.
+	int* coordinatesZ;
+	// Number of points currently stored in the buffer.
+	std::size_t count;
+	// Number of points the arrays can hold before they have to grow.
+	std::size_t capacity;
+
+	/*
+	 * Reallocates the three coordinate arrays so they can hold at least the given number of points.
+	 *
+	 * @param newCapacity The minimum number of points the arrays must be able to hold.
+	 */
+	void grow(std::size_t newCapacity);
+
+public:
+	// Alignment in bytes of each coordinate array, wide enough for a full cache line and AVX registers.
+	static const std::size_t ALIGNMENT = 64;
+
+	/*
+	 * Default constructor for the PointBuffer class.
+	 * Creates an empty buffer without allocating any memory.
+	 */
+	PointBuffer();
+
+	/*
+	 * Constructor that creates an empty buffer with room for a number of points.
+	 *
+	 * @param initialCapacity The number of points to reserve space for.
+	 */
+	explicit PointBuffer(std::size_t initialCapacity);
+
+	/*
+	 * Copy constructor that duplicates the coordinates of another buffer.
+	 *
+	 * @param other The buffer to copy from.
+	 */
+	PointBuffer(const PointBuffer& other);
+
+	/*
+	 * Move constructor that takes over the arrays of another buffer.
+	 *
+	 * @param other The buffer to move from. It is left empty.
+	 */
+	PointBuffer(PointBuffer&& other) noexcept;
+
+	/*
+	 * Copy assignment operator that replaces the contents with a copy of another buffer.
+	 *
+	 * @param other The buffer to copy from.
+	 * @return A reference to this buffer.
+	 */
+	PointBuffer& operator=(const PointBuffer& other);
+
+	/*
+	 * Move assignment operator that takes over the arrays of another buffer.
+	 *
+	 * @param other The buffer to move from. It is left empty.
+	 * @return A reference to this buffer.
+	 */
+	PointBuffer& operator=(PointBuffer&& other) noexcept;
+
+	/*
+	 * Destructor for the PointBuffer class.
+	 * It frees the three aligned coordinate arrays.
+	 */
+	~PointBuffer();
+
+	/*
+	 * Returns the number of points stored in the buffer.
+	 *
+	 * @return The number of points.
+	 */
+	std::size_t size() const;
+
+	/*
+	 * Returns the number of points the buffer can hold without reallocating.
+	 *
+	 * @return The capacity of the buffer.
+	 */
+	std::size_t getCapacity() const;
+
+	/*
+	 * Makes sure the buffer can hold at least the given number of points without reallocating.
+	 *
+	 * @param newCapacity The number of points to reserve space for.
+	 */
+	void reserve(std::size_t newCapacity);
+
+	/*
+	 * Changes the number of points in the buffer. New points are placed at the origin.
+	 *
+	 * @param newSize The new number of points.
+	 */
+	void resize(std::size_t newSize);
+
+	/*
+	 * Removes all points from the buffer while keeping its memory.
+	 */
+	void clear();
+
+	/*
+	 * Appends a point to the end of the buffer.
+	 *
+	 * @param x The x-coordinate of the new point.
+	 * @param y The y-coordinate of the new point.
+	 * @param z The z-coordinate of the new point.
+	 * @return The index of the new point.
+	 */
+	std::size_t addPoint(int x, int y, int z);
+
+	/*
+	 * Appends a copy of an existing Point to the end of the buffer.
+	 *
+	 * @param point The point to copy.
+	 * @return The index of the new point.
+	 */
+	std::size_t addPoint(const Point& point);
+
+	/*
+	 * Overwrites the coordinates of the point at the given index.
+	 *
+	 * @param index The index of the point to change.
+	 * @param x The new x-coordinate.
+	 * @param y The new y-coordinate.
+	 * @param z The new z-coordinate.
+	 */
+	void setPoint(std::size_t index, int x, int y, int z);
+
+	/*
+	 * Builds a Point object from the coordinates stored at the given index.
+	 *
+	 * @param index The index of the point.
+	 * @return A Point holding the same coordinates.
+	 */
+	Point getPoint(std::size_t index) const;
+
+	/*
+	 * Getter for the x-coordinate of the point at the given index.
+	 *
+	 * @param index The index of the point.
+	 * @return The x-coordinate.
+	 */
+	int getCoordinateX(std::size_t index) const;
+	/*
+	 * Getter for the y-coordinate of the point at the given index.
+	 *
+	 * @param index The index of the point.
+	 * @return The y-coordinate.
+	 */
+	int getCoordinateY(std::size_t index) const;
+	/*
+	 * Getter for the z-coordinate of the point at the given index.
+	 *
+	 * @param index The index of the point.
+	 * @return The z-coordinate.
+	 */
+	int getCoordinateZ(std::size_t index) const;
+
+	/*
+	 * Direct access to the contiguous x-coordinate array, for kernels that process the whole buffer.
+	 *
+	 * @return A pointer to the first x-coordinate.
+	 */
+	int* dataX();
+	const int* dataX() const;
+	/*
+	 * Direct access to the contiguous y-coordinate array.
+	 *
+	 * @return A pointer to the first y-coordinate.
+	 */
+	int* dataY();
+	const int* dataY() const;
+	/*
+	 * Direct access to the contiguous z-coordinate array.
+	 *
+	 * @return A pointer to the first z-coordinate.
+	 */
+	int* dataZ();
+	const int* dataZ() const;
+
+	/*
+	 * Translates every point in the buffer by a specified distance along a given axis.
+	 * The axis is checked once for the whole buffer, then a single linear pass updates one array.
+	 *
+	 * @param d The distance by which to translate the points.
+	 * @param axis The axis along which to translate ('x', 'y', or 'z').
+	 * @return 0 if successful, -1 if the axis is invalid.
+	 */
+	int translate(int d, char axis);
+
+	/*
+	 * Translates every point in the buffer by an offset on all three axes at once.
+	 *
+	 * @param dx The distance to translate along the x-axis.
+	 * @param dy The distance to translate along the y-axis.
+	 * @param dz The distance to translate along the z-axis.
+	 */
+	void translate(int dx, int dy, int dz);
+
+	/*
+	 * Translates every point in the buffer along an axis chosen at compile time.
+	 * The coordinate array is picked by the compiler, so the loop has no branch and no error code.
+	 *
+	 * @param d The distance by which to translate the points.
+	 */
+	template <Axis A>
+	void translate(int d)
+	{
+		static_assert(A != Axis::W, "PointBuffer stores 3D points");
+		// Pick the array for the axis; the condition is a compile-time constant.
+		int* values = A == Axis::X ? coordinatesX : A == Axis::Y ? coordinatesY : coordinatesZ;
+		// Update every point in one linear, vectorizable pass.
+		for (std::size_t i = 0; i < count; i++)
+		{
+			values[i] += d;
+		}
+	}
+
+	/*
+	 * Displays the coordinates of the point at the given index in the format (x, y, z).
+	 *
+	 * @param index The index of the point.
+	 */
+	void displayPoint(std::size_t index) const;
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -0,0 +1,596 @@
+// Includes the SessionLog.h header file for function declarations.
+#include "SessionLog.h"
+// Includes the MappedFile.h header file to read the snapshot and the log without copying them.
+#include "MappedFile.h"
+
+// Includes the cstring library to compare file signatures.
+#include <cstring>
+// Includes the filesystem library to cut a damaged record off the end of the log.
+#include <filesystem>
+// Includes the system call to replace the snapshot file in one step on Windows.
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+// Signature at the start of every log file.
+static const char LOG_SIGNATURE[8] = { 'A', '1', 'W', 'A', 'L', '0', '0', '1' };
+// Signature at the start of every snapshot file.
+static const char SNAPSHOT_SIGNATURE[8] = { 'A', '1', 'S', 'N', 'A', 'P', '0', '1' };
+// Size of the fixed part of a snapshot: the signature, the sequence number, and three counts.
+static const std::size_t SNAPSHOT_HEADER_SIZE = 8 + 8 + 4 + 4 + 4;
+// Size of one triangle in a snapshot: its slot index and nine coordinates.
+static const std::size_t SNAPSHOT_TRIANGLE_SIZE = 4 + 9 * 4;
+// Size of each kind of log record, including the 4-byte checksum at its end.
+static const std::size_t CREATE_RECORD_SIZE = 1 + 8 + 8 + 9 * 4 + 4;
+static const std::size_t TRANSLATE_RECORD_SIZE = 1 + 8 + 1 + 8 + 4 + 1 + 4;
+static const std::size_t ERASE_RECORD_SIZE = 1 + 8 + 1 + 8 + 4;
+// Default number of records between snapshots.
+static const std::uint64_t DEFAULT_SNAPSHOT_INTERVAL = 100000;
+
+/*
+ * Stores a 32-bit value in little-endian order, so the files are the same on every platform.
+ *
+ * @param bytes Where to store the value.
+ * @param value The value to store.
+ */
+static void putU32(unsigned char* bytes, std::uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+	}
+}
+
+/*
+ * Stores a 64-bit value in little-endian order.
+ *
+ * @param bytes Where to store the value.
+ * @param value The value to store.
+ */
+static void putU64(unsigned char* bytes, std::uint64_t value)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+	}
+}
+
+/*
+ * Reads a little-endian 32-bit value.
+ *
+ * @param bytes The address of the value.
+ * @return The value.
+ */
+static std::uint32_t getU32(const unsigned char* bytes)
+{
+	std::uint32_t value = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		value |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+	}
+	return value;
+}
+
+/*
+ * Reads a little-endian 64-bit value.
+ *
+ * @param bytes The address of the value.
+ * @return The value.
+ */
+static std::uint64_t getU64(const unsigned char* bytes)
+{
+	std::uint64_t value = 0;
+	for (int i = 0; i < 8; i++)
+	{
+		value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+	}
+	return value;
+}
+
+/*
+ * Continues a 32-bit FNV-1a checksum over more bytes. Start with 2166136261.
+ *
+ * @param hash The checksum of the bytes before.
+ * @param bytes The bytes to add.
+ * @param size The number of bytes.
+ * @return The checksum including the new bytes.
+ */
+static std::uint32_t checksum(std::uint32_t hash, const unsigned char* bytes, std::size_t size)
+{
+	for (std::size_t i = 0; i < size; i++)
+	{
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+	return hash;
+}
+
+/*
+ * Decodes one log record and checks its checksum.
+ *
+ * @param bytes The start of the record.
+ * @param available The number of bytes left in the log.
+ * @param record Receives the decoded record.
+ * @return The size of the record, or 0 if it is cut short, of an unknown kind, or damaged.
+ */
+static std::size_t decodeRecord(const unsigned char* bytes, std::size_t available, SessionRecord& record)
+{
+	if (available < 1)
+	{
+		return 0;
+	}
+
+	// The kind of the record gives its size.
+	std::size_t size;
+	switch (bytes[0])
+	{
+	case SessionRecord::Create:
+		size = CREATE_RECORD_SIZE;
+		break;
+	case SessionRecord::Translate:
+		size = TRANSLATE_RECORD_SIZE;
+		break;
+	case SessionRecord::Erase:
+		size = ERASE_RECORD_SIZE;
+		break;
+	default:
+		return 0;
+	}
+	if (available < size || getU32(bytes + size - 4) != checksum(2166136261u, bytes, size - 4))
+	{
+		return 0;
+	}
+
+	// Decode the fields; every kind starts with the sequence number.
+	record = SessionRecord();
+	record.type = static_cast<SessionRecord::Type>(bytes[0]);
+	record.sequence = getU64(bytes + 1);
+	const unsigned char* fields = bytes + 9;
+	if (record.type == SessionRecord::Create)
+	{
+		record.handle = SlotHandle{ getU32(fields), getU32(fields + 4) };
+		for (int i = 0; i < 9; i++)
+		{
+			record.coordinates[i] = static_cast<int>(getU32(fields + 8 + i * 4));
+		}
+	}
+	else
+	{
+		record.all = fields[0] != 0;
+		record.handle = SlotHandle{ getU32(fields + 1), getU32(fields + 5) };
+		if (record.type == SessionRecord::Translate)
+		{
+			record.distance = static_cast<int>(getU32(fields + 9));
+			record.axis = static_cast<char>(fields[13]);
+		}
+	}
+	return size;
+}
+
+/*
+ * Default constructor for the SessionLog class.
+ * Creates a log that is not attached to any files yet.
+ */
+SessionLog::SessionLog() : logFile(nullptr), sequence(0), recordsSinceSnapshot(0), snapshotInterval(DEFAULT_SNAPSHOT_INTERVAL)
+{
+	// Constructor body is empty since initialization is done in the initialization list.
+}
+
+/*
+ * Destructor for the SessionLog class.
+ * It flushes and closes the log file.
+ */
+SessionLog::~SessionLog()
+{
+	close();
+}
+
+/*
+ * Rebuilds a saved scene and opens its log for new records.
+ *
+ * @param basePath The path of the session files without their extensions.
+ * @param restoreSlots Restores the slot table of the scene.
+ * @param apply Applies one change to the scene.
+ * @param replayed Receives the number of log records that were replayed.
+ * @return 0 if successful, -1 if a file is damaged or could not be opened.
+ */
+int SessionLog::open(const std::string& basePath,
+	const std::function<bool(const std::vector<std::uint32_t>&, const std::vector<std::uint32_t>&)>& restoreSlots,
+	const std::function<bool(const SessionRecord&)>& apply, std::uint64_t& replayed)
+{
+	close();
+	logPath = basePath + ".wal";
+	snapshotPath = basePath + ".snap";
+	sequence = 0;
+	replayed = 0;
+
+	// Load the snapshot if there is one; a missing snapshot simply means an empty scene.
+	MappedFile file;
+	if (std::filesystem::exists(snapshotPath))
+	{
+		if (!file.open(snapshotPath.c_str()))
+		{
+			return -1;
+		}
+		const unsigned char* bytes = file.data();
+		std::size_t size = file.size();
+
+		// Check the signature, the size implied by the counts, and the checksum before trusting anything.
+		if (size < SNAPSHOT_HEADER_SIZE + 4 || std::memcmp(bytes, SNAPSHOT_SIGNATURE, 8) != 0)
+		{
+			return -1;
+		}
+		std::uint64_t slotCount = getU32(bytes + 16);
+		std::uint64_t freeCount = getU32(bytes + 20);
+		std::uint64_t liveCount = getU32(bytes + 24);
+		if (size != SNAPSHOT_HEADER_SIZE + slotCount * 4 + freeCount * 4 + liveCount * SNAPSHOT_TRIANGLE_SIZE + 4
+			|| getU32(bytes + size - 4) != checksum(2166136261u, bytes, size - 4))
+		{
+			return -1;
+		}
+
+		// Restore the slot table, so the triangles get back their old handles.
+		std::vector<std::uint32_t> generations(static_cast<std::size_t>(slotCount));
+		std::vector<std::uint32_t> freeList(static_cast<std::size_t>(freeCount));
+		const unsigned char* cursor = bytes + SNAPSHOT_HEADER_SIZE;
+		for (std::size_t i = 0; i < generations.size(); i++, cursor += 4)
+		{
+			generations[i] = getU32(cursor);
+		}
+		for (std::size_t i = 0; i < freeList.size(); i++, cursor += 4)
+		{
+			freeList[i] = getU32(cursor);
+		}
+		if (!restoreSlots(generations, freeList))
+		{
+			return -1;
+		}
+
+		// Recreate every triangle under its saved handle.
+		SessionRecord record = SessionRecord();
+		record.type = SessionRecord::Create;
+		for (std::uint64_t i = 0; i < liveCount; i++, cursor += SNAPSHOT_TRIANGLE_SIZE)
+		{
+			std::uint32_t index = getU32(cursor);
+			if (index >= slotCount)
+			{
+				return -1;
+			}
+			record.handle = SlotHandle{ index, generations[index] };
+			for (int k = 0; k < 9; k++)
+			{
+				record.coordinates[k] = static_cast<int>(getU32(cursor + 4 + k * 4));
+			}
+			if (!apply(record))
+			{
+				return -1;
+			}
+		}
+		sequence = getU64(bytes + 8);
+		file.close();
+	}
+
+	// Replay the log records newer than the snapshot.
+	std::uint64_t validEnd = 0;
+	if (std::filesystem::exists(logPath))
+	{
+		if (!file.open(logPath.c_str()))
+		{
+			return -1;
+		}
+		const unsigned char* bytes = file.data();
+		std::size_t size = file.size();
+
+		// A log shorter than its signature was cut off while being created, and is rewritten below.
+		if (size >= sizeof(LOG_SIGNATURE))
+		{
+			if (std::memcmp(bytes, LOG_SIGNATURE, sizeof(LOG_SIGNATURE)) != 0)
+			{
+				return -1;
+			}
+			std::size_t offset = sizeof(LOG_SIGNATURE);
+			SessionRecord record;
+			// Stop at the first damaged record: it is where the program stopped while writing.
+			for (std::size_t recordSize; (recordSize = decodeRecord(bytes + offset, size - offset, record)) != 0; offset += recordSize)
+			{
+				// Records already contained in the snapshot are skipped.
+				if (record.sequence <= sequence)
+				{
+					continue;
+				}
+				// A missing sequence number means records were lost, and replaying past it would build the wrong scene.
+				if (record.sequence != sequence + 1 || !apply(record))
+				{
+					return -1;
+				}
+				sequence = record.sequence;
+				replayed++;
+			}
+			validEnd = offset;
+		}
+		file.close();
+	}
+
+	// Cut off a damaged last record so new records follow the last good one.
+	if (validEnd == 0)
+	{
+		if (!resetLog())
+		{
+			return -1;
+		}
+	}
+	else
+	{
+		std::error_code error;
+		std::filesystem::resize_file(logPath, validEnd, error);
+		logFile = error ? nullptr : std::fopen(logPath.c_str(), "ab");
+		if (logFile == nullptr)
+		{
+			return -1;
+		}
+	}
+	recordsSinceSnapshot = replayed;
+	return 0;
+}
+
+/*
+ * Flushes and closes the log. Does nothing if no session is open.
+ */
+void SessionLog::close()
+{
+	if (logFile != nullptr)
+	{
+		std::fclose(logFile);
+		logFile = nullptr;
+	}
+}
+
+/*
+ * Checks whether a session is open.
+ *
+ * @return True if changes are being logged.
+ */
+bool SessionLog::isOpen() const
+{
+	return logFile != nullptr;
+}
+
+/*
+ * Appends one encoded record to the log, adding its checksum.
+ *
+ * @param bytes The record without its checksum, with 4 bytes of room after it.
+ * @param size The number of bytes in the record.
+ */
+void SessionLog::append(unsigned char* bytes, std::size_t size)
+{
+	putU32(bytes + size, checksum(2166136261u, bytes, size));
+	std::fwrite(bytes, 1, size + 4, logFile);
+	recordsSinceSnapshot++;
+}
+
+/*
+ * Appends the creation of a triangle to the log.
+ *
+ * @param handle The handle of the new triangle.
+ * @param coordinates The nine vertex coordinates of the triangle.
+ */
+void SessionLog::logCreate(SlotHandle handle, const int coordinates[9])
+{
+	if (logFile == nullptr)
+	{
+		return;
+	}
+	unsigned char bytes[CREATE_RECORD_SIZE];
+	bytes[0] = SessionRecord::Create;
+	putU64(bytes + 1, ++sequence);
+	putU32(bytes + 9, handle.index);
+	putU32(bytes + 13, handle.generation);
+	for (int i = 0; i < 9; i++)
+	{
+		putU32(bytes + 17 + i * 4, static_cast<std::uint32_t>(coordinates[i]));
+	}
+	append(bytes, CREATE_RECORD_SIZE - 4);
+}
+
+/*
+ * Appends a translation of one triangle or the whole scene to the log.
+ *
+ * @param handle The handle of the translated triangle.
+ * @param all Whether the whole scene was translated.
+ * @param distance The distance of the translation.
+ * @param axis The axis of the translation.
+ */
+void SessionLog::logTranslate(SlotHandle handle, bool all, int distance, char axis)
+{
+	if (logFile == nullptr)
+	{
+		return;
+	}
+	unsigned char bytes[TRANSLATE_RECORD_SIZE];
+	bytes[0] = SessionRecord::Translate;
+	putU64(bytes + 1, ++sequence);
+	bytes[9] = all ? 1 : 0;
+	putU32(bytes + 10, handle.index);
+	putU32(bytes + 14, handle.generation);
+	putU32(bytes + 18, static_cast<std::uint32_t>(distance));
+	bytes[22] = static_cast<unsigned char>(axis);
+	append(bytes, TRANSLATE_RECORD_SIZE - 4);
+}
+
+/*
+ * Appends the deletion of one triangle or the whole scene to the log.
+ *
+ * @param handle The handle of the deleted triangle.
+ * @param all Whether the whole scene was deleted.
+ */
+void SessionLog::logErase(SlotHandle handle, bool all)
+{
+	if (logFile == nullptr)
+	{
+		return;
+	}
+	unsigned char bytes[ERASE_RECORD_SIZE];
+	bytes[0] = SessionRecord::Erase;
+	putU64(bytes + 1, ++sequence);
+	bytes[9] = all ? 1 : 0;
+	putU32(bytes + 10, handle.index);
+	putU32(bytes + 14, handle.generation);
+	append(bytes, ERASE_RECORD_SIZE - 4);
+}
+
+/*
+ * Hands the buffered records to the operating system.
+ */
+void SessionLog::flush()
+{
+	if (logFile != nullptr)
+	{
+		std::fflush(logFile);
+	}
+}
+
+/*
+ * Checks whether a snapshot is due.
+ *
+ * @return True if enough records have been logged since the last snapshot.
+ */
+bool SessionLog::shouldSnapshot() const
+{
+	return logFile != nullptr && recordsSinceSnapshot >= snapshotInterval;
+}
+
+/*
+ * Sets how many records may be logged before shouldSnapshot() asks for a snapshot.
+ *
+ * @param records The number of records between snapshots.
+ */
+void SessionLog::setSnapshotInterval(std::uint64_t records)
+{
+	snapshotInterval = records;
+}
+
+/*
+ * Empties the log file, leaving only its header.
+ *
+ * @return True if successful, false if the file could not be rewritten.
+ */
+bool SessionLog::resetLog()
+{
+	close();
+	logFile = std::fopen(logPath.c_str(), "wb");
+	if (logFile == nullptr)
+	{
+		return false;
+	}
+	std::fwrite(LOG_SIGNATURE, 1, sizeof(LOG_SIGNATURE), logFile);
+	std::fflush(logFile);
+	recordsSinceSnapshot = 0;
+	return true;
+}
+
+/*
+ * Writes the whole scene to the snapshot file and empties the log.
+ *
+ * @param scene The scene to save.
+ * @return 0 if successful, -1 if the snapshot could not be written.
+ */
+int SessionLog::writeSnapshot(const SlotMap<Triangle>& scene)
+{
+	if (logFile == nullptr)
+	{
+		return -1;
+	}
+	// Everything logged so far goes into the snapshot, so the log must reach the disk in full first.
+	std::fflush(logFile);
+
+	std::string temporaryPath = snapshotPath + ".tmp";
+	std::FILE* snapshot = std::fopen(temporaryPath.c_str(), "wb");
+	if (snapshot == nullptr)
+	{
+		return -1;
+	}
+
+	// Collect the slot table so handles can be restored exactly.
+	std::vector<std::uint32_t> generations;
+	std::vector<std::uint32_t> freeList;
+	scene.exportSlots(generations, freeList);
+
+	// Write the file through a buffer, computing the checksum on the way.
+	std::vector<unsigned char> buffer;
+	buffer.reserve(1 << 16);
+	std::uint32_t hash = 2166136261u;
+	bool written = true;
+	auto drain = [&]()
+	{
+		hash = checksum(hash, buffer.data(), buffer.size());
+		written = written && std::fwrite(buffer.data(), 1, buffer.size(), snapshot) == buffer.size();
+		buffer.clear();
+	};
+	auto put32 = [&](std::uint32_t value)
+	{
+		unsigned char bytes[4];
+		putU32(bytes, value);
+		buffer.insert(buffer.end(), bytes, bytes + 4);
+		if (buffer.size() >= (1 << 16) - 64)
+		{
+			drain();
+		}
+	};
+
+	// The header: signature, sequence number of the last change included, and the counts.
+	buffer.insert(buffer.end(), SNAPSHOT_SIGNATURE, SNAPSHOT_SIGNATURE + 8);
+	put32(static_cast<std::uint32_t>(sequence));
+	put32(static_cast<std::uint32_t>(sequence >> 32));
+	put32(static_cast<std::uint32_t>(generations.size()));
+	put32(static_cast<std::uint32_t>(freeList.size()));
+	put32(static_cast<std::uint32_t>(scene.size()));
+
+	// The slot table, then each triangle with its slot index.
+	for (std::size_t i = 0; i < generations.size(); i++)
+	{
+		put32(generations[i]);
+	}
+	for (std::size_t i = 0; i < freeList.size(); i++)
+	{
+		put32(freeList[i]);
+	}
+	for (std::size_t i = 0; i < scene.size(); i++)
+	{
+		put32(scene.handleAt(i).index);
+		for (int vertex = 1; vertex <= 3; vertex++)
+		{
+			const Point* point = scene.data()[i].getVertex(vertex);
+			put32(static_cast<std::uint32_t>(point->getCoordinateX()));
+			put32(static_cast<std::uint32_t>(point->getCoordinateY()));
+			put32(static_cast<std::uint32_t>(point->getCoordinateZ()));
+		}
+	}
+
+	// Close the file with the checksum of everything before it.
+	drain();
+	unsigned char bytes[4];
+	putU32(bytes, hash);
+	written = written && std::fwrite(bytes, 1, 4, snapshot) == 4;
+	written = std::fclose(snapshot) == 0 && written;
+	if (!written)
+	{
+		std::remove(temporaryPath.c_str());
+		return -1;
+	}
+
+	// Replace the old snapshot in one step, so there is always one complete snapshot on disk.
+#ifdef _WIN32
+	bool renamed = MoveFileExA(temporaryPath.c_str(), snapshotPath.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	bool renamed = std::rename(temporaryPath.c_str(), snapshotPath.c_str()) == 0;
+#endif
+	if (!renamed)
+	{
+		std::remove(temporaryPath.c_str());
+		return -1;
+	}
+
+	// The snapshot holds every logged change, so the log can start over.
+	// If the program stops before this, recovery skips the records the snapshot already holds.
+	return resetLog() ? 0 : -1;
+}
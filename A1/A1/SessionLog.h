@@ -0,0 +1,191 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef SESSIONLOG_H
+#define SESSIONLOG_H
+
+// Includes the SlotMap.h header file for the scene handles stored in the log.
+#include "SlotMap.h"
+// Includes the Triangle.h header file to save the triangles of a scene.
+#include "Triangle.h"
+
+// Includes the cstdint library for the fixed-width fields of the file formats.
+#include <cstdint>
+// Includes the cstdio library for buffered file output.
+#include <cstdio>
+// Includes the functional library for the callbacks that rebuild a scene during recovery.
+#include <functional>
+// Includes the string library for file paths.
+#include <string>
+// Includes the vector library for the saved slot table.
+#include <vector>
+
+/*
+ * One change to a scene, as stored in the write-ahead log.
+ */
+struct SessionRecord
+{
+	/*
+	 * Lists the kinds of change.
+	 */
+	enum Type : std::uint8_t
+	{
+		Create = 1,
+		Translate = 2,
+		Erase = 3
+	};
+
+	// The kind of change.
+	Type type;
+	// Position of the change in the session; every change gets the next number.
+	std::uint64_t sequence;
+	// The triangle the change applies to; ignored when all is true.
+	SlotHandle handle;
+	// Whether a translate or erase applies to the whole scene.
+	bool all;
+	// The nine vertex coordinates of a created triangle.
+	int coordinates[9];
+	// The distance of a translation.
+	int distance;
+	// The axis of a translation ('x', 'y', or 'z').
+	char axis;
+};
+
+/*
+ * Defines a SessionLog class that makes a Driver scene survive restarts.
+ * Every change is appended to a compact binary write-ahead log (base path + ".wal"). From time to time the whole
+ * scene is written to a snapshot (base path + ".snap") and the log is emptied. Recovery memory-maps the snapshot,
+ * rebuilds the scene with the same handles, and replays only the log records newer than the snapshot.
+ * Each record carries a checksum, so a record torn by a crash ends the replay instead of corrupting the scene.
+ */
+class SessionLog
+{
+private:
+	// Path of the write-ahead log file.
+	std::string logPath;
+	// Path of the snapshot file.
+	std::string snapshotPath;
+	// The open log file, or nullptr if no session is open.
+	std::FILE* logFile;
+	// Sequence number of the last change written to the log or contained in the snapshot.
+	std::uint64_t sequence;
+	// Number of records appended since the last snapshot.
+	std::uint64_t recordsSinceSnapshot;
+	// Number of records after which shouldSnapshot() asks for a new snapshot.
+	std::uint64_t snapshotInterval;
+
+	/*
+	 * Appends one encoded record to the log.
+	 *
+	 * @param bytes The record without its checksum.
+	 * @param size The number of bytes in the record.
+	 */
+	void append(unsigned char* bytes, std::size_t size);
+
+	/*
+	 * Empties the log file, leaving only its header.
+	 *
+	 * @return True if successful, false if the file could not be rewritten.
+	 */
+	bool resetLog();
+
+public:
+	/*
+	 * Default constructor for the SessionLog class.
+	 * Creates a log that is not attached to any files yet.
+	 */
+	SessionLog();
+
+	/*
+	 * Destructor for the SessionLog class.
+	 * It flushes and closes the log file.
+	 */
+	~SessionLog();
+
+	// The log owns an open file, so it cannot be copied.
+	SessionLog(const SessionLog&) = delete;
+	SessionLog& operator=(const SessionLog&) = delete;
+
+	/*
+	 * Rebuilds a saved scene and opens its log for new records.
+	 * The snapshot, if there is one, is memory-mapped; restoreSlots is called once with its slot table, then
+	 * apply is called with a Create record for each triangle in it, followed by the log records newer than the snapshot.
+	 * A damaged record at the end of the log, left by a crash, is cut off so new records follow the last good one.
+	 *
+	 * @param basePath The path of the session files without their extensions.
+	 * @param restoreSlots Restores the slot table of the scene; returns false if the table is invalid.
+	 * @param apply Applies one change to the scene; returns false if it does not fit the scene.
+	 * @param replayed Receives the number of log records that were replayed.
+	 * @return 0 if successful, -1 if a file is damaged or could not be opened.
+	 */
+	int open(const std::string& basePath,
+		const std::function<bool(const std::vector<std::uint32_t>&, const std::vector<std::uint32_t>&)>& restoreSlots,
+		const std::function<bool(const SessionRecord&)>& apply, std::uint64_t& replayed);
+
+	/*
+	 * Flushes and closes the log. Does nothing if no session is open.
+	 */
+	void close();
+
+	/*
+	 * Checks whether a session is open.
+	 *
+	 * @return True if changes are being logged.
+	 */
+	bool isOpen() const;
+
+	/*
+	 * Appends the creation of a triangle to the log.
+	 *
+	 * @param handle The handle of the new triangle.
+	 * @param coordinates The nine vertex coordinates of the triangle.
+	 */
+	void logCreate(SlotHandle handle, const int coordinates[9]);
+
+	/*
+	 * Appends a translation of one triangle or the whole scene to the log.
+	 *
+	 * @param handle The handle of the translated triangle.
+	 * @param all Whether the whole scene was translated.
+	 * @param distance The distance of the translation.
+	 * @param axis The axis of the translation ('x', 'y', or 'z').
+	 */
+	void logTranslate(SlotHandle handle, bool all, int distance, char axis);
+
+	/*
+	 * Appends the deletion of one triangle or the whole scene to the log.
+	 *
+	 * @param handle The handle of the deleted triangle.
+	 * @param all Whether the whole scene was deleted.
+	 */
+	void logErase(SlotHandle handle, bool all);
+
+	/*
+	 * Hands the buffered records to the operating system, so they survive the program crashing.
+	 */
+	void flush();
+
+	/*
+	 * Checks whether enough records have been logged since the last snapshot that a new one should be written.
+	 *
+	 * @return True if a snapshot is due.
+	 */
+	bool shouldSnapshot() const;
+
+	/*
+	 * Sets how many records may be logged before shouldSnapshot() asks for a snapshot.
+	 *
+	 * @param records The number of records between snapshots.
+	 */
+	void setSnapshotInterval(std::uint64_t records);
+
+	/*
+	 * Writes the whole scene to the snapshot file and empties the log.
+	 * The snapshot is written to a temporary file first and then renamed, so a crash never leaves a partial snapshot.
+	 *
+	 * @param scene The scene to save.
+	 * @return 0 if successful, -1 if the snapshot could not be written, in which case the log is kept.
+	 */
+	int writeSnapshot(const SlotMap<Triangle>& scene);
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -0,0 +1,421 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the cstdint library for the 32-bit slot indices and generations.
+#include <cstdint>
+// Includes the utility library for std::move and std::forward.
+#include <utility>
+// Includes the vector library for the dense values and the slot table.
+#include <vector>
+
+/*
+ * Identifies one value stored in a SlotMap. A handle stays valid until its value is erased, and
+ * a handle to an erased value is recognized as stale even after the slot has been reused,
+ * because every reuse gives the slot a new generation.
+ */
+struct SlotHandle
+{
+	// Index of the slot in the slot table.
+	std::uint32_t index;
+	// Generation of the slot when the value was inserted. Live generations are odd, so {0, 0} is never valid.
+	std::uint32_t generation;
+
+	/*
+	 * Checks whether two handles refer to the same value.
+	 *
+	 * @param other The handle to compare with.
+	 * @return True if both the index and the generation are equal.
+	 */
+	bool operator==(const SlotHandle& other) const
+	{
+		return index == other.index && generation == other.generation;
+	}
+
+	/*
+	 * Checks whether two handles refer to different values.
+	 *
+	 * @param other The handle to compare with.
+	 * @return True if the index or the generation differs.
+	 */
+	bool operator!=(const SlotHandle& other) const
+	{
+		return !(*this == other);
+	}
+};
+
+/*
+ * Defines a SlotMap class template that stores values contiguously and hands out stable handles to them.
+ * Insert, erase, and lookup all take constant time. Values are kept packed at the front of one array,
+ * so loops over every value stream through memory; erasing moves the last value into the hole.
+ * Pointers to values are therefore only valid until the next insert or erase, while handles stay valid.
+ */
+template <typename T>
+class SlotMap
+{
+private:
+	/*
+	 * One entry of the slot table.
+	 */
+	struct Slot
+	{
+		// Incremented on every insert and erase, so it is odd while the slot holds a value.
+		std::uint32_t generation;
+		// Position of the value in the dense array while the slot is live, or the next free slot while it is free.
+		std::uint32_t position;
+	};
+
+	// Marks the end of the free slot list.
+	static const std::uint32_t NO_SLOT = 0xFFFFFFFFu;
+	// Marks a free slot that is kept out of the free list, waiting to be filled by emplaceAt.
+	static const std::uint32_t RESERVED_SLOT = 0xFFFFFFFEu;
+
+	// The values, packed without gaps.
+	std::vector<T> values;
+	// Slot index of each value, so erasing can fix the slot of the value that fills the hole.
+	std::vector<std::uint32_t> valueSlots;
+	// The slot table indexed by SlotHandle::index.
+	std::vector<Slot> slots;
+	// First slot of the free list, or NO_SLOT if every slot is live.
+	std::uint32_t freeSlot;
+
+	/*
+	 * Finds the slot of a handle if it still refers to a live value.
+	 *
+	 * @param handle The handle to look up.
+	 * @return A pointer to the slot, or nullptr if the handle is stale or was never valid.
+	 */
+	const Slot* findSlot(SlotHandle handle) const
+	{
+		if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation || (handle.generation & 1) == 0)
+		{
+			return nullptr;
+		}
+		return &slots[handle.index];
+	}
+
+public:
+	/*
+	 * Default constructor for the SlotMap class.
+	 * Creates an empty map without allocating any memory.
+	 */
+	SlotMap() : freeSlot(NO_SLOT)
+	{
+		// Constructor body is empty since the arrays are default constructed.
+	}
+
+	/*
+	 * Reserves memory for a number of values.
+	 *
+	 * @param capacity The number of values to reserve space for.
+	 */
+	void reserve(std::size_t capacity)
+	{
+		values.reserve(capacity);
+		valueSlots.reserve(capacity);
+		slots.reserve(capacity);
+	}
+
+	/*
+	 * Constructs a new value in the map.
+	 *
+	 * @param args The arguments passed to the constructor of T.
+	 * @return The handle of the new value.
+	 */
+	template <typename... Args>
+	SlotHandle emplace(Args&&... args)
+	{
+		// Reuse a free slot if there is one, otherwise add a new slot.
+		std::uint32_t index;
+		if (freeSlot != NO_SLOT)
+		{
+			index = freeSlot;
+			freeSlot = slots[index].position;
+		}
+		else
+		{
+			index = static_cast<std::uint32_t>(slots.size());
+			slots.push_back(Slot{ 0, NO_SLOT });
+		}
+
+		// Append the value to the dense array and point the slot at it.
+		values.emplace_back(std::forward<Args>(args)...);
+		valueSlots.push_back(index);
+		slots[index].generation++;
+		slots[index].position = static_cast<std::uint32_t>(values.size() - 1);
+		return SlotHandle{ index, slots[index].generation };
+	}
+
+	/*
+	 * Constructs a new value under a given handle, such as a handle read back from a saved session.
+	 * The slot must be free and the handle's generation must be live (odd). New slots are added as needed.
+	 *
+	 * @param handle The handle the value will have.
+	 * @param args The arguments passed to the constructor of T.
+	 * @return True if the value was added, false if the slot is in use or the generation is not a live one.
+	 */
+	template <typename... Args>
+	bool emplaceAt(SlotHandle handle, Args&&... args)
+	{
+		if ((handle.generation & 1) == 0 || handle.index >= RESERVED_SLOT)
+		{
+			return false;
+		}
+
+		// Add the missing slots; the ones before the requested slot join the free list.
+		while (slots.size() < handle.index)
+		{
+			slots.push_back(Slot{ 0, freeSlot });
+			freeSlot = static_cast<std::uint32_t>(slots.size() - 1);
+		}
+		if (slots.size() == handle.index)
+		{
+			slots.push_back(Slot{ 0, RESERVED_SLOT });
+		}
+
+		Slot& slot = slots[handle.index];
+		if ((slot.generation & 1) != 0)
+		{
+			return false;
+		}
+
+		// Take the slot off the free list. Replaying a log reuses slots in the order they were freed,
+		// so the slot is normally the head of the list and the search below is rarely needed.
+		if (freeSlot == handle.index)
+		{
+			freeSlot = slot.position;
+		}
+		else if (slot.position != RESERVED_SLOT)
+		{
+			std::uint32_t previous = freeSlot;
+			while (previous != NO_SLOT && slots[previous].position != handle.index)
+			{
+				previous = slots[previous].position;
+			}
+			if (previous != NO_SLOT)
+			{
+				slots[previous].position = slot.position;
+			}
+		}
+
+		// Append the value to the dense array and point the slot at it.
+		values.emplace_back(std::forward<Args>(args)...);
+		valueSlots.push_back(handle.index);
+		slot.generation = handle.generation;
+		slot.position = static_cast<std::uint32_t>(values.size() - 1);
+		return true;
+	}
+
+	/*
+	 * Copies out the state of the slot table so it can be saved: the generation of every slot,
+	 * and the free slots in the order they will be reused.
+	 *
+	 * @param generations Receives the generation of each slot; live slots have odd generations.
+	 * @param freeList Receives the indices of the free slots, starting with the next one to be reused.
+	 */
+	void exportSlots(std::vector<std::uint32_t>& generations, std::vector<std::uint32_t>& freeList) const
+	{
+		generations.resize(slots.size());
+		for (std::size_t i = 0; i < slots.size(); i++)
+		{
+			generations[i] = slots[i].generation;
+		}
+		freeList.clear();
+		for (std::uint32_t index = freeSlot; index != NO_SLOT; index = slots[index].position)
+		{
+			freeList.push_back(index);
+		}
+	}
+
+	/*
+	 * Empties the map and restores a slot table saved by exportSlots. Slots that were live are left
+	 * reserved, to be filled again with emplaceAt under their saved handles.
+	 *
+	 * @param generations The generation of each slot.
+	 * @param freeList The free slots in the order they will be reused.
+	 * @return True if the table was restored, false if the free list names a live, unknown, or repeated slot.
+	 */
+	bool importSlots(const std::vector<std::uint32_t>& generations, const std::vector<std::uint32_t>& freeList)
+	{
+		values.clear();
+		valueSlots.clear();
+		freeSlot = NO_SLOT;
+
+		// Every slot starts free and reserved; live slots drop back to the generation before their handle.
+		slots.resize(generations.size());
+		for (std::size_t i = 0; i < generations.size(); i++)
+		{
+			slots[i].generation = generations[i] & ~1u;
+			slots[i].position = RESERVED_SLOT;
+		}
+
+		// Link the free list back together, last slot first, so the first entry becomes the head.
+		for (std::size_t i = freeList.size(); i-- > 0;)
+		{
+			std::uint32_t index = freeList[i];
+			if (index >= slots.size() || (generations[index] & 1) != 0 || slots[index].position != RESERVED_SLOT)
+			{
+				slots.clear();
+				freeSlot = NO_SLOT;
+				return false;
+			}
+			slots[index].position = freeSlot;
+			freeSlot = index;
+		}
+		return true;
+	}
+
+	/*
+	 * Moves a value into the map.
+	 *
+	 * @param value The value to insert.
+	 * @return The handle of the new value.
+	 */
+	SlotHandle insert(T&& value)
+	{
+		return emplace(std::move(value));
+	}
+
+	/*
+	 * Removes the value a handle refers to. The handle, and every copy of it, becomes stale.
+	 *
+	 * @param handle The handle of the value to remove.
+	 * @return True if the value was removed, false if the handle was stale.
+	 */
+	bool erase(SlotHandle handle)
+	{
+		if (findSlot(handle) == nullptr)
+		{
+			return false;
+		}
+		Slot& slot = slots[handle.index];
+		std::uint32_t position = slot.position;
+
+		// Fill the hole with the last value so the array stays packed.
+		std::uint32_t last = static_cast<std::uint32_t>(values.size() - 1);
+		if (position != last)
+		{
+			values[position] = std::move(values[last]);
+			valueSlots[position] = valueSlots[last];
+			slots[valueSlots[position]].position = position;
+		}
+		values.pop_back();
+		valueSlots.pop_back();
+
+		// Retire the handle and put the slot on the free list.
+		slot.generation++;
+		slot.position = freeSlot;
+		freeSlot = handle.index;
+		return true;
+	}
+
+	/*
+	 * Removes every value. Every handle handed out so far becomes stale.
+	 */
+	void clear()
+	{
+		while (!values.empty())
+		{
+			erase(handleAt(values.size() - 1));
+		}
+	}
+
+	/*
+	 * Checks whether a handle still refers to a value.
+	 *
+	 * @param handle The handle to check.
+	 * @return True if the value has not been erased.
+	 */
+	bool contains(SlotHandle handle) const
+	{
+		return findSlot(handle) != nullptr;
+	}
+
+	/*
+	 * Looks up the value a handle refers to.
+	 *
+	 * @param handle The handle to look up.
+	 * @return A pointer to the value, or nullptr if the handle is stale. The pointer is valid until the next insert or erase.
+	 */
+	T* get(SlotHandle handle)
+	{
+		const Slot* slot = findSlot(handle);
+		return slot == nullptr ? nullptr : &values[slot->position];
+	}
+	const T* get(SlotHandle handle) const
+	{
+		const Slot* slot = findSlot(handle);
+		return slot == nullptr ? nullptr : &values[slot->position];
+	}
+
+	/*
+	 * Returns the number of values in the map.
+	 *
+	 * @return The number of values.
+	 */
+	std::size_t size() const
+	{
+		return values.size();
+	}
+
+	/*
+	 * Checks whether the map holds no values.
+	 *
+	 * @return True if the map is empty.
+	 */
+	bool empty() const
+	{
+		return values.empty();
+	}
+
+	/*
+	 * Returns the handle of the value at a position in the dense array, for loops over every value.
+	 *
+	 * @param position The position of the value, below size().
+	 * @return The handle of that value.
+	 */
+	SlotHandle handleAt(std::size_t position) const
+	{
+		std::uint32_t index = valueSlots[position];
+		return SlotHandle{ index, slots[index].generation };
+	}
+
+	/*
+	 * Direct access to the packed values, for bulk operations over the whole map.
+	 *
+	 * @return A pointer to the first value.
+	 */
+	T* data()
+	{
+		return values.data();
+	}
+	const T* data() const
+	{
+		return values.data();
+	}
+
+	/*
+	 * Iterators over the packed values, so the map can be used in range-based for loops.
+	 */
+	T* begin()
+	{
+		return values.data();
+	}
+	T* end()
+	{
+		return values.data() + values.size();
+	}
+	const T* begin() const
+	{
+		return values.data();
+	}
+	const T* end() const
+	{
+		return values.data() + values.size();
+	}
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
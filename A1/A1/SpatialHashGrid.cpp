@@ -0,0 +1,658 @@
+// Includes the SpatialHashGrid.h header file for function declarations.
+#include "SpatialHashGrid.h"
+
+// Includes the algorithm library for the heap of nearest candidates.
+#include <algorithm>
+// Includes the climits library for the range of int cell coordinates.
+#include <climits>
+// Includes the cstdlib library for std::llabs.
+#include <cstdlib>
+// Includes the utility library for std::pair.
+#include <utility>
+
+// Smallest hash table, in entries.
+static const std::size_t MIN_TABLE_SIZE = 16;
+
+/*
+ * Divides and rounds toward negative infinity, so cell -1 holds the coordinates just below 0.
+ *
+ * @param value The dividend.
+ * @param divisor The divisor, which must be positive.
+ * @return The quotient rounded down.
+ */
+static long long floorDivide(long long value, long long divisor)
+{
+	long long quotient = value / divisor;
+	return value % divisor != 0 && value < 0 ? quotient - 1 : quotient;
+}
+
+/*
+ * Mixes three cell coordinates into a hash. Each coordinate is multiplied by a different odd constant,
+ * so neighbouring cells land far apart in the table.
+ *
+ * @param x The x cell coordinate.
+ * @param y The y cell coordinate.
+ * @param z The z cell coordinate.
+ * @return The hash.
+ */
+static std::uint64_t hashCell(int x, int y, int z)
+{
+	std::uint64_t hash = static_cast<std::uint32_t>(x) * 0x9E3779B97F4A7C15ull;
+	hash ^= static_cast<std::uint32_t>(y) * 0xC2B2AE3D27D4EB4Full;
+	hash ^= static_cast<std::uint32_t>(z) * 0x165667B19E3779F9ull;
+	return hash ^ (hash >> 29);
+}
+
+/*
+ * Calculates the squared distance between two points exactly. A sum too large for 64 bits,
+ * which needs coordinates more than 2^32 apart, saturates at the largest value.
+ *
+ * @return The squared distance.
+ */
+static std::uint64_t squaredDistance(int ax, int ay, int az, int bx, int by, int bz)
+{
+	const long long differences[3] = { static_cast<long long>(ax) - bx, static_cast<long long>(ay) - by, static_cast<long long>(az) - bz };
+	std::uint64_t sum = 0;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		// A difference of two ints is below 2^32, so its square fits in 64 bits.
+		std::uint64_t magnitude = static_cast<std::uint64_t>(differences[axis] < 0 ? -differences[axis] : differences[axis]);
+		std::uint64_t square = magnitude * magnitude;
+		sum += square;
+		if (sum < square)
+		{
+			return UINT64_MAX;
+		}
+	}
+	return sum;
+}
+
+/*
+ * Constructor for the SpatialHashGrid class.
+ *
+ * @param size The edge length of a cell. Values below 1 are treated as 1.
+ */
+SpatialHashGrid::SpatialHashGrid(int size) : cellSize(size < 1 ? 1 : size), itemCount(0), minCell{ INT_MAX, INT_MAX, INT_MAX }, maxCell{ INT_MIN, INT_MIN, INT_MIN },
+	releasedSinceRange(0)
+{
+	// Constructor body is empty since initialization is done in the initialization list.
+}
+
+/*
+ * Returns the edge length of a cell.
+ *
+ * @return The cell size.
+ */
+int SpatialHashGrid::getCellSize() const
+{
+	return cellSize;
+}
+
+/*
+ * Returns the number of points in the grid.
+ *
+ * @return The number of points.
+ */
+std::size_t SpatialHashGrid::size() const
+{
+	return itemCount;
+}
+
+/*
+ * Removes every point and every cell.
+ */
+void SpatialHashGrid::clear()
+{
+	cells.clear();
+	freeCells.clear();
+	table.clear();
+	items.clear();
+	itemCount = 0;
+	recomputeCellRange();
+}
+
+/*
+ * Finds the cell with the given cell coordinates.
+ *
+ * @param x The x cell coordinate.
+ * @param y The y cell coordinate.
+ * @param z The z cell coordinate.
+ * @return The index of the cell, or NO_CELL if no point is in it.
+ */
+std::uint32_t SpatialHashGrid::findCell(int x, int y, int z) const
+{
+	if (table.empty())
+	{
+		return NO_CELL;
+	}
+
+	// Probe from the cell's home entry until the cell or an empty entry is found.
+	std::size_t mask = table.size() - 1;
+	for (std::size_t entry = hashCell(x, y, z) & mask; table[entry] != NO_CELL; entry = (entry + 1) & mask)
+	{
+		const Cell& cell = cells[table[entry]];
+		if (cell.x == x && cell.y == y && cell.z == z)
+		{
+			return table[entry];
+		}
+	}
+	return NO_CELL;
+}
+
+/*
+ * Returns the number of cells in use.
+ *
+ * @return The number of cells holding at least one point.
+ */
+std::size_t SpatialHashGrid::usedCellCount() const
+{
+	return cells.size() - freeCells.size();
+}
+
+/*
+ * Takes an emptied cell out of the hash table and keeps its index for reuse.
+ *
+ * @param index The index of the cell.
+ */
+void SpatialHashGrid::releaseCell(std::uint32_t index)
+{
+	const Cell& cell = cells[index];
+	std::size_t mask = table.size() - 1;
+	std::size_t hole = hashCell(cell.x, cell.y, cell.z) & mask;
+	while (table[hole] != index)
+	{
+		hole = (hole + 1) & mask;
+	}
+
+	// Close the gap by shifting back later entries of the probe run whose home lies at or before the hole,
+	// so lookups never stop early and the table needs no tombstones.
+	for (std::size_t entry = (hole + 1) & mask; table[entry] != NO_CELL; entry = (entry + 1) & mask)
+	{
+		const Cell& other = cells[table[entry]];
+		std::size_t home = hashCell(other.x, other.y, other.z) & mask;
+		if (((entry - home) & mask) >= ((entry - hole) & mask))
+		{
+			table[hole] = table[entry];
+			hole = entry;
+		}
+	}
+	table[hole] = NO_CELL;
+	freeCells.push_back(index);
+
+	// The range is left as it is, still covering every cell in use. It is recomputed once the releases since the last
+	// recomputation add up to half the cells, so the scan costs a constant amount per release.
+	releasedSinceRange++;
+	if (releasedSinceRange * 2 >= cells.size())
+	{
+		recomputeCellRange();
+	}
+}
+
+/*
+ * Recomputes the range of cell coordinates from the cells in use.
+ */
+void SpatialHashGrid::recomputeCellRange()
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		minCell[axis] = INT_MAX;
+		maxCell[axis] = INT_MIN;
+	}
+	for (std::size_t i = 0; i < cells.size(); i++)
+	{
+		// Unused cells are empty, while every cell in use holds a point.
+		if (cells[i].items.empty())
+		{
+			continue;
+		}
+		const int coordinates[3] = { cells[i].x, cells[i].y, cells[i].z };
+		for (int axis = 0; axis < 3; axis++)
+		{
+			minCell[axis] = std::min(minCell[axis], coordinates[axis]);
+			maxCell[axis] = std::max(maxCell[axis], coordinates[axis]);
+		}
+	}
+	releasedSinceRange = 0;
+}
+
+/*
+ * Finds the cell with the given cell coordinates, creating it if needed.
+ *
+ * @param x The x cell coordinate.
+ * @param y The y cell coordinate.
+ * @param z The z cell coordinate.
+ * @return The index of the cell.
+ */
+std::uint32_t SpatialHashGrid::findOrCreateCell(int x, int y, int z)
+{
+	std::uint32_t found = findCell(x, y, z);
+	if (found != NO_CELL)
+	{
+		return found;
+	}
+
+	// Keep the table at most half full so probe sequences stay short; growing rehashes every cell in use.
+	if ((usedCellCount() + 1) * 2 > table.size())
+	{
+		std::size_t newSize = table.size() < MIN_TABLE_SIZE ? MIN_TABLE_SIZE : table.size() * 2;
+		table.assign(newSize, NO_CELL);
+		for (std::size_t i = 0; i < cells.size(); i++)
+		{
+			// Unused cells are empty, while every cell in use holds a point.
+			if (cells[i].items.empty())
+			{
+				continue;
+			}
+			std::size_t entry = hashCell(cells[i].x, cells[i].y, cells[i].z) & (newSize - 1);
+			while (table[entry] != NO_CELL)
+			{
+				entry = (entry + 1) & (newSize - 1);
+			}
+			table[entry] = static_cast<std::uint32_t>(i);
+		}
+	}
+
+	// Reuse a released cell, whose list keeps its memory, or add one; then put it in the first empty entry of its probe sequence.
+	std::uint32_t index;
+	if (!freeCells.empty())
+	{
+		index = freeCells.back();
+		freeCells.pop_back();
+		cells[index].x = x;
+		cells[index].y = y;
+		cells[index].z = z;
+	}
+	else
+	{
+		index = static_cast<std::uint32_t>(cells.size());
+		cells.push_back(Cell{ x, y, z, std::vector<std::uint32_t>() });
+	}
+	std::size_t mask = table.size() - 1;
+	std::size_t entry = hashCell(x, y, z) & mask;
+	while (table[entry] != NO_CELL)
+	{
+		entry = (entry + 1) & mask;
+	}
+	table[entry] = index;
+
+	// Widen the range of used cells, which ends nearest searches.
+	const int coordinates[3] = { x, y, z };
+	for (int axis = 0; axis < 3; axis++)
+	{
+		minCell[axis] = std::min(minCell[axis], coordinates[axis]);
+		maxCell[axis] = std::max(maxCell[axis], coordinates[axis]);
+	}
+	return index;
+}
+
+/*
+ * Adds a point to the cell containing its coordinates.
+ *
+ * @param id The identifier of the point, whose coordinates are already set.
+ */
+void SpatialHashGrid::link(std::uint32_t id)
+{
+	Item& item = items[id];
+	item.cell = findOrCreateCell(static_cast<int>(floorDivide(item.x, cellSize)), static_cast<int>(floorDivide(item.y, cellSize)),
+		static_cast<int>(floorDivide(item.z, cellSize)));
+	std::vector<std::uint32_t>& list = cells[item.cell].items;
+	item.slot = static_cast<std::uint32_t>(list.size());
+	list.push_back(id);
+}
+
+/*
+ * Removes a point from its cell by moving the last point of the cell into its place, releasing the cell if it empties.
+ *
+ * @param id The identifier of the point.
+ */
+void SpatialHashGrid::unlink(std::uint32_t id)
+{
+	Item& item = items[id];
+	std::vector<std::uint32_t>& list = cells[item.cell].items;
+	std::uint32_t last = list.back();
+	list[item.slot] = last;
+	items[last].slot = item.slot;
+	list.pop_back();
+	if (list.empty())
+	{
+		releaseCell(item.cell);
+	}
+	item.cell = NO_CELL;
+}
+
+/*
+ * Adds a point to the grid.
+ *
+ * @param id The identifier of the point.
+ * @param x The x-coordinate of the point.
+ * @param y The y-coordinate of the point.
+ * @param z The z-coordinate of the point.
+ * @return True if the point was added, false if the identifier is already in the grid.
+ */
+bool SpatialHashGrid::insert(std::uint32_t id, int x, int y, int z)
+{
+	if (contains(id))
+	{
+		return false;
+	}
+	if (id >= items.size())
+	{
+		items.resize(static_cast<std::size_t>(id) + 1, Item{ 0, 0, 0, NO_CELL, 0 });
+	}
+	items[id].x = x;
+	items[id].y = y;
+	items[id].z = z;
+	link(id);
+	itemCount++;
+	return true;
+}
+
+/*
+ * Adds a point to the grid at the coordinates of a Point.
+ *
+ * @param id The identifier of the point.
+ * @param point The coordinates of the point.
+ * @return True if the point was added, false if the identifier is already in the grid.
+ */
+bool SpatialHashGrid::insert(std::uint32_t id, const Point& point)
+{
+	return insert(id, point.getCoordinateX(), point.getCoordinateY(), point.getCoordinateZ());
+}
+
+/*
+ * Moves a point to new coordinates.
+ *
+ * @param id The identifier of the point.
+ * @param x The new x-coordinate.
+ * @param y The new y-coordinate.
+ * @param z The new z-coordinate.
+ * @return True if the point was moved, false if the identifier is not in the grid.
+ */
+bool SpatialHashGrid::move(std::uint32_t id, int x, int y, int z)
+{
+	if (!contains(id))
+	{
+		return false;
+	}
+
+	// A point that stays in its cell only needs its coordinates updated.
+	Item& item = items[id];
+	const Cell& cell = cells[item.cell];
+	item.x = x;
+	item.y = y;
+	item.z = z;
+	if (floorDivide(x, cellSize) == cell.x && floorDivide(y, cellSize) == cell.y && floorDivide(z, cellSize) == cell.z)
+	{
+		return true;
+	}
+	unlink(id);
+	link(id);
+	return true;
+}
+
+/*
+ * Moves a point to the coordinates of a Point.
+ *
+ * @param id The identifier of the point.
+ * @param point The new coordinates.
+ * @return True if the point was moved, false if the identifier is not in the grid.
+ */
+bool SpatialHashGrid::move(std::uint32_t id, const Point& point)
+{
+	return move(id, point.getCoordinateX(), point.getCoordinateY(), point.getCoordinateZ());
+}
+
+/*
+ * Translates a point by a specified distance along a given axis.
+ *
+ * @param id The identifier of the point.
+ * @param d The distance to translate the point along the axis.
+ * @param axis The axis along which to translate ('x', 'y', or 'z').
+ * @return 0 if successful, -1 if the axis is invalid or the identifier is not in the grid.
+ */
+int SpatialHashGrid::translate(std::uint32_t id, int d, char axis)
+{
+	if (!contains(id))
+	{
+		return -1;
+	}
+	const Item& item = items[id];
+	switch (axis)
+	{
+	case 'x':
+		return move(id, item.x + d, item.y, item.z) ? 0 : -1;
+	case 'y':
+		return move(id, item.x, item.y + d, item.z) ? 0 : -1;
+	case 'z':
+		return move(id, item.x, item.y, item.z + d) ? 0 : -1;
+	default:
+		return -1;
+	}
+}
+
+/*
+ * Removes a point from the grid.
+ *
+ * @param id The identifier of the point.
+ * @return True if the point was removed, false if the identifier is not in the grid.
+ */
+bool SpatialHashGrid::remove(std::uint32_t id)
+{
+	if (!contains(id))
+	{
+		return false;
+	}
+	unlink(id);
+	itemCount--;
+	return true;
+}
+
+/*
+ * Checks whether an identifier is in the grid.
+ *
+ * @param id The identifier to check.
+ * @return True if the grid holds a point with this identifier.
+ */
+bool SpatialHashGrid::contains(std::uint32_t id) const
+{
+	return id < items.size() && items[id].cell != NO_CELL;
+}
+
+/*
+ * Returns the coordinates of a point in the grid.
+ *
+ * @param id The identifier of the point.
+ * @return A Point holding its coordinates.
+ */
+Point SpatialHashGrid::getPoint(std::uint32_t id) const
+{
+	return Point(items[id].x, items[id].y, items[id].z);
+}
+
+/*
+ * Finds every point within a distance of a query point, boundary included.
+ *
+ * @param x The x-coordinate of the query point.
+ * @param y The y-coordinate of the query point.
+ * @param z The z-coordinate of the query point.
+ * @param radius The largest distance to include.
+ * @param result Receives the identifiers of the points found.
+ */
+void SpatialHashGrid::queryRadius(int x, int y, int z, int radius, std::vector<std::uint32_t>& result) const
+{
+	result.clear();
+	if (radius < 0 || itemCount == 0)
+	{
+		return;
+	}
+	std::uint64_t limit = static_cast<std::uint64_t>(radius) * static_cast<std::uint64_t>(radius);
+
+	// The cells overlapping the cube around the sphere, clipped to the cells in use.
+	const int centre[3] = { x, y, z };
+	long long low[3];
+	long long high[3];
+	long long volume = 1;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		low[axis] = std::max<long long>(floorDivide(static_cast<long long>(centre[axis]) - radius, cellSize), minCell[axis]);
+		high[axis] = std::min<long long>(floorDivide(static_cast<long long>(centre[axis]) + radius, cellSize), maxCell[axis]);
+		if (low[axis] > high[axis])
+		{
+			return;
+		}
+		// The count saturates instead of overflowing; any value above the number of cells leads to the same choice.
+		long long extent = high[axis] - low[axis] + 1;
+		volume = extent > LLONG_MAX / volume ? LLONG_MAX : volume * extent;
+	}
+
+	// Collect the points of one cell that lie inside the sphere.
+	auto collect = [&](const Cell& cell)
+	{
+		for (std::uint32_t id : cell.items)
+		{
+			const Item& item = items[id];
+			if (squaredDistance(item.x, item.y, item.z, x, y, z) <= limit)
+			{
+				result.push_back(id);
+			}
+		}
+	};
+
+	// A sphere covering more cells than exist is answered by checking the existing cells instead.
+	if (static_cast<unsigned long long>(volume) > usedCellCount())
+	{
+		// Released cells are empty, so they add nothing.
+		for (const Cell& cell : cells)
+		{
+			if (cell.x >= low[0] && cell.x <= high[0] && cell.y >= low[1] && cell.y <= high[1] && cell.z >= low[2] && cell.z <= high[2])
+			{
+				collect(cell);
+			}
+		}
+		return;
+	}
+	for (long long cellX = low[0]; cellX <= high[0]; cellX++)
+	{
+		for (long long cellY = low[1]; cellY <= high[1]; cellY++)
+		{
+			for (long long cellZ = low[2]; cellZ <= high[2]; cellZ++)
+			{
+				std::uint32_t index = findCell(static_cast<int>(cellX), static_cast<int>(cellY), static_cast<int>(cellZ));
+				if (index != NO_CELL)
+				{
+					collect(cells[index]);
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Finds the k points nearest to a query point, searching outward one ring of cells at a time.
+ * After ring r, every point not yet seen is at least r cells away, so the search stops as soon as
+ * the k-th best distance is below that, or once the rings cover every cell in use.
+ *
+ * @param x The x-coordinate of the query point.
+ * @param y The y-coordinate of the query point.
+ * @param z The z-coordinate of the query point.
+ * @param k The number of points to find.
+ * @param result Receives the identifiers of up to k points, nearest first.
+ */
+void SpatialHashGrid::queryNearest(int x, int y, int z, std::size_t k, std::vector<std::uint32_t>& result) const
+{
+	result.clear();
+	if (k == 0 || itemCount == 0)
+	{
+		return;
+	}
+
+	// Max-heap of the best candidates so far, ordered by distance and then identifier.
+	std::vector<std::pair<std::uint64_t, std::uint32_t>> best;
+	auto consider = [&](const Cell& cell)
+	{
+		for (std::uint32_t id : cell.items)
+		{
+			const Item& item = items[id];
+			std::pair<std::uint64_t, std::uint32_t> candidate(squaredDistance(item.x, item.y, item.z, x, y, z), id);
+			if (best.size() < k)
+			{
+				best.push_back(candidate);
+				std::push_heap(best.begin(), best.end());
+			}
+			else if (candidate < best.front())
+			{
+				std::pop_heap(best.begin(), best.end());
+				best.back() = candidate;
+				std::push_heap(best.begin(), best.end());
+			}
+		}
+	};
+
+	const long long centre[3] = { floorDivide(x, cellSize), floorDivide(y, cellSize), floorDivide(z, cellSize) };
+	for (long long ring = 0;; ring++)
+	{
+		// Once a ring would take more lookups than there are cells, check the remaining cells directly.
+		long long side = 2 * ring + 1;
+		if (side * side * side > static_cast<long long>(usedCellCount()) * 2)
+		{
+			for (const Cell& cell : cells)
+			{
+				long long distance = std::max(std::max(std::llabs(cell.x - centre[0]), std::llabs(cell.y - centre[1])), std::llabs(cell.z - centre[2]));
+				if (distance >= ring)
+				{
+					consider(cell);
+				}
+			}
+			break;
+		}
+
+		// Visit the cells of the ring, which has at least one coordinate exactly ring cells from the centre.
+		for (long long dx = -ring; dx <= ring; dx++)
+		{
+			for (long long dy = -ring; dy <= ring; dy++)
+			{
+				bool onFace = dx == -ring || dx == ring || dy == -ring || dy == ring;
+				long long step = onFace || ring == 0 ? 1 : 2 * ring;
+				for (long long dz = -ring; dz <= ring; dz += step)
+				{
+					long long cellX = centre[0] + dx;
+					long long cellY = centre[1] + dy;
+					long long cellZ = centre[2] + dz;
+					if (cellX < minCell[0] || cellX > maxCell[0] || cellY < minCell[1] || cellY > maxCell[1] || cellZ < minCell[2] || cellZ > maxCell[2])
+					{
+						continue;
+					}
+					std::uint32_t index = findCell(static_cast<int>(cellX), static_cast<int>(cellY), static_cast<int>(cellZ));
+					if (index != NO_CELL)
+					{
+						consider(cells[index]);
+					}
+				}
+			}
+		}
+
+		// Stop when the rings cover every cell in use.
+		if (centre[0] - ring <= minCell[0] && centre[0] + ring >= maxCell[0] && centre[1] - ring <= minCell[1] && centre[1] + ring >= maxCell[1]
+			&& centre[2] - ring <= minCell[2] && centre[2] + ring >= maxCell[2])
+		{
+			break;
+		}
+
+		// Stop when every unvisited point is strictly farther than the k-th best, which also keeps ties ordered by identifier.
+		if (best.size() == k)
+		{
+			std::uint64_t gap = static_cast<std::uint64_t>(ring) * static_cast<std::uint64_t>(cellSize);
+			if (gap < (1ull << 32) && best.front().first < gap * gap)
+			{
+				break;
+			}
+		}
+	}
+
+	// Sort the candidates nearest first.
+	std::sort_heap(best.begin(), best.end());
+	for (const std::pair<std::uint64_t, std::uint32_t>& candidate : best)
+	{
+		result.push_back(candidate.second);
+	}
+}
@@ -0,0 +1,259 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef SPATIALHASHGRID_H
+#define SPATIALHASHGRID_H
+
+// Includes the Point.h header file to place items at the coordinates of a Point.
+#include "Point.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the cstdint library for the fixed-width item identifiers and hashes.
+#include <cstdint>
+// Includes the vector library for the cells, the items, and the query results.
+#include <vector>
+
+/*
+ * Defines a SpatialHashGrid class that sorts points into cubic cells of a fixed size.
+ * A cell is found by hashing its integer cell coordinates, so only cells that hold a point use memory, and a cell
+ * that empties is recycled, so points drifting through space do not leave a trail of cells behind.
+ * Inserting, moving, and removing a point take amortized constant time, which suits data that changes constantly, and
+ * radius and k-nearest queries only look at the cells around the query point.
+ * Each point carries a caller-chosen identifier, such as a vertex or triangle index; a triangle is usually
+ * entered at its centroid, with query radii widened by the largest distance from a centroid to a vertex.
+ */
+class SpatialHashGrid
+{
+private:
+	// Marks an empty entry of the hash table, and an identifier that is not in the grid.
+	static constexpr std::uint32_t NO_CELL = 0xFFFFFFFFu;
+
+	/*
+	 * One cell of the grid and the identifiers of the points inside it.
+	 */
+	struct Cell
+	{
+		// The cell coordinates: the point coordinates divided by the cell size, rounded down.
+		int x;
+		int y;
+		int z;
+		// Identifiers of the points in the cell, in no particular order.
+		std::vector<std::uint32_t> items;
+	};
+
+	/*
+	 * The position of a point in the grid.
+	 */
+	struct Item
+	{
+		// The coordinates of the point.
+		int x;
+		int y;
+		int z;
+		// The index of its cell, or NO_CELL if the identifier is not in the grid.
+		std::uint32_t cell;
+		// Its position in the cell's list, so it can be removed without searching.
+		std::uint32_t slot;
+	};
+
+	// The edge length of a cell.
+	int cellSize;
+	// The cells, some of them unused. An emptied cell leaves the hash table and its index goes on freeCells,
+	// keeping its list's memory, so points moving back and forth between cells allocate nothing.
+	std::vector<Cell> cells;
+	// Indices of the unused entries of cells, reused before cells grows.
+	std::vector<std::uint32_t> freeCells;
+	// Open-addressing hash table of the cells in use, with linear probing; its size is a power of two.
+	std::vector<std::uint32_t> table;
+	// The points, indexed by identifier.
+	std::vector<Item> items;
+	// Number of points in the grid.
+	std::size_t itemCount;
+	// Range of cell coordinates that contains every cell in use, which bounds how far a nearest search has to look.
+	// It grows as cells come into use but not as they are released, so it may be wider than needed until it is recomputed.
+	int minCell[3];
+	int maxCell[3];
+	// Number of cells released since the range was last recomputed.
+	std::size_t releasedSinceRange;
+
+	/*
+	 * Finds the cell with the given cell coordinates.
+	 *
+	 * @param x The x cell coordinate.
+	 * @param y The y cell coordinate.
+	 * @param z The z cell coordinate.
+	 * @return The index of the cell, or NO_CELL if no point is in it.
+	 */
+	std::uint32_t findCell(int x, int y, int z) const;
+
+	/*
+	 * Returns the number of cells in use.
+	 *
+	 * @return The number of cells holding at least one point.
+	 */
+	std::size_t usedCellCount() const;
+
+	/*
+	 * Takes an emptied cell out of the hash table and keeps its index for reuse.
+	 *
+	 * @param index The index of the cell.
+	 */
+	void releaseCell(std::uint32_t index);
+
+	/*
+	 * Recomputes the range of cell coordinates from the cells in use, so it is as tight as possible again.
+	 */
+	void recomputeCellRange();
+
+	/*
+	 * Finds the cell with the given cell coordinates, creating it if needed.
+	 *
+	 * @param x The x cell coordinate.
+	 * @param y The y cell coordinate.
+	 * @param z The z cell coordinate.
+	 * @return The index of the cell.
+	 */
+	std::uint32_t findOrCreateCell(int x, int y, int z);
+
+	/*
+	 * Adds a point to the cell containing its coordinates.
+	 *
+	 * @param id The identifier of the point, whose coordinates are already set.
+	 */
+	void link(std::uint32_t id);
+
+	/*
+	 * Removes a point from its cell, releasing the cell if it empties.
+	 *
+	 * @param id The identifier of the point.
+	 */
+	void unlink(std::uint32_t id);
+
+public:
+	/*
+	 * Constructor for the SpatialHashGrid class.
+	 * The cell size should be about the typical query radius, or the typical spacing between points.
+	 *
+	 * @param cellSize The edge length of a cell. Values below 1 are treated as 1.
+	 */
+	explicit SpatialHashGrid(int cellSize);
+
+	/*
+	 * Returns the edge length of a cell.
+	 *
+	 * @return The cell size.
+	 */
+	int getCellSize() const;
+
+	/*
+	 * Returns the number of points in the grid.
+	 *
+	 * @return The number of points.
+	 */
+	std::size_t size() const;
+
+	/*
+	 * Removes every point and every cell.
+	 */
+	void clear();
+
+	/*
+	 * Adds a point to the grid.
+	 *
+	 * @param id The identifier of the point.
+	 * @param x The x-coordinate of the point.
+	 * @param y The y-coordinate of the point.
+	 * @param z The z-coordinate of the point.
+	 * @return True if the point was added, false if the identifier is already in the grid.
+	 */
+	bool insert(std::uint32_t id, int x, int y, int z);
+
+	/*
+	 * Adds a point to the grid at the coordinates of a Point.
+	 *
+	 * @param id The identifier of the point.
+	 * @param point The coordinates of the point.
+	 * @return True if the point was added, false if the identifier is already in the grid.
+	 */
+	bool insert(std::uint32_t id, const Point& point);
+
+	/*
+	 * Moves a point to new coordinates. Only moving it to another cell touches the cell lists.
+	 *
+	 * @param id The identifier of the point.
+	 * @param x The new x-coordinate.
+	 * @param y The new y-coordinate.
+	 * @param z The new z-coordinate.
+	 * @return True if the point was moved, false if the identifier is not in the grid.
+	 */
+	bool move(std::uint32_t id, int x, int y, int z);
+
+	/*
+	 * Moves a point to the coordinates of a Point.
+	 *
+	 * @param id The identifier of the point.
+	 * @param point The new coordinates.
+	 * @return True if the point was moved, false if the identifier is not in the grid.
+	 */
+	bool move(std::uint32_t id, const Point& point);
+
+	/*
+	 * Translates a point by a specified distance along a given axis, as Point::translate does.
+	 *
+	 * @param id The identifier of the point.
+	 * @param d The distance to translate the point along the axis.
+	 * @param axis The axis along which to translate ('x', 'y', or 'z').
+	 * @return 0 if successful, -1 if the axis is invalid or the identifier is not in the grid.
+	 */
+	int translate(std::uint32_t id, int d, char axis);
+
+	/*
+	 * Removes a point from the grid.
+	 *
+	 * @param id The identifier of the point.
+	 * @return True if the point was removed, false if the identifier is not in the grid.
+	 */
+	bool remove(std::uint32_t id);
+
+	/*
+	 * Checks whether an identifier is in the grid.
+	 *
+	 * @param id The identifier to check.
+	 * @return True if the grid holds a point with this identifier.
+	 */
+	bool contains(std::uint32_t id) const;
+
+	/*
+	 * Returns the coordinates of a point in the grid.
+	 *
+	 * @param id The identifier of the point. It must be in the grid.
+	 * @return A Point holding its coordinates.
+	 */
+	Point getPoint(std::uint32_t id) const;
+
+	/*
+	 * Finds every point within a distance of a query point, boundary included.
+	 * Distances are compared exactly in integers.
+	 *
+	 * @param x The x-coordinate of the query point.
+	 * @param y The y-coordinate of the query point.
+	 * @param z The z-coordinate of the query point.
+	 * @param radius The largest distance to include. Negative radii find nothing.
+	 * @param result Receives the identifiers of the points found, in no particular order. It is cleared first.
+	 */
+	void queryRadius(int x, int y, int z, int radius, std::vector<std::uint32_t>& result) const;
+
+	/*
+	 * Finds the k points nearest to a query point, searching outward one ring of cells at a time.
+	 *
+	 * @param x The x-coordinate of the query point.
+	 * @param y The y-coordinate of the query point.
+	 * @param z The z-coordinate of the query point.
+	 * @param k The number of points to find.
+	 * @param result Receives the identifiers of up to k points, nearest first; equal distances are ordered by identifier.
+	 *               It is cleared first.
+	 */
+	void queryNearest(int x, int y, int z, std::size_t k, std::vector<std::uint32_t>& result) const;
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -0,0 +1,216 @@
+// Includes the StlReader.h header file for function declarations.
+#include "StlReader.h"
+// Includes the MappedFile.h header file to read the file without copying it.
+#include "MappedFile.h"
+// Includes the MeshWeld.h header file to merge the copies of shared vertices.
+#include "MeshWeld.h"
+// Includes the MeshReorder.h header file to sort the loaded vertices and triangles by Morton code.
+#include "MeshReorder.h"
+
+// Includes the atomic library to report invalid coordinates from any thread.
+#include <atomic>
+// Includes the cmath library for rounding and finiteness checks.
+#include <cmath>
+// Includes the climits library for the limits of the int type.
+#include <climits>
+// Includes the cstdint library for the fixed-width integer types of the file format.
+#include <cstdint>
+// Includes the cstring library to read unaligned values with memcpy.
+#include <cstring>
+
+// Size of the free-form header at the start of a binary STL file.
+static const std::size_t STL_HEADER_SIZE = 80;
+// Offset of the first triangle record: the header followed by the 32-bit triangle count.
+static const std::size_t STL_DATA_OFFSET = STL_HEADER_SIZE + 4;
+// Size of one triangle record: a normal and three vertices of three floats each, then a 16-bit attribute.
+static const std::size_t STL_RECORD_SIZE = 50;
+// Number of triangles decoded by one parallel task.
+static const std::size_t STL_CHUNK = 65536;
+
+/*
+ * Returns a readable description of an STL loading outcome.
+ *
+ * @param status The outcome to describe.
+ * @return The description.
+ */
+const char* getStlStatusMessage(StlStatus status)
+{
+	switch (status)
+	{
+	case StlStatus::Ok:
+		return "OK";
+	case StlStatus::OpenFailed:
+		return "The file could not be opened";
+	case StlStatus::TooSmall:
+		return "The file is too small to be a binary STL file";
+	case StlStatus::AsciiNotSupported:
+		return "ASCII STL files are not supported";
+	case StlStatus::SizeMismatch:
+		return "The file size does not match the triangle count in its header";
+	case StlStatus::TooManyTriangles:
+		return "The file has more triangles than a mesh can index";
+	case StlStatus::InvalidCoordinate:
+		return "A coordinate is not a finite number in the int range";
+	}
+	return "Unknown error";
+}
+
+/*
+ * Reads a little-endian 32-bit float at any alignment.
+ * STL files are little-endian, as are all the platforms the project targets.
+ *
+ * @param bytes The address of the float.
+ * @return The value of the float.
+ */
+static float readFloat(const unsigned char* bytes)
+{
+	float value;
+	std::memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+/*
+ * Converts a float coordinate from the file to the integer coordinate stored in the mesh.
+ *
+ * @param value The coordinate read from the file.
+ * @param scale The factor applied before rounding.
+ * @param result Receives the rounded coordinate.
+ * @return True if the coordinate is finite and fits in an int, false otherwise.
+ */
+static bool convertCoordinate(float value, double scale, int& result)
+{
+	double scaled = std::nearbyint(static_cast<double>(value) * scale);
+	// The negated test also rejects NaN, for which every comparison is false.
+	if (!(scaled >= INT_MIN && scaled <= INT_MAX))
+	{
+		return false;
+	}
+	result = static_cast<int>(scaled);
+	return true;
+}
+
+/*
+ * Builds a mesh from binary STL data already in memory.
+ *
+ * @param data The bytes of the file.
+ * @param size The number of bytes.
+ * @param mesh The mesh that receives the triangles.
+ * @param options The scale, welding, and ordering settings.
+ * @param pool The thread pool that decodes the triangles.
+ * @return StlStatus::Ok if successful, otherwise the reason the data was rejected.
+ */
+StlStatus readBinaryStl(const unsigned char* data, std::size_t size, TriangleMesh& mesh, const StlOptions& options, ThreadPool& pool)
+{
+	mesh.clear();
+
+	// The header and the triangle count must be present.
+	if (size < STL_DATA_OFFSET)
+	{
+		return StlStatus::TooSmall;
+	}
+
+	// Read the little-endian triangle count.
+	std::uint64_t triangleCount = static_cast<std::uint64_t>(data[80]) | static_cast<std::uint64_t>(data[81]) << 8
+		| static_cast<std::uint64_t>(data[82]) << 16 | static_cast<std::uint64_t>(data[83]) << 24;
+
+	// The size must match the count exactly; a text file starting with "solid" is most likely an ASCII STL.
+	if ((size - STL_DATA_OFFSET) / STL_RECORD_SIZE != triangleCount || (size - STL_DATA_OFFSET) % STL_RECORD_SIZE != 0)
+	{
+		return std::memcmp(data, "solid", 5) == 0 ? StlStatus::AsciiNotSupported : StlStatus::SizeMismatch;
+	}
+
+	// Every triangle gets three vertices of its own, and vertex indices are 32 bits wide.
+	if (triangleCount * 3 > UINT32_MAX)
+	{
+		return StlStatus::TooManyTriangles;
+	}
+
+	// Size the mesh once, so decoding writes straight into its buffers without any allocation.
+	mesh.resize(static_cast<std::size_t>(triangleCount) * 3, static_cast<std::size_t>(triangleCount));
+	PointBuffer& vertices = mesh.getVertices();
+	int* xs = vertices.dataX();
+	int* ys = vertices.dataY();
+	int* zs = vertices.dataZ();
+	std::uint32_t* indices = mesh.getIndices();
+
+	// Set by any task that meets a coordinate it cannot store.
+	std::atomic<bool> invalid(false);
+
+	// Decode the records in fixed-size chunks; each chunk writes a disjoint range of the buffers.
+	pool.parallelForChunks(static_cast<std::size_t>(triangleCount), STL_CHUNK, [&](std::size_t, std::size_t first, std::size_t last)
+	{
+		bool chunkValid = true;
+
+		for (std::size_t t = first; t < last; t++)
+		{
+			// Skip the normal; it is recomputed from the vertices whenever it is needed.
+			const unsigned char* record = data + STL_DATA_OFFSET + t * STL_RECORD_SIZE + 12;
+			for (std::size_t k = 0; k < 3; k++)
+			{
+				std::size_t vertex = t * 3 + k;
+				chunkValid &= convertCoordinate(readFloat(record + k * 12), options.scale, xs[vertex]);
+				chunkValid &= convertCoordinate(readFloat(record + k * 12 + 4), options.scale, ys[vertex]);
+				chunkValid &= convertCoordinate(readFloat(record + k * 12 + 8), options.scale, zs[vertex]);
+				indices[vertex] = static_cast<std::uint32_t>(vertex);
+			}
+		}
+
+		if (!chunkValid)
+		{
+			invalid.store(true);
+		}
+	});
+
+	// Reject the whole file if any coordinate was out of range.
+	if (invalid.load())
+	{
+		mesh.clear();
+		return StlStatus::InvalidCoordinate;
+	}
+
+	// Merge the copies of shared vertices if requested.
+	if (options.weldVertices && triangleCount > 0)
+	{
+		weldMeshVertices(mesh, options.weldTolerance, pool);
+	}
+	// Sort after welding, so the merged vertices are placed as well.
+	if (options.reorderByMortonCode)
+	{
+		reorderMeshByMortonCode(mesh, pool);
+	}
+	return StlStatus::Ok;
+}
+
+/*
+ * Memory-maps a binary STL file and builds a mesh from it.
+ *
+ * @param path The path of the file.
+ * @param mesh The mesh that receives the triangles.
+ * @param options The scale, welding, and ordering settings.
+ * @param pool The thread pool that decodes the triangles.
+ * @return StlStatus::Ok if successful, otherwise the reason the file was rejected.
+ */
+StlStatus loadBinaryStl(const char* path, TriangleMesh& mesh, const StlOptions& options, ThreadPool& pool)
+{
+	// Map the file; it is unmapped again when the function returns.
+	MappedFile file;
+	if (!file.open(path))
+	{
+		mesh.clear();
+		return StlStatus::OpenFailed;
+	}
+	return readBinaryStl(file.data(), file.size(), mesh, options, pool);
+}
+
+/*
+ * Memory-maps a binary STL file and builds a mesh from it on the program's shared thread pool.
+ *
+ * @param path The path of the file.
+ * @param mesh The mesh that receives the triangles.
+ * @param options The scale, welding, and ordering settings.
+ * @return StlStatus::Ok if successful, otherwise the reason the file was rejected.
+ */
+StlStatus loadBinaryStl(const char* path, TriangleMesh& mesh, const StlOptions& options)
+{
+	return loadBinaryStl(path, mesh, options, ThreadPool::getShared());
+}
@@ -0,0 +1,87 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef STLREADER_H
+#define STLREADER_H
+
+// Includes the TriangleMesh.h header file to load files into indexed meshes.
+#include "TriangleMesh.h"
+// Includes the ThreadPool.h header file to decode the triangles in parallel.
+#include "ThreadPool.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+
+/*
+ * Lists the outcomes of loading a binary STL file.
+ */
+enum class StlStatus
+{
+	Ok,
+	OpenFailed,
+	TooSmall,
+	AsciiNotSupported,
+	SizeMismatch,
+	TooManyTriangles,
+	InvalidCoordinate
+};
+
+/*
+ * Holds the settings for loading a binary STL file.
+ */
+struct StlOptions
+{
+	// Factor applied to each float coordinate before it is rounded to the nearest integer.
+	double scale = 1.0;
+	// Whether vertices with identical coordinates are merged into one shared vertex after loading.
+	bool weldVertices = false;
+	// Largest distance, after scaling, between two vertices that welding merges; 0 merges only exact duplicates.
+	int weldTolerance = 0;
+	// Whether vertices and triangles are sorted by Morton code after loading, so nearby ones share cache lines.
+	bool reorderByMortonCode = false;
+};
+
+/*
+ * Returns a readable description of an STL loading outcome.
+ *
+ * @param status The outcome to describe.
+ * @return The description.
+ */
+const char* getStlStatusMessage(StlStatus status);
+
+/*
+ * Builds a mesh from binary STL data already in memory: an 80-byte header, a 32-bit triangle count,
+ * and 50 bytes per triangle. The size must match the triangle count exactly. Triangles are decoded
+ * in parallel straight into the mesh buffers, with three new vertices per triangle unless welding is on.
+ * On failure the mesh is left empty.
+ *
+ * @param data The bytes of the file.
+ * @param size The number of bytes.
+ * @param mesh The mesh that receives the triangles. Its previous contents are replaced.
+ * @param options The scale, welding, and ordering settings.
+ * @param pool The thread pool that decodes the triangles.
+ * @return StlStatus::Ok if successful, otherwise the reason the data was rejected.
+ */
+StlStatus readBinaryStl(const unsigned char* data, std::size_t size, TriangleMesh& mesh, const StlOptions& options, ThreadPool& pool);
+
+/*
+ * Memory-maps a binary STL file and builds a mesh from it, as readBinaryStl does.
+ *
+ * @param path The path of the file.
+ * @param mesh The mesh that receives the triangles. Its previous contents are replaced.
+ * @param options The scale, welding, and ordering settings.
+ * @param pool The thread pool that decodes the triangles.
+ * @return StlStatus::Ok if successful, otherwise the reason the file was rejected.
+ */
+StlStatus loadBinaryStl(const char* path, TriangleMesh& mesh, const StlOptions& options, ThreadPool& pool);
+
+/*
+ * Memory-maps a binary STL file and builds a mesh from it on the program's shared thread pool.
+ *
+ * @param path The path of the file.
+ * @param mesh The mesh that receives the triangles. Its previous contents are replaced.
+ * @param options The scale, welding, and ordering settings.
+ * @return StlStatus::Ok if successful, otherwise the reason the file was rejected.
+ */
+StlStatus loadBinaryStl(const char* path, TriangleMesh& mesh, const StlOptions& options = StlOptions());
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
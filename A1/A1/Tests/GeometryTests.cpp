@@ -0,0 +1,1128 @@
+// Includes the ExactMath.h header file for the exact predicates under test.
+#include "ExactMath.h"
+// Includes the ConvexHull.h header file for the hull under test.
+#include "ConvexHull.h"
+// Includes the Delaunay.h header file for the triangulation under test.
+#include "Delaunay.h"
+// Includes the MeshIntersect.h header file for the intersection queries under test.
+#include "MeshIntersect.h"
+
+// Includes the climits library for the extreme int coordinates.
+#include <climits>
+// Includes the cmath library to place points on circles and spheres.
+#include <cmath>
+// Includes the cstdint library for the 32-bit vertex indices.
+#include <cstdint>
+// Includes the iostream library for the test report.
+#include <iostream>
+// Includes the map library to count directed edges.
+#include <map>
+// Includes the random library for the seeded point sets.
+#include <random>
+// Includes the set library to compare pair lists and count distinct points.
+#include <set>
+// Includes the utility library for std::pair.
+#include <utility>
+// Includes the vector library for the pair lists.
+#include <vector>
+
+// Number of failed checks so far.
+static int failures = 0;
+
+/*
+ * Records the result of one check, reporting it if it failed.
+ *
+ * @param passed Whether the check passed.
+ * @param name What was checked.
+ */
+static void check(bool passed, const char* name)
+{
+	if (!passed)
+	{
+		std::cout << "FAILED: " << name << std::endl;
+		failures++;
+	}
+}
+
+/*
+ * Returns the sign of a 64-bit value.
+ *
+ * @param value The value.
+ * @return 1 if it is positive, -1 if negative, 0 if zero.
+ */
+static int sign(long long value)
+{
+	return value > 0 ? 1 : (value < 0 ? -1 : 0);
+}
+
+/*
+ * Reference orientation of three points in 64-bit integers. The coordinates must stay within 2^29 of each other.
+ */
+static int referenceOrient2d(long long aX, long long aY, long long bX, long long bY, long long cX, long long cY)
+{
+	return sign((bX - aX) * (cY - aY) - (bY - aY) * (cX - aX));
+}
+
+/*
+ * Reference orientation of four points in 64-bit integers. The coordinates must stay within 2^19 of each other.
+ */
+static int referenceOrient3d(const long long a[3], const long long b[3], const long long c[3], const long long d[3])
+{
+	long long u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+	long long v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+	long long w[3] = { d[0] - a[0], d[1] - a[1], d[2] - a[2] };
+	return sign(u[0] * (v[1] * w[2] - v[2] * w[1]) - u[1] * (v[0] * w[2] - v[2] * w[0]) + u[2] * (v[0] * w[1] - v[1] * w[0]));
+}
+
+/*
+ * Reference incircle test in 64-bit integers. The coordinates must stay within 2^12 of each other.
+ */
+static int referenceIncircle(const long long a[2], const long long b[2], const long long c[2], const long long d[2])
+{
+	long long rows[3][3];
+	const long long* points[3] = { a, b, c };
+	for (int i = 0; i < 3; i++)
+	{
+		long long x = points[i][0] - d[0];
+		long long y = points[i][1] - d[1];
+		rows[i][0] = x;
+		rows[i][1] = y;
+		rows[i][2] = x * x + y * y;
+	}
+	return sign(rows[0][0] * (rows[1][1] * rows[2][2] - rows[1][2] * rows[2][1])
+		- rows[0][1] * (rows[1][0] * rows[2][2] - rows[1][2] * rows[2][0])
+		+ rows[0][2] * (rows[1][0] * rows[2][1] - rows[1][1] * rows[2][0]));
+}
+
+/*
+ * Checks orient2d() against the reference on small configurations, also shifted far from the origin, and on long lines
+ * across the whole int range nudged by one unit. Fibonacci vectors reach the exact fallback with a nonzero determinant:
+ * the filter cannot decide them.
+ */
+static void testOrient2d()
+{
+	std::mt19937 random(1);
+	std::uniform_int_distribution<int> small(-64, 64);
+	std::uniform_int_distribution<int> offset(-(1 << 30), 1 << 30);
+	bool agrees = true;
+	for (int i = 0; i < 200000 && agrees; i++)
+	{
+		int p[6];
+		for (int k = 0; k < 6; k++)
+		{
+			p[k] = small(random);
+		}
+		// Every third configuration is made collinear.
+		if (i % 3 == 0)
+		{
+			p[4] = p[0] + 2 * (p[2] - p[0]);
+			p[5] = p[1] + 2 * (p[3] - p[1]);
+		}
+		int expected = referenceOrient2d(p[0], p[1], p[2], p[3], p[4], p[5]);
+		int x = offset(random);
+		int y = offset(random);
+		agrees = orient2d(p[0], p[1], p[2], p[3], p[4], p[5]) == expected
+			&& orient2d(p[0] + x, p[1] + y, p[2] + x, p[3] + y, p[4] + x, p[5] + y) == expected;
+	}
+	check(agrees, "orient2d on shifted small configurations");
+
+	// Points a, a + s * d, and a + t * d + e: the determinant is s * (d x e), whatever the size of s and t.
+	std::uniform_int_distribution<int> step(-7, 7);
+	std::uniform_int_distribution<long long> anywhere(INT_MIN, INT_MAX);
+	agrees = true;
+	for (int i = 0; i < 100000 && agrees; i++)
+	{
+		long long d[2] = { step(random), step(random) };
+		long long e[2] = { step(random) % 2, step(random) % 2 };
+		long long a[2] = { anywhere(random), anywhere(random) };
+		long long s = anywhere(random) / 8;
+		long long t = anywhere(random) / 8;
+		long long b[2] = { a[0] + s * d[0], a[1] + s * d[1] };
+		long long c[2] = { a[0] + t * d[0] + e[0], a[1] + t * d[1] + e[1] };
+		bool inRange = true;
+		for (int k = 0; k < 2; k++)
+		{
+			inRange = inRange && b[k] >= INT_MIN && b[k] <= INT_MAX && c[k] >= INT_MIN && c[k] <= INT_MAX;
+		}
+		if (!inRange)
+		{
+			continue;
+		}
+		int expected = sign(s) * sign(d[0] * e[1] - d[1] * e[0]);
+		agrees = orient2d(int(a[0]), int(a[1]), int(b[0]), int(b[1]), int(c[0]), int(c[1])) == expected;
+	}
+	check(agrees, "orient2d on long nearly collinear lines");
+
+	// Consecutive Fibonacci vectors (F(n + 1), F(n)) and (F(n), F(n - 1)) have the determinant (-1)^n (Cassini's identity),
+	// while their products grow far past the 53 bits a double holds exactly.
+	std::uniform_int_distribution<int> corner(-(1 << 28), 1 << 28);
+	long long fibonacci[47] = { 0, 1 };
+	for (int n = 2; n < 47; n++)
+	{
+		fibonacci[n] = fibonacci[n - 1] + fibonacci[n - 2];
+	}
+	agrees = true;
+	for (int n = 2; n < 45 && agrees; n++)
+	{
+		for (int i = 0; i < 100 && agrees; i++)
+		{
+			int aX = corner(random) - (1 << 29);
+			int aY = corner(random) - (1 << 29);
+			int expected = n % 2 == 0 ? 1 : -1;
+			int bX = aX + int(fibonacci[n + 1]);
+			int bY = aY + int(fibonacci[n]);
+			int cX = aX + int(fibonacci[n]);
+			int cY = aY + int(fibonacci[n - 1]);
+			agrees = orient2d(aX, aY, bX, bY, cX, cY) == expected && orient2d(aX, aY, cX, cY, bX, bY) == -expected
+				&& orient2d(bX, bY, cX, cY, aX, aY) == expected;
+		}
+	}
+	check(agrees, "orient2d on Fibonacci vectors");
+
+	check(orient2d(INT_MIN, INT_MIN, INT_MAX, INT_MAX, 0, 0) == 0, "orient2d on the diagonal of the int range");
+	check(orient2d(INT_MIN, INT_MIN, INT_MAX, INT_MAX, -1, 0) == 1, "orient2d just above the diagonal of the int range");
+	check(orient2d(INT_MIN, INT_MIN, INT_MAX, INT_MAX, 0, -1) == -1, "orient2d just below the diagonal of the int range");
+	check(orient2d(INT_MIN, INT_MAX, INT_MAX, INT_MIN, INT_MIN, INT_MIN) == -1, "orient2d on three corners of the int range");
+}
+
+/*
+ * Checks orient3d() against the reference like orient2d(), with large planes nudged by one unit, and with
+ * Fibonacci tetrahedra that only the exact fallback can decide.
+ */
+static void testOrient3d()
+{
+	std::mt19937 random(2);
+	std::uniform_int_distribution<int> small(-64, 64);
+	std::uniform_int_distribution<int> offset(-(1 << 30), 1 << 30);
+	bool agrees = true;
+	for (int i = 0; i < 200000 && agrees; i++)
+	{
+		long long p[4][3];
+		for (int v = 0; v < 4; v++)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				p[v][k] = small(random);
+			}
+		}
+		// Every third configuration is made coplanar.
+		if (i % 3 == 0)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				p[3][k] = p[0][k] + (p[1][k] - p[0][k]) - 2 * (p[2][k] - p[0][k]);
+			}
+		}
+		int expected = referenceOrient3d(p[0], p[1], p[2], p[3]);
+		int shift[3] = { offset(random), offset(random), offset(random) };
+		int q[4][3];
+		for (int v = 0; v < 4; v++)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				q[v][k] = int(p[v][k]) + shift[k];
+			}
+		}
+		agrees = orient3d(q[0][0], q[0][1], q[0][2], q[1][0], q[1][1], q[1][2], q[2][0], q[2][1], q[2][2], q[3][0], q[3][1], q[3][2]) == expected;
+	}
+	check(agrees, "orient3d on shifted small configurations");
+
+	// Points a, a + s1 * u + t1 * v, a + s2 * u + t2 * v, and a + s3 * u + t3 * v + e: the determinant is
+	// (s1 * t2 - t1 * s2) * ((u x v) . e), whatever the size of the steps.
+	std::uniform_int_distribution<int> step(-3, 3);
+	std::uniform_int_distribution<long long> anywhere(INT_MIN, INT_MAX);
+	std::uniform_int_distribution<long long> far(-(1LL << 28), 1LL << 28);
+	agrees = true;
+	for (int i = 0; i < 100000 && agrees; i++)
+	{
+		long long u[3] = { step(random), step(random), step(random) };
+		long long v[3] = { step(random), step(random), step(random) };
+		long long e[3] = { step(random) % 2, step(random) % 2, step(random) % 2 };
+		long long steps[3][2] = { { far(random), far(random) }, { far(random), far(random) }, { far(random), far(random) } };
+		long long points[4][3];
+		bool inRange = true;
+		for (int k = 0; k < 3; k++)
+		{
+			points[0][k] = anywhere(random);
+			for (int p = 0; p < 3; p++)
+			{
+				points[p + 1][k] = points[0][k] + steps[p][0] * u[k] + steps[p][1] * v[k] + (p == 2 ? e[k] : 0);
+				inRange = inRange && points[p + 1][k] >= INT_MIN && points[p + 1][k] <= INT_MAX;
+			}
+		}
+		if (!inRange)
+		{
+			continue;
+		}
+		long long normal[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+		int expected = sign(steps[0][0] * steps[1][1] - steps[0][1] * steps[1][0]) * sign(normal[0] * e[0] + normal[1] * e[1] + normal[2] * e[2]);
+		int q[4][3];
+		for (int p = 0; p < 4; p++)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				q[p][k] = int(points[p][k]);
+			}
+		}
+		agrees = orient3d(q[0][0], q[0][1], q[0][2], q[1][0], q[1][1], q[1][2], q[2][0], q[2][1], q[2][2], q[3][0], q[3][1], q[3][2]) == expected;
+	}
+	check(agrees, "orient3d on large nearly coplanar points");
+
+	// The rows (F(n + 1), F(n), F(n - 1)), (F(n), F(n - 1), F(n - 2)), and their sum plus (0, 0, 1) come from the
+	// Fibonacci matrix of determinant (-1)^n by a shear and a row addition, so they keep that determinant.
+	std::uniform_int_distribution<int> corner(-(1 << 28), 1 << 28);
+	long long fibonacci[47] = { 0, 1 };
+	for (int n = 2; n < 47; n++)
+	{
+		fibonacci[n] = fibonacci[n - 1] + fibonacci[n - 2];
+	}
+	agrees = true;
+	for (int n = 2; n < 45 && agrees; n++)
+	{
+		for (int i = 0; i < 100 && agrees; i++)
+		{
+			int a[3] = { corner(random) - (1 << 30), corner(random) - (1 << 30), corner(random) - (1 << 30) };
+			int b[3] = { a[0] + int(fibonacci[n + 1]), a[1] + int(fibonacci[n]), a[2] + int(fibonacci[n - 1]) };
+			int c[3] = { a[0] + int(fibonacci[n]), a[1] + int(fibonacci[n - 1]), a[2] + int(fibonacci[n - 2]) };
+			int d[3] = { a[0] + int(fibonacci[n + 2]), a[1] + int(fibonacci[n + 1]), a[2] + int(fibonacci[n]) + 1 };
+			int expected = n % 2 == 0 ? 1 : -1;
+			agrees = orient3d(a[0], a[1], a[2], b[0], b[1], b[2], c[0], c[1], c[2], d[0], d[1], d[2]) == expected
+				&& orient3d(b[0], b[1], b[2], a[0], a[1], a[2], c[0], c[1], c[2], d[0], d[1], d[2]) == -expected
+				&& orient3d(d[0], d[1], d[2], b[0], b[1], b[2], c[0], c[1], c[2], a[0], a[1], a[2]) == -expected;
+		}
+	}
+	check(agrees, "orient3d on Fibonacci tetrahedra");
+
+	check(orient3d(INT_MIN, INT_MIN, INT_MIN, INT_MAX, INT_MIN, INT_MIN, INT_MIN, INT_MAX, INT_MIN, INT_MIN, INT_MIN, INT_MAX) == 1,
+		"orient3d on four corners of the int range");
+	check(orient3d(INT_MIN, INT_MIN, INT_MIN, INT_MAX, INT_MIN, INT_MIN, INT_MIN, INT_MAX, INT_MIN, INT_MAX, INT_MAX, INT_MIN) == 0,
+		"orient3d on one face of the int range");
+}
+
+/*
+ * Checks incircle() against the reference on shifted small configurations, and on circles of Pythagorean points
+ * spanning the whole int range, with points on them, one unit off them, or so close to them that only the exact
+ * fallback can tell.
+ */
+static void testIncircle()
+{
+	std::mt19937 random(3);
+	std::uniform_int_distribution<int> small(-64, 64);
+	std::uniform_int_distribution<int> offset(-(1 << 30), 1 << 30);
+	// Points of the circle of radius 5 around the origin, counterclockwise.
+	static const int CIRCLE[12][2] = { { 5, 0 }, { 4, 3 }, { 3, 4 }, { 0, 5 }, { -3, 4 }, { -4, 3 }, { -5, 0 }, { -4, -3 }, { -3, -4 }, { 0, -5 }, { 3, -4 }, { 4, -3 } };
+	bool agrees = true;
+	for (int i = 0; i < 200000 && agrees; i++)
+	{
+		long long p[4][2];
+		for (int v = 0; v < 4; v++)
+		{
+			p[v][0] = small(random);
+			p[v][1] = small(random);
+		}
+		// Every third configuration is made cocircular.
+		if (i % 3 == 0)
+		{
+			int scale = 1 + i % 12;
+			for (int v = 0; v < 4; v++)
+			{
+				p[v][0] = CIRCLE[(i + 3 * v) % 12][0] * scale;
+				p[v][1] = CIRCLE[(i + 3 * v) % 12][1] * scale;
+			}
+		}
+		if (referenceOrient2d(p[0][0], p[0][1], p[1][0], p[1][1], p[2][0], p[2][1]) <= 0)
+		{
+			continue;
+		}
+		int expected = referenceIncircle(p[0], p[1], p[2], p[3]);
+		int x = offset(random);
+		int y = offset(random);
+		agrees = incircle(int(p[0][0]) + x, int(p[0][1]) + y, int(p[1][0]) + x, int(p[1][1]) + y,
+			int(p[2][0]) + x, int(p[2][1]) + y, int(p[3][0]) + x, int(p[3][1]) + y) == expected;
+	}
+	check(agrees, "incircle on shifted small configurations");
+
+	// Circles of radius 5k with k up to 2^31 / 5, and a fourth point on, just inside, or just outside the circle.
+	std::uniform_int_distribution<int> scale(1, INT_MAX / 5);
+	std::uniform_int_distribution<int> corner(0, 11);
+	agrees = true;
+	for (int i = 0; i < 100000 && agrees; i++)
+	{
+		int k = scale(random);
+		int first = corner(random);
+		int points[3];
+		for (int v = 0; v < 3; v++)
+		{
+			points[v] = (first + 4 * v) % 12;
+		}
+		int fourth = corner(random);
+		int nudge = i % 3 - 1;
+		// Moving the fourth point along the axis it lies on changes its distance from the centre by one unit.
+		int dX = CIRCLE[fourth][0] * k;
+		int dY = CIRCLE[fourth][1] * k;
+		if (CIRCLE[fourth][1] == 0)
+		{
+			dX += CIRCLE[fourth][0] > 0 ? nudge : -nudge;
+		}
+		else if (CIRCLE[fourth][0] == 0)
+		{
+			dY += CIRCLE[fourth][1] > 0 ? nudge : -nudge;
+		}
+		else
+		{
+			nudge = 0;
+		}
+		int expected = -nudge;
+		agrees = incircle(CIRCLE[points[0]][0] * k, CIRCLE[points[0]][1] * k, CIRCLE[points[1]][0] * k, CIRCLE[points[1]][1] * k,
+			CIRCLE[points[2]][0] * k, CIRCLE[points[2]][1] * k, dX, dY) == expected;
+	}
+	check(agrees, "incircle on circles across the int range");
+
+	// Points whose squared distance from the centre differs from 25k^2 by very little: (5k, 1) lies outside by 1,
+	// and (5k - 1, y) with y the largest root of at most 10k - 1 lies inside by 10k - 1 - y^2, or on the circle.
+	agrees = true;
+	for (int i = 0; i < 100000 && agrees; i++)
+	{
+		int k = scale(random);
+		int first = corner(random);
+		int points[3];
+		for (int v = 0; v < 3; v++)
+		{
+			points[v] = (first + 4 * v) % 12;
+		}
+		long long limit = 10LL * k - 1;
+		long long y = static_cast<long long>(std::sqrt(static_cast<double>(limit)));
+		while (y * y > limit)
+		{
+			y--;
+		}
+		while ((y + 1) * (y + 1) <= limit)
+		{
+			y++;
+		}
+		int dX[2] = { 5 * k, 5 * k - 1 };
+		int dY[2] = { 1, int(y) };
+		int expected[2] = { -1, sign(limit - y * y) };
+		for (int d = 0; d < 2; d++)
+		{
+			agrees = agrees && incircle(CIRCLE[points[0]][0] * k, CIRCLE[points[0]][1] * k, CIRCLE[points[1]][0] * k, CIRCLE[points[1]][1] * k,
+				CIRCLE[points[2]][0] * k, CIRCLE[points[2]][1] * k, dX[d], dY[d]) == expected[d];
+		}
+	}
+	check(agrees, "incircle just off circles across the int range");
+}
+
+/*
+ * Checks a hull against its input: every directed edge of it is used once and its reverse once, every face has
+ * every point on or behind it, and its vertices, edges, and faces satisfy Euler's formula for a sphere.
+ *
+ * @param points The input points.
+ * @param hull The hull computed from them.
+ * @return True if every check passed.
+ */
+static bool isValidHull(const PointBuffer& points, const TriangleMesh& hull)
+{
+	const PointBuffer& corners = hull.getVertices();
+	const std::uint32_t* indices = hull.getIndices();
+	std::size_t triangleCount = hull.getTriangleCount();
+	std::map<std::pair<std::uint32_t, std::uint32_t>, int> edges;
+	for (std::size_t t = 0; t < triangleCount; t++)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			edges[std::make_pair(indices[t * 3 + i], indices[t * 3 + (i + 1) % 3])]++;
+		}
+		std::uint32_t a = indices[t * 3];
+		std::uint32_t b = indices[t * 3 + 1];
+		std::uint32_t c = indices[t * 3 + 2];
+		for (std::size_t p = 0; p < points.size(); p++)
+		{
+			if (orient3d(corners.dataX()[a], corners.dataY()[a], corners.dataZ()[a], corners.dataX()[b], corners.dataY()[b], corners.dataZ()[b],
+				corners.dataX()[c], corners.dataY()[c], corners.dataZ()[c], points.dataX()[p], points.dataY()[p], points.dataZ()[p]) > 0)
+			{
+				return false;
+			}
+		}
+	}
+	for (std::map<std::pair<std::uint32_t, std::uint32_t>, int>::const_iterator edge = edges.begin(); edge != edges.end(); ++edge)
+	{
+		std::map<std::pair<std::uint32_t, std::uint32_t>, int>::const_iterator twin = edges.find(std::make_pair(edge->first.second, edge->first.first));
+		if (edge->second != 1 || twin == edges.end() || twin->second != 1)
+		{
+			return false;
+		}
+	}
+	// V - E + F = 2, with E = 3F / 2.
+	return corners.size() + triangleCount / 2 == triangleCount + 2 && edges.size() == triangleCount * 3;
+}
+
+/*
+ * Computes the hull of a point set and checks it.
+ *
+ * @param points The points to wrap.
+ * @param name The name of the point set, for the report.
+ * @param cornerCount The number of corners the hull must have, or 0 to accept any.
+ */
+static void checkHull(const PointBuffer& points, const char* name, std::size_t cornerCount)
+{
+	TriangleMesh hull;
+	bool built = computeConvexHull(points, hull);
+	check(built && isValidHull(points, hull) && (cornerCount == 0 || hull.getVertexCount() == cornerCount), name);
+}
+
+/*
+ * Checks that a point set without volume is rejected and leaves the hull empty.
+ *
+ * @param points The points to wrap.
+ * @param name The name of the point set, for the report.
+ */
+static void checkFlatHull(const PointBuffer& points, const char* name)
+{
+	TriangleMesh hull;
+	hull.addVertex(1, 2, 3);
+	bool built = computeConvexHull(points, hull);
+	check(!built && hull.getVertexCount() == 0 && hull.getTriangleCount() == 0, name);
+}
+
+/*
+ * Checks the convex hull on point sets without volume, on lattices where most points lie on faces and edges,
+ * and on random, repeated, and extreme points.
+ */
+static void testConvexHull()
+{
+	std::mt19937 random(4);
+	{
+		PointBuffer points;
+		points.addPoint(0, 0, 0);
+		points.addPoint(1, 0, 0);
+		points.addPoint(0, 1, 0);
+		checkFlatHull(points, "hull of three points");
+	}
+	{
+		PointBuffer points;
+		for (int i = 0; i < 100; i++)
+		{
+			points.addPoint(i, 2 * i, 3 * i);
+		}
+		checkFlatHull(points, "hull of collinear points");
+	}
+	{
+		PointBuffer points;
+		for (int i = 0; i < 100; i++)
+		{
+			points.addPoint(5, 5, 5);
+		}
+		checkFlatHull(points, "hull of one repeated point");
+	}
+	{
+		PointBuffer points;
+		for (int i = 0; i < 1000; i++)
+		{
+			int a = int(random() % 1000000) - 500000;
+			int b = int(random() % 1000000) - 500000;
+			points.addPoint(a, b, 3 * a - 7 * b);
+		}
+		checkFlatHull(points, "hull of coplanar points");
+	}
+
+	// Cube lattices: only the eight corners are corners of the hull.
+	for (int n = 2; n <= 10; n += 4)
+	{
+		PointBuffer points;
+		for (int x = 0; x < n; x++)
+		{
+			for (int y = 0; y < n; y++)
+			{
+				for (int z = 0; z < n; z++)
+				{
+					points.addPoint(x, y, z);
+				}
+			}
+		}
+		checkHull(points, n == 2 ? "hull of a cube" : "hull of a cube lattice", 8);
+	}
+	{
+		// The lattice points of an octahedron, with many on its faces and edges.
+		PointBuffer points;
+		for (int x = -6; x <= 6; x++)
+		{
+			for (int y = -6; y <= 6; y++)
+			{
+				for (int z = -6; z <= 6; z++)
+				{
+					if (std::abs(x) + std::abs(y) + std::abs(z) <= 6)
+					{
+						points.addPoint(x, y, z);
+					}
+				}
+			}
+		}
+		checkHull(points, "hull of an octahedron lattice", 6);
+	}
+	{
+		PointBuffer points;
+		for (int i = 0; i < 3000; i++)
+		{
+			points.addPoint(int(random() % 20), int(random() % 20), int(random() % 20));
+		}
+		checkHull(points, "hull of repeated lattice points", 0);
+	}
+	{
+		PointBuffer points;
+		std::normal_distribution<double> normal(0.0, 1.0);
+		for (int i = 0; i < 4000; i++)
+		{
+			double x = normal(random);
+			double y = normal(random);
+			double z = normal(random);
+			double length = std::sqrt(x * x + y * y + z * z);
+			points.addPoint(int(x / length * 1e6), int(y / length * 1e6), int(z / length * 1e6));
+		}
+		checkHull(points, "hull of points on a sphere", 0);
+	}
+	{
+		PointBuffer points;
+		std::uniform_int_distribution<int> anywhere(INT_MIN, INT_MAX);
+		for (int i = 0; i < 2000; i++)
+		{
+			points.addPoint(anywhere(random), anywhere(random), anywhere(random));
+		}
+		int extremes[2] = { INT_MIN, INT_MAX };
+		for (int i = 0; i < 8; i++)
+		{
+			points.addPoint(extremes[i & 1], extremes[(i >> 1) & 1], extremes[i >> 2]);
+		}
+		checkHull(points, "hull of points across the int range", 8);
+	}
+}
+
+/*
+ * Checks a triangulation against its input: every point is copied, every triangle turns counterclockwise and
+ * has no point inside its circumcircle, no directed edge is used twice, every distinct point is used, and the
+ * triangle count is 2n - h - 2 for n distinct points with h of them on the border.
+ *
+ * @param points The input points.
+ * @param mesh The triangulation computed from them.
+ * @return True if every check passed.
+ */
+static bool isValidDelaunay(const PointBuffer& points, const TriangleMesh& mesh)
+{
+	const int* xs = mesh.getVertices().dataX();
+	const int* ys = mesh.getVertices().dataY();
+	const int* zs = mesh.getVertices().dataZ();
+	if (mesh.getVertexCount() != points.size())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < points.size(); i++)
+	{
+		if (xs[i] != points.dataX()[i] || ys[i] != points.dataY()[i] || zs[i] != points.dataZ()[i])
+		{
+			return false;
+		}
+	}
+
+	const std::uint32_t* indices = mesh.getIndices();
+	std::size_t triangleCount = mesh.getTriangleCount();
+	std::map<std::pair<std::uint32_t, std::uint32_t>, int> edges;
+	std::set<std::uint32_t> used;
+	for (std::size_t t = 0; t < triangleCount; t++)
+	{
+		std::uint32_t a = indices[t * 3];
+		std::uint32_t b = indices[t * 3 + 1];
+		std::uint32_t c = indices[t * 3 + 2];
+		used.insert(a);
+		used.insert(b);
+		used.insert(c);
+		if (orient2d(xs[a], ys[a], xs[b], ys[b], xs[c], ys[c]) <= 0)
+		{
+			return false;
+		}
+		for (int i = 0; i < 3; i++)
+		{
+			if (++edges[std::make_pair(indices[t * 3 + i], indices[t * 3 + (i + 1) % 3])] > 1)
+			{
+				return false;
+			}
+		}
+		for (std::size_t p = 0; p < points.size(); p++)
+		{
+			if (incircle(xs[a], ys[a], xs[b], ys[b], xs[c], ys[c], xs[p], ys[p]) > 0)
+			{
+				return false;
+			}
+		}
+	}
+
+	std::set<std::pair<int, int> > distinct;
+	for (std::size_t i = 0; i < points.size(); i++)
+	{
+		distinct.insert(std::make_pair(xs[i], ys[i]));
+	}
+	// The border edges are those without a twin; on a simple border each of its points starts exactly one.
+	std::set<std::uint32_t> border;
+	std::size_t borderEdges = 0;
+	for (std::map<std::pair<std::uint32_t, std::uint32_t>, int>::const_iterator edge = edges.begin(); edge != edges.end(); ++edge)
+	{
+		if (edges.find(std::make_pair(edge->first.second, edge->first.first)) == edges.end())
+		{
+			borderEdges++;
+			border.insert(edge->first.first);
+		}
+	}
+	return used.size() == distinct.size() && border.size() == borderEdges && triangleCount == 2 * distinct.size() - border.size() - 2;
+}
+
+/*
+ * Computes the triangulation of a point set and checks it.
+ *
+ * @param points The points to triangulate.
+ * @param name The name of the point set, for the report.
+ * @param triangleCount The number of triangles it must have, or 0 to accept any.
+ */
+static void checkDelaunay(const PointBuffer& points, const char* name, std::size_t triangleCount)
+{
+	TriangleMesh mesh;
+	bool built = computeDelaunayTriangulation(points, mesh);
+	check(built && isValidDelaunay(points, mesh) && (triangleCount == 0 || mesh.getTriangleCount() == triangleCount), name);
+}
+
+/*
+ * Checks the Delaunay triangulation on point sets without area, on grids and rings where many points are
+ * cocircular, and on random, repeated, and extreme points.
+ */
+static void testDelaunay()
+{
+	std::mt19937 random(5);
+	{
+		PointBuffer points;
+		for (int i = 0; i < 100; i++)
+		{
+			points.addPoint(i, 2 * i, i);
+		}
+		TriangleMesh mesh;
+		bool built = computeDelaunayTriangulation(points, mesh);
+		check(!built && mesh.getVertexCount() == 0 && mesh.getTriangleCount() == 0, "Delaunay of collinear points");
+	}
+	{
+		PointBuffer points;
+		for (int i = 0; i < 100; i++)
+		{
+			points.addPoint(3, 3, i);
+		}
+		TriangleMesh mesh;
+		check(!computeDelaunayTriangulation(points, mesh), "Delaunay of points above each other");
+	}
+	{
+		PointBuffer points;
+		points.addPoint(0, 0, 0);
+		points.addPoint(5, 0, 0);
+		points.addPoint(0, 5, 1);
+		checkDelaunay(points, "Delaunay of one triangle", 1);
+	}
+
+	// Grids: every cell has four cocircular corners, and w by h points always give 2 (w - 1) (h - 1) triangles.
+	{
+		PointBuffer points;
+		for (int x = 0; x < 30; x++)
+		{
+			for (int y = 0; y < 20; y++)
+			{
+				points.addPoint(x * 7, y * 7, x * y);
+			}
+		}
+		checkDelaunay(points, "Delaunay of a grid", 2 * 29 * 19);
+	}
+	{
+		// A grid far from the origin, where the cocircular cells have to be decided exactly.
+		PointBuffer points;
+		for (int x = 0; x < 25; x++)
+		{
+			for (int y = 0; y < 25; y++)
+			{
+				points.addPoint(INT_MAX - x * 3, INT_MIN + y * 5, 0);
+			}
+		}
+		checkDelaunay(points, "Delaunay of a grid at the edge of the int range", 2 * 24 * 24);
+	}
+	{
+		// Concentric rings of 12 cocircular points each, and their centre.
+		static const int CIRCLE[12][2] = { { 0, 5 }, { 3, 4 }, { 4, 3 }, { 5, 0 }, { 4, -3 }, { 3, -4 }, { 0, -5 }, { -3, -4 }, { -4, -3 }, { -5, 0 }, { -4, 3 }, { -3, 4 } };
+		PointBuffer points;
+		for (int r = 1; r <= 20; r++)
+		{
+			for (int i = 0; i < 12; i++)
+			{
+				points.addPoint(CIRCLE[i][0] * r * 5, CIRCLE[i][1] * r * 5, 0);
+			}
+		}
+		points.addPoint(0, 0, 0);
+		checkDelaunay(points, "Delaunay of cocircular rings", 2 * 241 - 12 - 2);
+	}
+	{
+		PointBuffer points;
+		for (int i = 0; i < 50; i++)
+		{
+			points.addPoint(i, 0, 0);
+		}
+		points.addPoint(10, 10, 0);
+		for (int i = 0; i < 50; i++)
+		{
+			points.addPoint(i, 20, 0);
+		}
+		checkDelaunay(points, "Delaunay of two parallel lines", 0);
+	}
+	{
+		PointBuffer points;
+		for (int i = 0; i < 2000; i++)
+		{
+			int t = int(random() % 1000);
+			points.addPoint(t, 3 * t + 1, 0);
+		}
+		for (int i = 0; i < 100; i++)
+		{
+			points.addPoint(int(random() % 1000), int(random() % 3000), 0);
+		}
+		checkDelaunay(points, "Delaunay of mostly collinear points", 0);
+	}
+	{
+		PointBuffer points;
+		for (int i = 0; i < 3000; i++)
+		{
+			points.addPoint(int(random() % 40), int(random() % 40), int(random() % 5));
+		}
+		checkDelaunay(points, "Delaunay of repeated points", 0);
+	}
+	{
+		PointBuffer points;
+		std::uniform_int_distribution<int> anywhere(INT_MIN, INT_MAX);
+		for (int i = 0; i < 1500; i++)
+		{
+			points.addPoint(anywhere(random), anywhere(random), anywhere(random));
+		}
+		points.addPoint(INT_MIN, INT_MIN, 0);
+		points.addPoint(INT_MAX, INT_MIN, 0);
+		points.addPoint(INT_MIN, INT_MAX, 0);
+		points.addPoint(INT_MAX, INT_MAX, 0);
+		checkDelaunay(points, "Delaunay of points across the int range", 0);
+	}
+}
+
+/*
+ * Reference separation test: whether the two triangles project to disjoint intervals on an axis.
+ * A zero axis separates nothing. The coordinates must stay below 2^11.
+ */
+static bool separates(const long long axis[3], const int first[9], const int second[9])
+{
+	if (axis[0] == 0 && axis[1] == 0 && axis[2] == 0)
+	{
+		return false;
+	}
+	long long range[2][2];
+	const int* triangles[2] = { first, second };
+	for (int t = 0; t < 2; t++)
+	{
+		for (int v = 0; v < 3; v++)
+		{
+			const int* point = triangles[t] + v * 3;
+			long long projection = axis[0] * point[0] + axis[1] * point[1] + axis[2] * point[2];
+			if (v == 0 || projection < range[t][0])
+			{
+				range[t][0] = projection;
+			}
+			if (v == 0 || projection > range[t][1])
+			{
+				range[t][1] = projection;
+			}
+		}
+	}
+	return range[0][1] < range[1][0] || range[1][1] < range[0][0];
+}
+
+/*
+ * Reference cross product of two 64-bit vectors.
+ */
+static void cross(const long long u[3], const long long v[3], long long result[3])
+{
+	result[0] = u[1] * v[2] - u[2] * v[1];
+	result[1] = u[2] * v[0] - u[0] * v[2];
+	result[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+/*
+ * Reference triangle intersection by the separating axis theorem: two triangles with area intersect unless one of
+ * the normals, the cross products of an edge of each, or the cross products of a normal and an edge separate them.
+ * The coordinates must stay below 2^11.
+ */
+static bool referenceIntersect(const int first[9], const int second[9])
+{
+	long long edges[2][3][3];
+	long long normals[2][3];
+	const int* triangles[2] = { first, second };
+	for (int t = 0; t < 2; t++)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				edges[t][i][k] = (long long)triangles[t][((i + 1) % 3) * 3 + k] - triangles[t][i * 3 + k];
+			}
+		}
+		cross(edges[t][0], edges[t][1], normals[t]);
+		if (normals[t][0] == 0 && normals[t][1] == 0 && normals[t][2] == 0)
+		{
+			return false;
+		}
+	}
+	if (separates(normals[0], first, second) || separates(normals[1], first, second))
+	{
+		return false;
+	}
+	long long axis[3];
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			cross(edges[0][i], edges[1][j], axis);
+			if (separates(axis, first, second))
+			{
+				return false;
+			}
+		}
+		for (int t = 0; t < 2; t++)
+		{
+			cross(normals[t], edges[t][i], axis);
+			if (separates(axis, first, second))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/*
+ * Reads the effective coordinates of one triangle of a mesh.
+ */
+static void readTriangle(const TriangleMesh& mesh, std::uint32_t triangle, int coordinates[9])
+{
+	std::uint32_t corners[3];
+	mesh.getTriangle(triangle, corners[0], corners[1], corners[2]);
+	for (int v = 0; v < 3; v++)
+	{
+		Point point = mesh.getEffectiveVertex(corners[v]);
+		for (int k = 0; k < 3; k++)
+		{
+			coordinates[v * 3 + k] = point.getCoordinate(k);
+		}
+	}
+}
+
+/*
+ * Adds small triangles with their own vertices at random places in a cube.
+ */
+static void addTriangleSoup(TriangleMesh& mesh, std::mt19937& random, int triangleCount, int range, int size)
+{
+	for (int t = 0; t < triangleCount; t++)
+	{
+		int x = int(random() % range);
+		int y = int(random() % range);
+		int z = int(random() % range);
+		std::uint32_t corners[3];
+		for (int v = 0; v < 3; v++)
+		{
+			corners[v] = mesh.addVertex(x + int(random() % size), y + int(random() % size), z + int(random() % size));
+		}
+		mesh.addTriangle(corners[0], corners[1], corners[2]);
+	}
+}
+
+/*
+ * Converts a pair list to a set, and reports whether it had no repeated pairs.
+ */
+static bool toPairSet(const std::vector<TrianglePair>& pairs, std::set<std::pair<std::uint32_t, std::uint32_t> >& result)
+{
+	result.clear();
+	for (std::size_t i = 0; i < pairs.size(); i++)
+	{
+		result.insert(std::make_pair(pairs[i].first, pairs[i].second));
+	}
+	return result.size() == pairs.size();
+}
+
+/*
+ * Finds the self-intersections of a mesh of two triangles that share vertices by index.
+ */
+static std::size_t countSelfIntersections(const TriangleMesh& mesh)
+{
+	MeshBvh hierarchy;
+	hierarchy.build(mesh);
+	std::vector<TrianglePair> pairs;
+	findSelfIntersections(hierarchy, pairs);
+	return pairs.size();
+}
+
+/*
+ * Checks intersectTriangles() against the separating axis reference on small, often degenerate triangles,
+ * then the pair lists of two meshes and the self-intersections of one against a brute-force comparison of every pair,
+ * and the rules for triangles that share vertices.
+ */
+static void testIntersections()
+{
+	std::mt19937 random(6);
+	bool agrees = true;
+	for (int i = 0; i < 200000 && agrees; i++)
+	{
+		int first[9];
+		int second[9];
+		int range = i % 3 == 0 ? 3 : (i % 3 == 1 ? 6 : 1024);
+		for (int k = 0; k < 9; k++)
+		{
+			first[k] = int(random() % range);
+			second[k] = int(random() % range);
+		}
+		// Every fifth pair is coplanar, and every seventh shares a corner position.
+		if (i % 5 == 0)
+		{
+			for (int k = 2; k < 9; k += 3)
+			{
+				first[k] = 0;
+				second[k] = 0;
+			}
+		}
+		if (i % 7 == 0)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				second[k] = first[3 + k];
+			}
+		}
+		agrees = intersectTriangles(first, second) == referenceIntersect(first, second);
+	}
+	check(agrees, "intersectTriangles against the separating axis test");
+
+	TriangleMesh firstMesh;
+	TriangleMesh secondMesh;
+	addTriangleSoup(firstMesh, random, 1500, 1000, 60);
+	addTriangleSoup(secondMesh, random, 1200, 1000, 60);
+	secondMesh.translate(5, 'x');
+	MeshBvh firstHierarchy;
+	MeshBvh secondHierarchy;
+	firstHierarchy.build(firstMesh);
+	secondHierarchy.build(secondMesh);
+
+	std::set<std::pair<std::uint32_t, std::uint32_t> > expected;
+	std::set<std::pair<std::uint32_t, std::uint32_t> > found;
+	int a[9];
+	int b[9];
+	for (std::uint32_t i = 0; i < firstMesh.getTriangleCount(); i++)
+	{
+		readTriangle(firstMesh, i, a);
+		for (std::uint32_t j = 0; j < secondMesh.getTriangleCount(); j++)
+		{
+			readTriangle(secondMesh, j, b);
+			if (referenceIntersect(a, b))
+			{
+				expected.insert(std::make_pair(i, j));
+			}
+		}
+	}
+	std::vector<TrianglePair> pairs;
+	findIntersectingTriangles(firstHierarchy, secondHierarchy, pairs);
+	check(toPairSet(pairs, found) && found == expected && !expected.empty(), "intersecting pairs of two meshes");
+
+	expected.clear();
+	for (std::uint32_t i = 0; i < firstMesh.getTriangleCount(); i++)
+	{
+		readTriangle(firstMesh, i, a);
+		for (std::uint32_t j = i + 1; j < firstMesh.getTriangleCount(); j++)
+		{
+			readTriangle(firstMesh, j, b);
+			if (referenceIntersect(a, b))
+			{
+				expected.insert(std::make_pair(i, j));
+			}
+		}
+	}
+	findSelfIntersections(firstHierarchy, pairs);
+	check(toPairSet(pairs, found) && found == expected && !expected.empty(), "self-intersections of a mesh");
+
+	// A closed convex surface does not intersect itself.
+	PointBuffer points;
+	std::normal_distribution<double> normal(0.0, 1.0);
+	for (int i = 0; i < 5000; i++)
+	{
+		double x = normal(random);
+		double y = normal(random);
+		double z = normal(random);
+		double length = std::sqrt(x * x + y * y + z * z);
+		points.addPoint(int(x / length * 1e5), int(y / length * 1e5), int(z / length * 1e5));
+	}
+	TriangleMesh hull;
+	computeConvexHull(points, hull);
+	MeshBvh hullHierarchy;
+	hullHierarchy.build(hull);
+	findSelfIntersections(hullHierarchy, pairs);
+	check(pairs.empty(), "self-intersections of a convex hull");
+
+	// A triangle in the plane z = 0 and a second one that shares either its first edge or its first corner.
+	struct SharedCase
+	{
+		// The name of the case, for the report.
+		const char* name;
+		// The corners the second triangle adds: one when it shares the edge, two when it shares the corner.
+		int corners[2][3];
+		bool sharesEdge;
+		// Whether the two triangles must be reported.
+		bool intersects;
+	};
+	static const SharedCase CASES[] = {
+		{ "triangles hinged on an edge", { { 0, 0, 10 }, { 0, 0, 0 } }, true, false },
+		{ "coplanar triangles on both sides of an edge", { { 5, -5, 0 }, { 0, 0, 0 } }, true, false },
+		{ "triangles folded onto each other across an edge", { { 3, 3, 0 }, { 0, 0, 0 } }, true, true },
+		{ "triangles touching at a shared corner", { { -5, 0, 3 }, { 0, -5, 3 } }, false, false },
+		{ "triangles crossing away from a shared corner", { { 2, 2, 5 }, { 2, 2, -5 } }, false, true }
+	};
+	for (std::size_t i = 0; i < sizeof(CASES) / sizeof(CASES[0]); i++)
+	{
+		TriangleMesh mesh;
+		std::uint32_t origin = mesh.addVertex(0, 0, 0);
+		std::uint32_t right = mesh.addVertex(10, 0, 0);
+		std::uint32_t up = mesh.addVertex(0, 10, 0);
+		mesh.addTriangle(origin, right, up);
+		std::uint32_t p = mesh.addVertex(CASES[i].corners[0][0], CASES[i].corners[0][1], CASES[i].corners[0][2]);
+		if (CASES[i].sharesEdge)
+		{
+			mesh.addTriangle(right, origin, p);
+		}
+		else
+		{
+			std::uint32_t q = mesh.addVertex(CASES[i].corners[1][0], CASES[i].corners[1][1], CASES[i].corners[1][2]);
+			mesh.addTriangle(origin, p, q);
+		}
+		check(countSelfIntersections(mesh) == (CASES[i].intersects ? 1u : 0u), CASES[i].name);
+	}
+}
+
+/*
+ * Runs every geometry test and reports the result.
+ *
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main()
+{
+	testOrient2d();
+	testOrient3d();
+	testIncircle();
+	testConvexHull();
+	testDelaunay();
+	testIntersections();
+
+	if (failures == 0)
+	{
+		std::cout << "All geometry tests passed." << std::endl;
+		return 0;
+	}
+	std::cout << failures << " geometry check(s) failed." << std::endl;
+	return 1;
+}
@@ -0,0 +1,188 @@
+// Includes the ThreadPool.h header file for function declarations.
+#include "ThreadPool.h"
+
+/*
+ * Constructor for the ThreadPool class.
+ * Starts threadCount - 1 workers, since the caller of parallelFor() also runs tasks.
+ *
+ * @param threadCount The number of threads that run tasks. 0 uses one thread per hardware core.
+ */
+ThreadPool::ThreadPool(std::size_t threadCount) : task(nullptr), taskCount(0), nextTask(0), busyWorkers(0), jobNumber(0), stopping(false)
+{
+	// Use every hardware core by default; the count may be unknown, in which case it is reported as 0.
+	if (threadCount == 0)
+	{
+		threadCount = std::thread::hardware_concurrency();
+	}
+	if (threadCount == 0)
+	{
+		threadCount = 1;
+	}
+
+	// Start the workers.
+	for (std::size_t i = 1; i < threadCount; i++)
+	{
+		workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+/*
+ * Destructor for the ThreadPool class.
+ * Tells the workers to stop and waits for each of them to exit.
+ */
+ThreadPool::~ThreadPool()
+{
+	// Flag the shutdown and wake every worker.
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		stopping = true;
+	}
+	jobPosted.notify_all();
+
+	// Wait for the workers to exit.
+	for (std::size_t i = 0; i < workers.size(); i++)
+	{
+		workers[i].join();
+	}
+}
+
+/*
+ * Returns the number of threads that run tasks, including the caller of parallelFor().
+ *
+ * @return The number of threads.
+ */
+std::size_t ThreadPool::getThreadCount() const
+{
+	return workers.size() + 1;
+}
+
+/*
+ * Takes tasks from the shared counter and runs them until none are left.
+ */
+void ThreadPool::runTasks()
+{
+	// Each fetch_add hands out a distinct task index, so no task runs twice.
+	for (std::size_t i = nextTask.fetch_add(1); i < taskCount; i = nextTask.fetch_add(1))
+	{
+		(*task)(i);
+	}
+}
+
+/*
+ * The loop each worker thread runs until the pool is destroyed.
+ */
+void ThreadPool::workerLoop()
+{
+	// The last job this worker has taken part in.
+	unsigned long long seenJob = 0;
+
+	while (true)
+	{
+		// Sleep until a new job is posted or the pool shuts down.
+		{
+			std::unique_lock<std::mutex> lock(stateMutex);
+			jobPosted.wait(lock, [&]() { return stopping || jobNumber != seenJob; });
+			if (stopping)
+			{
+				return;
+			}
+			seenJob = jobNumber;
+		}
+
+		// Work on the job alongside the other threads.
+		runTasks();
+
+		// Report that this worker is done; the last one wakes the caller.
+		{
+			std::lock_guard<std::mutex> lock(stateMutex);
+			busyWorkers--;
+			if (busyWorkers == 0)
+			{
+				jobFinished.notify_one();
+			}
+		}
+	}
+}
+
+/*
+ * Runs function(i) for every i from 0 to count - 1 across all threads and waits until all have finished.
+ *
+ * @param count The number of tasks.
+ * @param function The function to run for each task index.
+ */
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& function)
+{
+	// Small jobs, or a pool without workers, run directly on the calling thread.
+	if (workers.empty() || count <= 1)
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			function(i);
+		}
+		return;
+	}
+
+	// Only one job runs at a time.
+	std::lock_guard<std::mutex> submit(submitMutex);
+
+	// Describe the job and wake the workers.
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		task = &function;
+		taskCount = count;
+		nextTask.store(0);
+		busyWorkers = workers.size();
+		jobNumber++;
+	}
+	jobPosted.notify_all();
+
+	// The calling thread works too instead of waiting idle.
+	runTasks();
+
+	// Wait until every worker has stopped touching the job.
+	std::unique_lock<std::mutex> lock(stateMutex);
+	jobFinished.wait(lock, [&]() { return busyWorkers == 0; });
+	task = nullptr;
+}
+
+/*
+ * Runs a function over consecutive chunks of items across all threads and waits until all have finished.
+ *
+ * @param count The number of items.
+ * @param chunkSize The number of items in a chunk.
+ * @param function The function to run for each chunk, given its index, its first item, and one past its last item.
+ */
+void ThreadPool::parallelForChunks(std::size_t count, std::size_t chunkSize, const std::function<void(std::size_t, std::size_t, std::size_t)>& function)
+{
+	parallelFor(getChunkCount(count, chunkSize), [&](std::size_t chunk)
+	{
+		std::size_t first = chunk * chunkSize;
+		// The last chunk stops at the end of the items.
+		std::size_t last = count - first > chunkSize ? first + chunkSize : count;
+		function(chunk, first, last);
+	});
+}
+
+/*
+ * Returns the number of chunks parallelForChunks() cuts a number of items into.
+ *
+ * @param count The number of items.
+ * @param chunkSize The number of items in a chunk.
+ * @return The number of chunks.
+ */
+std::size_t ThreadPool::getChunkCount(std::size_t count, std::size_t chunkSize)
+{
+	return (count + chunkSize - 1) / chunkSize;
+}
+
+/*
+ * Returns a pool shared by the whole program, created on first use with one thread per core.
+ *
+ * @return A reference to the shared pool.
+ */
+ThreadPool& ThreadPool::getShared()
+{
+	// The static local is created on the first call only, and thread-safely.
+	static ThreadPool shared;
+	return shared;
+}
@@ -0,0 +1,126 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+// Includes the atomic library for the shared task counter.
+#include <atomic>
+// Includes the condition_variable library to put idle workers to sleep.
+#include <condition_variable>
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the functional library for std::function, the type of a parallel task.
+#include <functional>
+// Includes the mutex library to protect the pool's shared state.
+#include <mutex>
+// Includes the thread library for the worker threads.
+#include <thread>
+// Includes the vector library to hold the worker threads.
+#include <vector>
+
+/*
+ * Defines a ThreadPool class that keeps one worker thread per core alive for the whole program.
+ * parallelFor() splits a job into numbered tasks; workers and the calling thread take the next
+ * task from a shared counter until none are left, so uneven tasks balance themselves.
+ */
+class ThreadPool
+{
+private:
+	// The worker threads. The calling thread of parallelFor() works as well, so there is one fewer than the thread count.
+	std::vector<std::thread> workers;
+	// Serializes parallelFor() calls coming from different threads.
+	std::mutex submitMutex;
+	// Protects the job description and the worker bookkeeping below.
+	std::mutex stateMutex;
+	// Wakes the workers when a job is posted or the pool shuts down.
+	std::condition_variable jobPosted;
+	// Wakes the calling thread when every worker has finished the job.
+	std::condition_variable jobFinished;
+	// The task of the current job, or nullptr between jobs.
+	const std::function<void(std::size_t)>* task;
+	// Number of tasks in the current job.
+	std::size_t taskCount;
+	// Index of the next task to hand out.
+	std::atomic<std::size_t> nextTask;
+	// Number of workers still busy with the current job.
+	std::size_t busyWorkers;
+	// Incremented for every job so workers can tell a new job from a spurious wakeup.
+	unsigned long long jobNumber;
+	// Set by the destructor to make the workers exit.
+	bool stopping;
+
+	/*
+	 * The loop each worker thread runs until the pool is destroyed.
+	 */
+	void workerLoop();
+
+	/*
+	 * Takes tasks from the shared counter and runs them until none are left.
+	 */
+	void runTasks();
+
+public:
+	/*
+	 * Constructor for the ThreadPool class.
+	 *
+	 * @param threadCount The number of threads that run tasks, including the caller of parallelFor().
+	 *                    0 uses one thread per hardware core.
+	 */
+	explicit ThreadPool(std::size_t threadCount = 0);
+
+	/*
+	 * Destructor for the ThreadPool class.
+	 * It stops and joins every worker thread.
+	 */
+	~ThreadPool();
+
+	// The pool owns its threads, so it cannot be copied.
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/*
+	 * Returns the number of threads that run tasks, including the caller of parallelFor().
+	 *
+	 * @return The number of threads.
+	 */
+	std::size_t getThreadCount() const;
+
+	/*
+	 * Runs function(i) for every i from 0 to count - 1 across all threads and waits until all have finished.
+	 * Tasks may run in any order and on any thread. They must not throw and must not call parallelFor() on the same pool.
+	 *
+	 * @param count The number of tasks.
+	 * @param function The function to run for each task index.
+	 */
+	void parallelFor(std::size_t count, const std::function<void(std::size_t)>& function);
+
+	/*
+	 * Cuts the items from 0 to count - 1 into chunks of chunkSize consecutive items, the last one possibly shorter,
+	 * and runs function(chunk, first, last) for each chunk across all threads, where first and last bound the chunk's items.
+	 * The chunks depend only on count and chunkSize, never on the thread count, so per-chunk results combined in
+	 * chunk order come out the same on every machine. The same rules as for parallelFor() apply to the function.
+	 *
+	 * @param count The number of items.
+	 * @param chunkSize The number of items in a chunk. It must be at least 1.
+	 * @param function The function to run for each chunk, given its index, its first item, and one past its last item.
+	 */
+	void parallelForChunks(std::size_t count, std::size_t chunkSize, const std::function<void(std::size_t, std::size_t, std::size_t)>& function);
+
+	/*
+	 * Returns the number of chunks parallelForChunks() cuts a number of items into, for sizing per-chunk results.
+	 *
+	 * @param count The number of items.
+	 * @param chunkSize The number of items in a chunk.
+	 * @return The number of chunks.
+	 */
+	static std::size_t getChunkCount(std::size_t count, std::size_t chunkSize);
+
+	/*
+	 * Returns a pool shared by the whole program, created on first use with one thread per core.
+	 *
+	 * @return A reference to the shared pool.
+	 */
+	static ThreadPool& getShared();
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif
@@ -2,17 +2,23 @@
 #include "Triangle.h"
 // Includes the Point.h header file for function declarations.
 #include "Point.h"
+// Includes the ExactMath.h header file for the overflow-free area calculation.
+#include "ExactMath.h"
 
+// Includes the algorithm library for std::min and std::max.
+#include <algorithm>
+// Includes the climits library for the range of int coordinates.
+#include <climits>
 // Includes the input/output stream library for IO operations.
 #include <iostream>
-// Includes cmath for the sqrt function used in area calculation.
-#include <cmath>
 
 /*
  * Default constructor for the Triangle class.
  * Initializes all vertex pointers to nullptr, meaning no vertices are assigned.
  */
-Triangle::Triangle() : vertex_1(nullptr), vertex_2(nullptr), vertex_3(nullptr)
+Triangle::Triangle() : vertex_1(nullptr), vertex_2(nullptr), vertex_3(nullptr), ownsVertices(true),
+	areaCacheEnabled(false), areaCacheValid(false), cachedArea(0.0), areaCacheHits(0), areaCacheMisses(0),
+	boundsCacheValid(false), boundsMin{ 0, 0, 0 }, boundsMax{ 0, 0, 0 }, coordinateSum{ 0, 0, 0 }
 {
 	// Constructor body is empty since initialization is done in the initialization list.
 }
@@ -24,7 +30,22 @@ Triangle::Triangle() : vertex_1(nullptr), vertex_2(nullptr), vertex_3(nullptr)
  * @param b Pointer to the second vertex (Point).
  * @param c Pointer to the third vertex (Point).
  */
-Triangle::Triangle(Point* a, Point* b, Point* c)
+Triangle::Triangle(Point* a, Point* b, Point* c) : Triangle(a, b, c, true)
+{
+	// Constructor body is empty since the triangle takes ownership of the vertices in the delegated constructor.
+}
+
+/*
+ * Constructor for the Triangle class that initializes the 3 vertices and states who owns them.
+ *
+ * @param a Pointer to the first vertex (Point).
+ * @param b Pointer to the second vertex (Point).
+ * @param c Pointer to the third vertex (Point).
+ * @param ownsVerticesParameter True if the triangle deletes the vertices, false if another owner such as an Arena frees them.
+ */
+Triangle::Triangle(Point* a, Point* b, Point* c, bool ownsVerticesParameter) : ownsVertices(ownsVerticesParameter),
+	areaCacheEnabled(false), areaCacheValid(false), cachedArea(0.0), areaCacheHits(0), areaCacheMisses(0),
+	boundsCacheValid(false), boundsMin{ 0, 0, 0 }, boundsMax{ 0, 0, 0 }, coordinateSum{ 0, 0, 0 }
 {	
 	// The first vertex of the triangle is assigned the memory address of point 'a'.
 	vertex_1 = a;
@@ -34,12 +55,87 @@ Triangle::Triangle(Point* a, Point* b, Point* c)
 	vertex_3 = c;
 }
 
+/*
+ * Move constructor that takes over the vertices and the cached area of another triangle.
+ *
+ * @param other The triangle to move from. It is left without vertices.
+ */
+Triangle::Triangle(Triangle&& other) noexcept : vertex_1(other.vertex_1), vertex_2(other.vertex_2), vertex_3(other.vertex_3),
+	ownsVertices(other.ownsVertices), areaCacheEnabled(other.areaCacheEnabled), areaCacheValid(other.areaCacheValid),
+	cachedArea(other.cachedArea), areaCacheHits(other.areaCacheHits), areaCacheMisses(other.areaCacheMisses),
+	boundsCacheValid(other.boundsCacheValid), boundsMin{ other.boundsMin[0], other.boundsMin[1], other.boundsMin[2] },
+	boundsMax{ other.boundsMax[0], other.boundsMax[1], other.boundsMax[2] },
+	coordinateSum{ other.coordinateSum[0], other.coordinateSum[1], other.coordinateSum[2] }
+{
+	// The other triangle no longer refers to the vertices, so its destructor leaves them alone.
+	other.vertex_1 = nullptr;
+	other.vertex_2 = nullptr;
+	other.vertex_3 = nullptr;
+	other.areaCacheValid = false;
+	other.boundsCacheValid = false;
+}
+
+/*
+ * Move assignment operator that frees this triangle's owned vertices and takes over those of another triangle.
+ *
+ * @param other The triangle to move from. It is left without vertices.
+ * @return A reference to this triangle.
+ */
+Triangle& Triangle::operator=(Triangle&& other) noexcept
+{
+	// Moving a triangle onto itself changes nothing.
+	if (this == &other)
+	{
+		return *this;
+	}
+
+	// Free the vertices this triangle owns before taking over the new ones.
+	if (ownsVertices)
+	{
+		delete vertex_1;
+		delete vertex_2;
+		delete vertex_3;
+	}
+
+	// Take over the vertices, the ownership, and the cache of the other triangle.
+	vertex_1 = other.vertex_1;
+	vertex_2 = other.vertex_2;
+	vertex_3 = other.vertex_3;
+	ownsVertices = other.ownsVertices;
+	areaCacheEnabled = other.areaCacheEnabled;
+	areaCacheValid = other.areaCacheValid;
+	cachedArea = other.cachedArea;
+	areaCacheHits = other.areaCacheHits;
+	areaCacheMisses = other.areaCacheMisses;
+	boundsCacheValid = other.boundsCacheValid;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		boundsMin[axis] = other.boundsMin[axis];
+		boundsMax[axis] = other.boundsMax[axis];
+		coordinateSum[axis] = other.coordinateSum[axis];
+	}
+
+	// The other triangle no longer refers to the vertices, so its destructor leaves them alone.
+	other.vertex_1 = nullptr;
+	other.vertex_2 = nullptr;
+	other.vertex_3 = nullptr;
+	other.areaCacheValid = false;
+	other.boundsCacheValid = false;
+	return *this;
+}
+
 /*
  * Destructor for the Triangle class.
- * Deletes the dynamically allocated memory for the three vertex points.
+ * Deletes the dynamically allocated memory for the three vertex points if the triangle owns them.
  */
 Triangle::~Triangle()
 {
+	// Vertices that belong to another owner, such as an Arena, are freed by that owner.
+	if (!ownsVertices)
+	{
+		return;
+	}
+
 	// Checks if the first vertex is not nullptr, then deletes the allocated memory.
 	if (vertex_1 != nullptr)
 	{
@@ -61,6 +157,7 @@ Triangle::~Triangle()
 
 /*
  * Translates the entire triangle by a specified distance along a given axis.
+ * Moving all three vertices together keeps the shape, so the cached area stays valid.
  *
  * @param d The distance to translate the triangle along the axis.
  * @param axis The axis along which to translate ('x', 'y', or 'z').
@@ -84,11 +181,116 @@ void Triangle::translate(int d, char axis)
 	{
 		vertex_3->translate(d, axis);
 	}
+
+	// The box and the centroid move with the vertices, so only the translated axis is updated.
+	// As in TriangleMesh, a side that would leave the int range marks the cache out of date instead.
+	int index = axis == 'x' ? 0 : axis == 'y' ? 1 : axis == 'z' ? 2 : -1;
+	if (boundsCacheValid && index >= 0)
+	{
+		long long lowest = static_cast<long long>(boundsMin[index]) + d;
+		long long highest = static_cast<long long>(boundsMax[index]) + d;
+		if (lowest < INT_MIN || highest > INT_MAX)
+		{
+			boundsCacheValid = false;
+		}
+		else
+		{
+			boundsMin[index] = static_cast<int>(lowest);
+			boundsMax[index] = static_cast<int>(highest);
+			coordinateSum[index] += 3LL * d;
+		}
+	}
+}
+
+/*
+ * Moves a single vertex by a specified distance along a given axis.
+ *
+ * @param vertex The vertex to move (1, 2, or 3).
+ * @param d The distance to move the vertex along the axis.
+ * @param axis The axis along which to move ('x', 'y', or 'z').
+ * @return 0 if successful, -1 if the vertex or the axis is invalid.
+ */
+int Triangle::translateVertex(int vertex, int d, char axis)
+{
+	// Select the vertex to move.
+	Point* selected = nullptr;
+	switch (vertex)
+	{
+	case 1:
+		selected = vertex_1;
+		break;
+	case 2:
+		selected = vertex_2;
+		break;
+	case 3:
+		selected = vertex_3;
+		break;
+	default:
+		return -1;
+	}
+
+	// Return -1 if the selected vertex has not been assigned.
+	if (selected == nullptr)
+	{
+		return -1;
+	}
+
+	// Move the vertex and drop the cached area, box, and centroid if the shape actually changed.
+	int result = selected->translate(d, axis);
+	if (result == 0)
+	{
+		invalidateAreaCache();
+		invalidateBoundsCache();
+	}
+	return result;
+}
+
+/*
+ * Read-only access to one of the triangle's vertices.
+ *
+ * @param vertex The vertex to return (1, 2, or 3).
+ * @return A pointer to the vertex, or nullptr if the number is invalid or the vertex is not assigned.
+ */
+const Point* Triangle::getVertex(int vertex) const
+{
+	switch (vertex)
+	{
+	case 1:
+		return vertex_1;
+	case 2:
+		return vertex_2;
+	case 3:
+		return vertex_3;
+	default:
+		return nullptr;
+	}
+}
+
+/*
+ * Writable access to one of the triangle's vertices.
+ *
+ * @param vertex The vertex to return (1, 2, or 3).
+ * @return A pointer to the vertex, or nullptr if the number is invalid or the vertex is not assigned.
+ */
+Point* Triangle::getVertex(int vertex)
+{
+	switch (vertex)
+	{
+	case 1:
+		return vertex_1;
+	case 2:
+		return vertex_2;
+	case 3:
+		return vertex_3;
+	default:
+		return nullptr;
+	}
 }
 
 /*
  * Calculates the area of the triangle using the vertices' coordinates.
  * Uses the cross product of two vectors formed by the vertices to compute the area.
+ * The cross product is evaluated in 64-bit or 128-bit arithmetic, so it does not overflow for any int coordinates.
  *
  * @return The area of the triangle. Returns 0.0 if any vertex is not assigned.
  */
@@ -100,26 +302,159 @@ double Triangle::calcArea()
 		return 0.0;
 	}
 
-	// Compute Vector AB based on the coordinates of the first and second vertices.
-	int abX = vertex_2->getCoordinateX() - vertex_1->getCoordinateX();
-	int abY = vertex_2->getCoordinateY() - vertex_1->getCoordinateY();
-	int abZ = vertex_2->getCoordinateZ() - vertex_1->getCoordinateZ();
+	// Reuse the cached area if the shape has not changed since it was computed.
+	if (areaCacheEnabled && areaCacheValid)
+	{
+		areaCacheHits++;
+		return cachedArea;
+	}
 
-	// Compute Vector AC based on the coordinates of the first and third vertices.
-	int acX = vertex_3->getCoordinateX() - vertex_1->getCoordinateX();
-	int acY = vertex_3->getCoordinateY() - vertex_1->getCoordinateY();
-	int acZ = vertex_3->getCoordinateZ() - vertex_1->getCoordinateZ();
+	// Compute the area from the vertices' coordinates without overflowing on large coordinates.
+	double area = calcTriangleArea(vertex_1->getCoordinateX(), vertex_1->getCoordinateY(), vertex_1->getCoordinateZ(),
+		vertex_2->getCoordinateX(), vertex_2->getCoordinateY(), vertex_2->getCoordinateZ(),
+		vertex_3->getCoordinateX(), vertex_3->getCoordinateY(), vertex_3->getCoordinateZ());
 
-	// Compute the cross product of vectors AB and AC.
-	int vX = abY * acZ - acY * abZ;
-	int vY = -(abX * acZ - acX * abZ);
-	int vZ = abX * acY - acX * abY;
+	// Remember the area for later calls if the cache is enabled.
+	if (areaCacheEnabled)
+	{
+		areaCacheMisses++;
+		cachedArea = area;
+		areaCacheValid = true;
+	}
+	return area;
+}
+
+/*
+ * Turns the area cache on or off.
+ *
+ * @param enabled True to cache the area, false to compute it on every call.
+ */
+void Triangle::setAreaCacheEnabled(bool enabled)
+{
+	areaCacheEnabled = enabled;
+	// A disabled cache keeps nothing, so it starts empty when turned back on.
+	if (!enabled)
+	{
+		areaCacheValid = false;
+	}
+}
 
-	// Compute the magnitude of the cross product vector.
-	double crossProductMagnitude = sqrt(vX * vX + vY * vY + vZ * vZ);
+/*
+ * Checks whether the area cache is turned on.
+ *
+ * @return True if the area cache is enabled.
+ */
+bool Triangle::isAreaCacheEnabled() const
+{
+	return areaCacheEnabled;
+}
+
+/*
+ * Drops the cached area so the next calcArea call computes it again.
+ */
+void Triangle::invalidateAreaCache()
+{
+	areaCacheValid = false;
+}
+
+/*
+ * Returns the number of calcArea calls answered from the cache.
+ *
+ * @return The number of cache hits.
+ */
+unsigned long long Triangle::getAreaCacheHits() const
+{
+	return areaCacheHits;
+}
+
+/*
+ * Returns the number of calcArea calls that computed the area while the cache was enabled.
+ *
+ * @return The number of cache misses.
+ */
+unsigned long long Triangle::getAreaCacheMisses() const
+{
+	return areaCacheMisses;
+}
 
-	// The area of the triangle is half the magnitude of the cross product.
-	return 0.5 * crossProductMagnitude;
+/*
+ * Fills the cached box and coordinate sums from the three vertices.
+ */
+void Triangle::refreshBounds()
+{
+	const Point* corners[3] = { vertex_1, vertex_2, vertex_3 };
+	for (int axis = 0; axis < 3; axis++)
+	{
+		boundsMin[axis] = corners[0]->getCoordinate(axis);
+		boundsMax[axis] = boundsMin[axis];
+		coordinateSum[axis] = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			int value = corners[i]->getCoordinate(axis);
+			boundsMin[axis] = std::min(boundsMin[axis], value);
+			boundsMax[axis] = std::max(boundsMax[axis], value);
+			coordinateSum[axis] += value;
+		}
+	}
+	boundsCacheValid = true;
+}
+
+/*
+ * Returns the axis-aligned box around the triangle.
+ *
+ * @param minimum Receives the smallest coordinate on each axis.
+ * @param maximum Receives the largest coordinate on each axis.
+ * @return True if the box was returned, false if any vertex is not assigned.
+ */
+bool Triangle::getBounds(Point& minimum, Point& maximum)
+{
+	// A triangle with a missing vertex has no box.
+	if (vertex_1 == nullptr || vertex_2 == nullptr || vertex_3 == nullptr)
+	{
+		return false;
+	}
+	if (!boundsCacheValid)
+	{
+		refreshBounds();
+	}
+
+	minimum = Point(boundsMin[0], boundsMin[1], boundsMin[2]);
+	maximum = Point(boundsMax[0], boundsMax[1], boundsMax[2]);
+	return true;
+}
+
+/*
+ * Returns the centroid of the triangle.
+ *
+ * @param x Receives the x-coordinate of the centroid.
+ * @param y Receives the y-coordinate of the centroid.
+ * @param z Receives the z-coordinate of the centroid.
+ * @return True if the centroid was returned, false if any vertex is not assigned.
+ */
+bool Triangle::getCentroid(double& x, double& y, double& z)
+{
+	// A triangle with a missing vertex has no centroid.
+	if (vertex_1 == nullptr || vertex_2 == nullptr || vertex_3 == nullptr)
+	{
+		return false;
+	}
+	if (!boundsCacheValid)
+	{
+		refreshBounds();
+	}
+
+	x = coordinateSum[0] / 3.0;
+	y = coordinateSum[1] / 3.0;
+	z = coordinateSum[2] / 3.0;
+	return true;
+}
+
+/*
+ * Drops the cached box and centroid so the next query computes them again.
+ */
+void Triangle::invalidateBoundsCache()
+{
+	boundsCacheValid = false;
 }
 
 /*
@@ -27,6 +27,33 @@ private:
 	* It will point to a dynamically allocated Point object.
 	*/
 	Point* vertex_3;
+
+	// Whether the destructor deletes the three vertices. False when they belong to an Arena.
+	bool ownsVertices;
+
+	// Whether calcArea stores its result and reuses it until the shape changes.
+	bool areaCacheEnabled;
+	// Whether cachedArea holds the area of the current shape.
+	bool areaCacheValid;
+	// The last area computed while the cache was enabled.
+	double cachedArea;
+	// Number of calcArea calls answered from the cache.
+	unsigned long long areaCacheHits;
+	// Number of calcArea calls that had to compute the area.
+	unsigned long long areaCacheMisses;
+
+	// Whether the cached box and coordinate sums describe the current vertices.
+	bool boundsCacheValid;
+	// Smallest and largest coordinate of the three vertices on each axis.
+	int boundsMin[3];
+	int boundsMax[3];
+	// Sum of the three vertices' coordinates on each axis, three times the centroid.
+	long long coordinateSum[3];
+
+	/*
+	 * Fills the cached box and coordinate sums from the three vertices.
+	 */
+	void refreshBounds();
 	
 public:
 	/*
@@ -44,27 +71,140 @@ public:
 	 */
 	Triangle(Point *a, Point *b, Point *c);
 
+	/*
+	 * Constructor for the Triangle class that initializes the 3 vertices and states who owns them.
+	 *
+	 * @param a Pointer to the first vertex (Point).
+	 * @param b Pointer to the second vertex (Point).
+	 * @param c Pointer to the third vertex (Point).
+	 * @param ownsVerticesParameter True if the triangle deletes the vertices, false if another owner such as an Arena frees them.
+	 */
+	Triangle(Point* a, Point* b, Point* c, bool ownsVerticesParameter);
+
 	/*
 	 * Destructor for the Triangle class. 
-	 * It deletes the dynamically allocated vertices.
+	 * It deletes the dynamically allocated vertices if the triangle owns them.
 	 */
 	~Triangle();
 
+	// Copying would leave two triangles deleting the same vertices, so triangles can only be moved.
+	Triangle(const Triangle&) = delete;
+	Triangle& operator=(const Triangle&) = delete;
+
+	/*
+	 * Move constructor that takes over the vertices and the cached area of another triangle.
+	 *
+	 * @param other The triangle to move from. It is left without vertices.
+	 */
+	Triangle(Triangle&& other) noexcept;
+
+	/*
+	 * Move assignment operator that frees this triangle's owned vertices and takes over those of another triangle.
+	 *
+	 * @param other The triangle to move from. It is left without vertices.
+	 * @return A reference to this triangle.
+	 */
+	Triangle& operator=(Triangle&& other) noexcept;
+
 	/*
 	 * Translates the entire triangle by a specified distance along a given axis.
+	 * The cached box and centroid are shifted along with it instead of being computed again.
 	 *
 	 * @param d The distance to translate the triangle along the axis.
 	 * @param axis The axis along which to translate ('x', 'y', or 'z').
 	 */
 	void translate(int d, char axis);
 
+	/*
+	 * Moves a single vertex by a specified distance along a given axis, changing the triangle's shape.
+	 * This drops the cached area, box, and centroid.
+	 *
+	 * @param vertex The vertex to move (1, 2, or 3).
+	 * @param d The distance to move the vertex along the axis.
+	 * @param axis The axis along which to move ('x', 'y', or 'z').
+	 * @return 0 if successful, -1 if the vertex or the axis is invalid.
+	 */
+	int translateVertex(int vertex, int d, char axis);
+
+	/*
+	 * Access to one of the triangle's vertices. Moving a vertex through the returned pointer
+	 * does not drop the cached area, box, or centroid; use translateVertex() for that.
+	 *
+	 * @param vertex The vertex to return (1, 2, or 3).
+	 * @return A pointer to the vertex, or nullptr if the number is invalid or the vertex is not assigned.
+	 */
+	const Point* getVertex(int vertex) const;
+	Point* getVertex(int vertex);
+
 	/*
 	 * Calculates the area of the triangle using the vertices' coordinates.
+	 * With the area cache enabled, the result is reused until a vertex is moved on its own;
+	 * translating the whole triangle keeps the cached area because it does not change the shape.
 	 *
 	 * @return The area of the triangle.
 	 */
 	double calcArea();
+
+	/*
+	 * Turns the area cache on or off. Turning it off also drops the cached area.
+	 *
+	 * @param enabled True to cache the area, false to compute it on every call.
+	 */
+	void setAreaCacheEnabled(bool enabled);
+
+	/*
+	 * Checks whether the area cache is turned on.
+	 *
+	 * @return True if the area cache is enabled.
+	 */
+	bool isAreaCacheEnabled() const;
+
+	/*
+	 * Drops the cached area so the next calcArea call computes it again.
+	 * Call this after editing a vertex Point directly through its pointer.
+	 */
+	void invalidateAreaCache();
+
+	/*
+	 * Returns the number of calcArea calls answered from the cache.
+	 *
+	 * @return The number of cache hits.
+	 */
+	unsigned long long getAreaCacheHits() const;
+
+	/*
+	 * Returns the number of calcArea calls that computed the area while the cache was enabled.
+	 *
+	 * @return The number of cache misses.
+	 */
+	unsigned long long getAreaCacheMisses() const;
 	
+	/*
+	 * Returns the axis-aligned box around the triangle. It is cached, shifted by translate(),
+	 * and computed again only after a single vertex has moved.
+	 *
+	 * @param minimum Receives the smallest coordinate on each axis.
+	 * @param maximum Receives the largest coordinate on each axis.
+	 * @return True if the box was returned, false if any vertex is not assigned.
+	 */
+	bool getBounds(Point& minimum, Point& maximum);
+
+	/*
+	 * Returns the centroid of the triangle, kept the same way as the box.
+	 *
+	 * @param x Receives the x-coordinate of the centroid.
+	 * @param y Receives the y-coordinate of the centroid.
+	 * @param z Receives the z-coordinate of the centroid.
+	 * @return True if the centroid was returned, false if any vertex is not assigned.
+	 */
+	bool getCentroid(double& x, double& y, double& z);
+
+	/*
+	 * Drops the cached box and centroid so the next query computes them again.
+	 * Call this after editing a vertex Point directly through its pointer.
+	 */
+	void invalidateBoundsCache();
+
 	/*
 	 * Displays the coordinates of the three vertices forming the triangle.
 	 */
@@ -0,0 +1,909 @@
+// Includes the TriangleMesh.h header file for function declarations.
+#include "TriangleMesh.h"
+// Includes the ExactMath.h header file for the overflow-free area calculation.
+#include "ExactMath.h"
+
+// Includes the algorithm library for std::min and std::max.
+#include <algorithm>
+// Includes the climits library for the range of int coordinates.
+#include <climits>
+// Includes the input/output stream library for IO operations.
+#include <iostream>
+// Includes the utility library for std::move.
+#include <utility>
+
+/*
+ * Default constructor for the TriangleMesh class.
+ * The vertex pool and the index buffer both start empty.
+ */
+TriangleMesh::TriangleMesh() : areaCacheEnabled(false), areaCacheHits(0), areaCacheMisses(0), adjacencyTriangleCount(0), lazyTransforms(false), pendingX(0), pendingY(0), pendingZ(0),
+	boundsValid(true), vertexSumValid(true)
+{
+	// An empty pool has an up-to-date box and centroid; the box is set by the first vertex added.
+	for (int axis = 0; axis < 3; axis++)
+	{
+		boundsMin[axis] = 0;
+		boundsMax[axis] = 0;
+		vertexSum[axis] = Int128(0);
+	}
+}
+
+/*
+ * Shifts a cached box and coordinate sum by an offset applied to every vertex.
+ * The box is marked out of date if a side would leave the int range, where the coordinates themselves wrap around.
+ *
+ * @param boundsMin The smallest coordinate on each axis.
+ * @param boundsMax The largest coordinate on each axis.
+ * @param boundsValid Whether the box is up to date.
+ * @param vertexSum The sum of the coordinates on each axis.
+ * @param vertexSumValid Whether the sums are up to date.
+ * @param vertexCount The number of vertices the offset is applied to.
+ * @param offset The offset on each axis.
+ */
+static void shiftBounds(int boundsMin[3], int boundsMax[3], bool& boundsValid, Int128 vertexSum[3], bool vertexSumValid, std::size_t vertexCount, const int offset[3])
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (boundsValid && vertexCount > 0)
+		{
+			long long lowest = static_cast<long long>(boundsMin[axis]) + offset[axis];
+			long long highest = static_cast<long long>(boundsMax[axis]) + offset[axis];
+			if (lowest < INT_MIN || highest > INT_MAX)
+			{
+				boundsValid = false;
+			}
+			else
+			{
+				boundsMin[axis] = static_cast<int>(lowest);
+				boundsMax[axis] = static_cast<int>(highest);
+			}
+		}
+		// Every vertex moves by the same amount, so the sum moves by that amount times the vertex count.
+		if (vertexSumValid)
+		{
+			vertexSum[axis] = vertexSum[axis] + Int128(offset[axis]) * Int128(static_cast<std::int64_t>(vertexCount));
+		}
+	}
+}
+
+/*
+ * Reserves memory for a number of vertices and triangles.
+ *
+ * @param vertexCount The number of vertices to reserve space for.
+ * @param triangleCount The number of triangles to reserve space for.
+ */
+void TriangleMesh::reserve(std::size_t vertexCount, std::size_t triangleCount)
+{
+	vertices.reserve(vertexCount);
+	indices.reserve(triangleCount * 3);
+}
+
+/*
+ * Removes all vertices and triangles from the mesh.
+ */
+void TriangleMesh::clear()
+{
+	vertices.clear();
+	indices.clear();
+	cachedAreas.clear();
+	cachedAreaValid.clear();
+	clearAdjacency();
+	// No vertex is left to carry an offset.
+	pendingX = 0;
+	pendingY = 0;
+	pendingZ = 0;
+	// The empty pool's box and centroid are up to date again.
+	boundsValid = true;
+	vertexSumValid = true;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		vertexSum[axis] = Int128(0);
+	}
+}
+
+/*
+ * Sets the number of vertices and triangles in one step.
+ *
+ * @param vertexCount The new number of vertices.
+ * @param triangleCount The new number of triangles.
+ */
+void TriangleMesh::resize(std::size_t vertexCount, std::size_t triangleCount)
+{
+	// Apply a pending offset first, so the new vertices really start at the origin.
+	flushTransform();
+	vertices.resize(vertexCount);
+	indices.resize(triangleCount * 3, 0);
+	// The triangles are about to be rewritten, so none of the cached areas can be trusted.
+	cachedAreas.clear();
+	cachedAreaValid.clear();
+	clearAdjacency();
+	// Neither can the box or the centroid, since the pool is written directly after this.
+	invalidateBoundsCache();
+}
+
+/*
+ * Adds a vertex to the shared pool, at the given effective coordinates.
+ *
+ * @param x The x-coordinate of the vertex.
+ * @param y The y-coordinate of the vertex.
+ * @param z The z-coordinate of the vertex.
+ * @return The index of the new vertex.
+ */
+std::uint32_t TriangleMesh::addVertex(int x, int y, int z)
+{
+	// Store the vertex without the pending offset, which is added back when it is read or flushed.
+	int stored[3] = { x - pendingX, y - pendingY, z - pendingZ };
+	std::size_t vertex = vertices.addPoint(stored[0], stored[1], stored[2]);
+
+	// A new vertex can only grow the box, and adds its coordinates to the sums.
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (boundsValid)
+		{
+			boundsMin[axis] = vertex == 0 ? stored[axis] : std::min(boundsMin[axis], stored[axis]);
+			boundsMax[axis] = vertex == 0 ? stored[axis] : std::max(boundsMax[axis], stored[axis]);
+		}
+		if (vertexSumValid)
+		{
+			vertexSum[axis] = vertexSum[axis] + Int128(stored[axis]);
+		}
+	}
+	return static_cast<std::uint32_t>(vertex);
+}
+
+/*
+ * Adds a copy of a Point to the shared pool.
+ *
+ * @param point The point to copy.
+ * @return The index of the new vertex.
+ */
+std::uint32_t TriangleMesh::addVertex(const Point& point)
+{
+	return addVertex(point.getCoordinateX(), point.getCoordinateY(), point.getCoordinateZ());
+}
+
+/*
+ * Adds a triangle made of three vertices already in the pool.
+ *
+ * @param a The index of the first vertex.
+ * @param b The index of the second vertex.
+ * @param c The index of the third vertex.
+ * @return True if the triangle was added, false if any index is out of range.
+ */
+bool TriangleMesh::addTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+{
+	// Reject triangles that refer to vertices that do not exist.
+	if (a >= vertices.size() || b >= vertices.size() || c >= vertices.size())
+	{
+		return false;
+	}
+
+	// Append the three indices to the index buffer.
+	indices.push_back(a);
+	indices.push_back(b);
+	indices.push_back(c);
+	return true;
+}
+
+/*
+ * Returns the number of vertices in the shared pool.
+ *
+ * @return The number of vertices.
+ */
+std::size_t TriangleMesh::getVertexCount() const
+{
+	return vertices.size();
+}
+
+/*
+ * Returns the number of triangles in the mesh.
+ *
+ * @return The number of triangles.
+ */
+std::size_t TriangleMesh::getTriangleCount() const
+{
+	return indices.size() / 3;
+}
+
+/*
+ * Read-only access to the shared vertex pool.
+ *
+ * @return A reference to the vertex pool.
+ */
+const PointBuffer& TriangleMesh::getVertices() const
+{
+	return vertices;
+}
+
+/*
+ * Writable access to the shared vertex pool, with any pending offset applied first.
+ *
+ * @return A reference to the vertex pool.
+ */
+PointBuffer& TriangleMesh::getVertices()
+{
+	// The caller may read or write the coordinates directly, so they must be the effective ones.
+	flushTransform();
+	// Writes through the reference are not seen here, so the box and the centroid are worked out again on the next query.
+	invalidateBoundsCache();
+	return vertices;
+}
+
+/*
+ * Read-only access to the index buffer.
+ *
+ * @return A pointer to the first index, or nullptr if the mesh has no triangles.
+ */
+const std::uint32_t* TriangleMesh::getIndices() const
+{
+	return indices.empty() ? nullptr : indices.data();
+}
+
+/*
+ * Writable access to the index buffer.
+ *
+ * @return A pointer to the first index, or nullptr if the mesh has no triangles.
+ */
+std::uint32_t* TriangleMesh::getIndices()
+{
+	// The caller may rewrite the triangles, so the lists around each vertex are built again when next needed.
+	clearAdjacency();
+	return indices.empty() ? nullptr : indices.data();
+}
+
+/*
+ * Looks up the three vertex indices of a triangle.
+ *
+ * @param triangle The index of the triangle.
+ * @param a Receives the index of the first vertex.
+ * @param b Receives the index of the second vertex.
+ * @param c Receives the index of the third vertex.
+ */
+void TriangleMesh::getTriangle(std::size_t triangle, std::uint32_t& a, std::uint32_t& b, std::uint32_t& c) const
+{
+	a = indices[triangle * 3];
+	b = indices[triangle * 3 + 1];
+	c = indices[triangle * 3 + 2];
+}
+
+/*
+ * Builds the inverse of a permutation, checking that it is one.
+ *
+ * @param order For each new position, the old index of the element placed there.
+ * @param count The number of elements.
+ * @param newIndex Receives, for each old index, its new position.
+ * @return True if order lists every index below count exactly once.
+ */
+static bool invertPermutation(const std::vector<std::uint32_t>& order, std::size_t count, std::vector<std::uint32_t>& newIndex)
+{
+	if (order.size() != count)
+	{
+		return false;
+	}
+	newIndex.assign(count, UINT32_MAX);
+	for (std::size_t i = 0; i < count; i++)
+	{
+		// An index out of range, or one already placed, means order is not a permutation.
+		if (order[i] >= count || newIndex[order[i]] != UINT32_MAX)
+		{
+			return false;
+		}
+		newIndex[order[i]] = static_cast<std::uint32_t>(i);
+	}
+	return true;
+}
+
+/*
+ * Reorders the vertex pool and rewrites the triangles to match.
+ *
+ * @param order For each new position, the index the vertex had before.
+ * @return True if the vertices were reordered, false if order is not a permutation of the vertices.
+ */
+bool TriangleMesh::reorderVertices(const std::vector<std::uint32_t>& order)
+{
+	std::vector<std::uint32_t> newIndex;
+	if (!invertPermutation(order, vertices.size(), newIndex))
+	{
+		return false;
+	}
+
+	// Gather the stored coordinates into a new pool; a pending offset applies to every vertex alike, so it is kept.
+	PointBuffer reordered(order.size());
+	reordered.resize(order.size());
+	const int* xs = vertices.dataX();
+	const int* ys = vertices.dataY();
+	const int* zs = vertices.dataZ();
+	int* reorderedXs = reordered.dataX();
+	int* reorderedYs = reordered.dataY();
+	int* reorderedZs = reordered.dataZ();
+	for (std::size_t i = 0; i < order.size(); i++)
+	{
+		reorderedXs[i] = xs[order[i]];
+		reorderedYs[i] = ys[order[i]];
+		reorderedZs[i] = zs[order[i]];
+	}
+	vertices = std::move(reordered);
+	clearAdjacency();
+
+	// Point the triangles at the new positions of their vertices.
+	for (std::size_t i = 0; i < indices.size(); i++)
+	{
+		indices[i] = newIndex[indices[i]];
+	}
+	return true;
+}
+
+/*
+ * Reorders the triangles, moving their cached areas with them.
+ *
+ * @param order For each new position, the index the triangle had before.
+ * @return True if the triangles were reordered, false if order is not a permutation of the triangles.
+ */
+bool TriangleMesh::reorderTriangles(const std::vector<std::uint32_t>& order)
+{
+	std::vector<std::uint32_t> newIndex;
+	if (!invertPermutation(order, getTriangleCount(), newIndex))
+	{
+		return false;
+	}
+
+	// Gather the index triples in the new order.
+	std::vector<std::uint32_t> reordered(indices.size());
+	for (std::size_t i = 0; i < order.size(); i++)
+	{
+		reordered[i * 3] = indices[order[i] * 3];
+		reordered[i * 3 + 1] = indices[order[i] * 3 + 1];
+		reordered[i * 3 + 2] = indices[order[i] * 3 + 2];
+	}
+	indices.swap(reordered);
+	clearAdjacency();
+
+	// Move the cached areas along. The cache may not cover the newest triangles yet; those entries stay invalid.
+	if (!cachedAreaValid.empty())
+	{
+		std::vector<double> areas(order.size(), 0.0);
+		std::vector<unsigned char> valid(order.size(), 0);
+		for (std::size_t i = 0; i < order.size(); i++)
+		{
+			if (order[i] < cachedAreaValid.size())
+			{
+				areas[i] = cachedAreas[order[i]];
+				valid[i] = cachedAreaValid[order[i]];
+			}
+		}
+		cachedAreas.swap(areas);
+		cachedAreaValid.swap(valid);
+	}
+	return true;
+}
+
+/*
+ * Returns the effective coordinates of a vertex.
+ *
+ * @param vertex The index of the vertex.
+ * @return A Point holding the effective coordinates.
+ */
+Point TriangleMesh::getEffectiveVertex(std::uint32_t vertex) const
+{
+	return Point(vertices.getCoordinateX(vertex) + pendingX, vertices.getCoordinateY(vertex) + pendingY, vertices.getCoordinateZ(vertex) + pendingZ);
+}
+
+/*
+ * Moves a single vertex in the shared pool to new effective coordinates.
+ *
+ * @param vertex The index of the vertex to move.
+ * @param x The new x-coordinate.
+ * @param y The new y-coordinate.
+ * @param z The new z-coordinate.
+ */
+void TriangleMesh::setVertex(std::uint32_t vertex, int x, int y, int z)
+{
+	int previous[3] = { vertices.getCoordinateX(vertex), vertices.getCoordinateY(vertex), vertices.getCoordinateZ(vertex) };
+	int stored[3] = { x - pendingX, y - pendingY, z - pendingZ };
+	vertices.setPoint(vertex, stored[0], stored[1], stored[2]);
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		// The sums are exact, so the old coordinate can be swapped for the new one.
+		if (vertexSumValid)
+		{
+			vertexSum[axis] = vertexSum[axis] + Int128(static_cast<std::int64_t>(stored[axis]) - previous[axis]);
+		}
+		if (!boundsValid)
+		{
+			continue;
+		}
+		// A vertex moving inwards off a side of the box may have been the only one on it, which only a rescan can tell.
+		if ((previous[axis] == boundsMin[axis] && stored[axis] > boundsMin[axis]) || (previous[axis] == boundsMax[axis] && stored[axis] < boundsMax[axis]))
+		{
+			boundsValid = false;
+			continue;
+		}
+		boundsMin[axis] = std::min(boundsMin[axis], stored[axis]);
+		boundsMax[axis] = std::max(boundsMax[axis], stored[axis]);
+	}
+
+	// Without cached areas there is nothing to drop, and no reason to build the lists around each vertex.
+	if (cachedAreaValid.empty())
+	{
+		return;
+	}
+
+	// Build the lists on the first edit, or again once many triangles have been added since, so the scan of the
+	// newer triangles below stays short next to the cost of the edits that share the build.
+	std::size_t triangleCount = getTriangleCount();
+	if (adjacencyOffsets.empty() || triangleCount - adjacencyTriangleCount > adjacencyTriangleCount / 4 + 1024)
+	{
+		buildAdjacency();
+	}
+
+	// Drop the cached areas of the triangles around the moved vertex. A vertex added after the build has no list yet.
+	if (vertex + 1 < adjacencyOffsets.size())
+	{
+		for (std::size_t i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex + 1]; i++)
+		{
+			if (adjacentTriangles[i] < cachedAreaValid.size())
+			{
+				cachedAreaValid[adjacentTriangles[i]] = 0;
+			}
+		}
+	}
+
+	// Triangles added after the build are not in the lists, so they are checked directly.
+	std::size_t end = std::min(triangleCount, cachedAreaValid.size());
+	for (std::size_t triangle = adjacencyTriangleCount; triangle < end; triangle++)
+	{
+		if (indices[triangle * 3] == vertex || indices[triangle * 3 + 1] == vertex || indices[triangle * 3 + 2] == vertex)
+		{
+			cachedAreaValid[triangle] = 0;
+		}
+	}
+}
+
+/*
+ * Translates the whole mesh by a specified distance along a given axis.
+ *
+ * @param d The distance to translate the mesh along the axis.
+ * @param axis The axis along which to translate ('x', 'y', or 'z').
+ * @return 0 if successful, -1 if the axis is invalid.
+ */
+int TriangleMesh::translate(int d, char axis)
+{
+	// With lazy transforms, only the pending offset moves.
+	if (lazyTransforms)
+	{
+		switch (axis)
+		{
+		case 'x':
+			pendingX += d;
+			return 0;
+		case 'y':
+			pendingY += d;
+			return 0;
+		case 'z':
+			pendingZ += d;
+			return 0;
+		default:
+			return -1;
+		}
+	}
+
+	// Shared vertices are stored once, so one pass over the pool moves every triangle.
+	if (vertices.translate(d, axis) != 0)
+	{
+		return -1;
+	}
+	int offset[3] = { axis == 'x' ? d : 0, axis == 'y' ? d : 0, axis == 'z' ? d : 0 };
+	shiftBounds(boundsMin, boundsMax, boundsValid, vertexSum, vertexSumValid, vertices.size(), offset);
+	return 0;
+}
+
+/*
+ * Translates the whole mesh by an offset on all three axes.
+ *
+ * @param dx The distance to translate along the x-axis.
+ * @param dy The distance to translate along the y-axis.
+ * @param dz The distance to translate along the z-axis.
+ */
+void TriangleMesh::translate(int dx, int dy, int dz)
+{
+	// With lazy transforms, only the pending offset moves.
+	if (lazyTransforms)
+	{
+		pendingX += dx;
+		pendingY += dy;
+		pendingZ += dz;
+		return;
+	}
+	vertices.translate(dx, dy, dz);
+	int offset[3] = { dx, dy, dz };
+	shiftBounds(boundsMin, boundsMax, boundsValid, vertexSum, vertexSumValid, vertices.size(), offset);
+}
+
+/*
+ * Turns lazy transforms on or off.
+ *
+ * @param enabled True to defer translations, false to apply each one right away.
+ */
+void TriangleMesh::setLazyTransformsEnabled(bool enabled)
+{
+	lazyTransforms = enabled;
+	// Without lazy transforms the pool must always hold the effective coordinates.
+	if (!enabled)
+	{
+		flushTransform();
+	}
+}
+
+/*
+ * Checks whether lazy transforms are turned on.
+ *
+ * @return True if translations are deferred.
+ */
+bool TriangleMesh::isLazyTransformsEnabled() const
+{
+	return lazyTransforms;
+}
+
+/*
+ * Checks whether there is an offset that has not been applied to the pool yet.
+ *
+ * @return True if the stored coordinates differ from the effective ones.
+ */
+bool TriangleMesh::hasPendingTransform() const
+{
+	return pendingX != 0 || pendingY != 0 || pendingZ != 0;
+}
+
+/*
+ * Returns the offset that has not been applied to the pool yet.
+ *
+ * @param dx Receives the pending offset along the x-axis.
+ * @param dy Receives the pending offset along the y-axis.
+ * @param dz Receives the pending offset along the z-axis.
+ */
+void TriangleMesh::getPendingOffset(int& dx, int& dy, int& dz) const
+{
+	dx = pendingX;
+	dy = pendingY;
+	dz = pendingZ;
+}
+
+/*
+ * Applies the pending offset to the pool in a single pass.
+ */
+void TriangleMesh::flushTransform()
+{
+	if (!hasPendingTransform())
+	{
+		return;
+	}
+
+	// Translating every vertex by the same offset keeps every triangle's shape, so the area cache stays valid.
+	vertices.translate(pendingX, pendingY, pendingZ);
+	// The box and the sums describe the stored coordinates, so they move with them.
+	int offset[3] = { pendingX, pendingY, pendingZ };
+	shiftBounds(boundsMin, boundsMax, boundsValid, vertexSum, vertexSumValid, vertices.size(), offset);
+	pendingX = 0;
+	pendingY = 0;
+	pendingZ = 0;
+}
+
+/*
+ * Calculates the area of one triangle using the cross product of two of its edges.
+ *
+ * @param triangle The index of the triangle.
+ * @return The area of the triangle.
+ */
+double TriangleMesh::calcArea(std::size_t triangle) const
+{
+	// Look up the three vertex indices of the triangle.
+	std::uint32_t a = indices[triangle * 3];
+	std::uint32_t b = indices[triangle * 3 + 1];
+	std::uint32_t c = indices[triangle * 3 + 2];
+
+	// Reuse the cached area if the triangle's shape has not changed since it was computed.
+	if (areaCacheEnabled && triangle < cachedAreaValid.size() && cachedAreaValid[triangle])
+	{
+		areaCacheHits++;
+		return cachedAreas[triangle];
+	}
+
+	// Compute the area from the pool coordinates without overflowing on large coordinates.
+	double area = calcTriangleArea(vertices.getCoordinateX(a), vertices.getCoordinateY(a), vertices.getCoordinateZ(a),
+		vertices.getCoordinateX(b), vertices.getCoordinateY(b), vertices.getCoordinateZ(b),
+		vertices.getCoordinateX(c), vertices.getCoordinateY(c), vertices.getCoordinateZ(c));
+
+	// Remember the area for later calls if the cache is enabled.
+	if (areaCacheEnabled)
+	{
+		// Grow the cache to cover triangles added since it was last used.
+		if (cachedAreaValid.size() < getTriangleCount())
+		{
+			cachedAreas.resize(getTriangleCount(), 0.0);
+			cachedAreaValid.resize(getTriangleCount(), 0);
+		}
+		areaCacheMisses++;
+		cachedAreas[triangle] = area;
+		cachedAreaValid[triangle] = 1;
+	}
+	return area;
+}
+
+/*
+ * Turns the area cache on or off.
+ *
+ * @param enabled True to cache areas, false to compute them on every call.
+ */
+void TriangleMesh::setAreaCacheEnabled(bool enabled)
+{
+	areaCacheEnabled = enabled;
+	// A disabled cache keeps nothing, so free its memory.
+	if (!enabled)
+	{
+		cachedAreas.clear();
+		cachedAreaValid.clear();
+		clearAdjacency();
+	}
+}
+
+/*
+ * Checks whether the area cache is turned on.
+ *
+ * @return True if the area cache is enabled.
+ */
+bool TriangleMesh::isAreaCacheEnabled() const
+{
+	return areaCacheEnabled;
+}
+
+/*
+ * Drops every cached area so later calcArea calls compute them again.
+ */
+void TriangleMesh::invalidateAreaCache()
+{
+	cachedAreaValid.assign(cachedAreaValid.size(), 0);
+	// The areas may be stale because triangles were rewritten, so the lists around each vertex are rebuilt as well.
+	clearAdjacency();
+}
+
+/*
+ * Builds the lists of triangles around each vertex from the index buffer with a counting sort.
+ */
+void TriangleMesh::buildAdjacency()
+{
+	std::size_t vertexCount = vertices.size();
+	std::size_t triangleCount = getTriangleCount();
+
+	// Count the corners at each vertex, then turn the counts into the start of each vertex's list.
+	adjacencyOffsets.assign(vertexCount + 1, 0);
+	for (std::size_t i = 0; i < indices.size(); i++)
+	{
+		adjacencyOffsets[indices[i] + 1]++;
+	}
+	for (std::size_t v = 0; v < vertexCount; v++)
+	{
+		adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+	}
+
+	// Place every triangle in the list of each of its corners; a triangle using one vertex twice is listed twice, which is harmless.
+	adjacentTriangles.resize(indices.size());
+	std::vector<std::size_t> next(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (std::size_t i = 0; i < indices.size(); i++)
+	{
+		adjacentTriangles[next[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+	}
+	adjacencyTriangleCount = triangleCount;
+}
+
+/*
+ * Drops the lists of triangles around each vertex, after the index buffer changed in place.
+ */
+void TriangleMesh::clearAdjacency()
+{
+	adjacencyOffsets.clear();
+	adjacentTriangles.clear();
+	adjacencyTriangleCount = 0;
+}
+
+/*
+ * Returns the number of calcArea calls answered from the cache.
+ *
+ * @return The number of cache hits.
+ */
+unsigned long long TriangleMesh::getAreaCacheHits() const
+{
+	return areaCacheHits;
+}
+
+/*
+ * Returns the number of calcArea calls that computed the area while the cache was enabled.
+ *
+ * @return The number of cache misses.
+ */
+unsigned long long TriangleMesh::getAreaCacheMisses() const
+{
+	return areaCacheMisses;
+}
+
+/*
+ * Scans the pool for the box and the coordinate sums of the stored coordinates, without touching the cache.
+ *
+ * @param minimum Receives the smallest stored coordinate on each axis, or null.
+ * @param maximum Receives the largest stored coordinate on each axis; null exactly when minimum is.
+ * @param sums Receives the sum of the stored coordinates on each axis, or null.
+ */
+void TriangleMesh::scanBounds(int* minimum, int* maximum, Int128* sums) const
+{
+	const int* coordinates[3] = { vertices.dataX(), vertices.dataY(), vertices.dataZ() };
+	std::size_t count = vertices.size();
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const int* values = coordinates[axis];
+		if (minimum != nullptr && count > 0)
+		{
+			int lowest = values[0];
+			int highest = values[0];
+			for (std::size_t i = 1; i < count; i++)
+			{
+				lowest = std::min(lowest, values[i]);
+				highest = std::max(highest, values[i]);
+			}
+			minimum[axis] = lowest;
+			maximum[axis] = highest;
+		}
+		if (sums != nullptr)
+		{
+			// Blocks of 2^31 ints cannot overflow a 64-bit sum, so the wide sum is only touched once per block.
+			Int128 total(0);
+			for (std::size_t start = 0; start < count; start += (std::size_t(1) << 31))
+			{
+				std::size_t end = std::min(count, start + (std::size_t(1) << 31));
+				long long blockSum = 0;
+				for (std::size_t i = start; i < end; i++)
+				{
+					blockSum += values[i];
+				}
+				total = total + Int128(blockSum);
+			}
+			sums[axis] = total;
+		}
+	}
+}
+
+/*
+ * Returns the axis-aligned box around every vertex in the pool, in effective coordinates, storing a rescanned box.
+ *
+ * @param minimum Receives the smallest coordinate on each axis.
+ * @param maximum Receives the largest coordinate on each axis.
+ * @return True if the box was returned, false if the mesh has no vertices.
+ */
+bool TriangleMesh::getBounds(Point& minimum, Point& maximum)
+{
+	if (!boundsValid)
+	{
+		refreshBoundsCache();
+	}
+	return static_cast<const TriangleMesh&>(*this).getBounds(minimum, maximum);
+}
+
+/*
+ * Returns the axis-aligned box around every vertex in the pool through a read-only mesh, without writing the cache.
+ *
+ * @param minimum Receives the smallest coordinate on each axis.
+ * @param maximum Receives the largest coordinate on each axis.
+ * @return True if the box was returned, false if the mesh has no vertices.
+ */
+bool TriangleMesh::getBounds(Point& minimum, Point& maximum) const
+{
+	if (vertices.size() == 0)
+	{
+		return false;
+	}
+
+	// An out-of-date box is scanned into locals: a const call must not write the cache, which other threads may be reading.
+	int lowest[3] = { boundsMin[0], boundsMin[1], boundsMin[2] };
+	int highest[3] = { boundsMax[0], boundsMax[1], boundsMax[2] };
+	if (!boundsValid)
+	{
+		scanBounds(lowest, highest, nullptr);
+	}
+
+	// The box is kept for the stored coordinates, so a pending offset is added on the way out.
+	minimum = Point(lowest[0] + pendingX, lowest[1] + pendingY, lowest[2] + pendingZ);
+	maximum = Point(highest[0] + pendingX, highest[1] + pendingY, highest[2] + pendingZ);
+	return true;
+}
+
+/*
+ * Returns the centroid of the vertices in the pool, in effective coordinates, storing rescanned sums.
+ *
+ * @param x Receives the x-coordinate of the centroid.
+ * @param y Receives the y-coordinate of the centroid.
+ * @param z Receives the z-coordinate of the centroid.
+ * @return True if the centroid was returned, false if the mesh has no vertices.
+ */
+bool TriangleMesh::getCentroid(double& x, double& y, double& z)
+{
+	if (!vertexSumValid)
+	{
+		refreshBoundsCache();
+	}
+	return static_cast<const TriangleMesh&>(*this).getCentroid(x, y, z);
+}
+
+/*
+ * Returns the centroid of the vertices in the pool through a read-only mesh, without writing the cache.
+ *
+ * @param x Receives the x-coordinate of the centroid.
+ * @param y Receives the y-coordinate of the centroid.
+ * @param z Receives the z-coordinate of the centroid.
+ * @return True if the centroid was returned, false if the mesh has no vertices.
+ */
+bool TriangleMesh::getCentroid(double& x, double& y, double& z) const
+{
+	if (vertices.size() == 0)
+	{
+		return false;
+	}
+
+	// As in getBounds(), out-of-date sums are scanned into locals.
+	Int128 sums[3] = { vertexSum[0], vertexSum[1], vertexSum[2] };
+	if (!vertexSumValid)
+	{
+		scanBounds(nullptr, nullptr, sums);
+	}
+
+	// The pending offset moves every vertex alike, so it moves the centroid by the same amount.
+	double count = static_cast<double>(vertices.size());
+	x = sums[0].toDouble() / count + pendingX;
+	y = sums[1].toDouble() / count + pendingY;
+	z = sums[2].toDouble() / count + pendingZ;
+	return true;
+}
+
+/*
+ * Marks the box and the centroid out of date, so the next query scans the pool again.
+ */
+void TriangleMesh::invalidateBoundsCache()
+{
+	boundsValid = false;
+	vertexSumValid = false;
+}
+
+/*
+ * Rescans the pool for whichever of the box and the centroid is out of date and stores it.
+ */
+void TriangleMesh::refreshBoundsCache()
+{
+	scanBounds(boundsValid ? nullptr : boundsMin, boundsValid ? nullptr : boundsMax, vertexSumValid ? nullptr : vertexSum);
+	boundsValid = true;
+	vertexSumValid = true;
+}
+
+/*
+ * Displays the effective coordinates of the three vertices forming one triangle.
+ *
+ * @param triangle The index of the triangle.
+ */
+void TriangleMesh::displayTriangle(std::size_t triangle) const
+{
+	// Prints the header for the triangle's coordinates.
+	std::cout << "- Triangle's Coordinates - \n";
+
+	// Displays the coordinates of the first vertex.
+	std::cout << "First Vertex Coordinate: ";
+	getEffectiveVertex(indices[triangle * 3]).displayPoint();
+
+	// Displays the coordinates of the second vertex.
+	std::cout << "Second Vertex Coordinate: ";
+	getEffectiveVertex(indices[triangle * 3 + 1]).displayPoint();
+
+	// Displays the coordinates of the third vertex.
+	std::cout << "Third Vertex Coordinate: ";
+	getEffectiveVertex(indices[triangle * 3 + 2]).displayPoint();
+
+	// Prints a newline after displaying all the coordinates.
+	std::cout << "\n";
+}
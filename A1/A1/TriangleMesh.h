@@ -0,0 +1,407 @@
+// Start of the header guard to prevent multiple inclusions of this file.
+#ifndef TRIANGLEMESH_H
+#define TRIANGLEMESH_H
+
+// Includes the PointBuffer.h header file to use the PointBuffer class as the shared vertex pool.
+#include "PointBuffer.h"
+// Includes the ExactMath.h header file for the 128-bit coordinate sums behind the centroid.
+#include "ExactMath.h"
+
+// Includes the cstddef library for the std::size_t type.
+#include <cstddef>
+// Includes the cstdint library for the fixed-width std::uint32_t index type.
+#include <cstdint>
+// Includes the vector library for the index buffer.
+#include <vector>
+
+/*
+ * Defines a TriangleMesh class that stores many triangles as an indexed mesh.
+ * All vertices live once in a shared PointBuffer pool and each triangle is three
+ * 32-bit indices into that pool, so vertices shared between triangles are stored only once.
+ */
+class TriangleMesh
+{
+private:
+	// Shared pool holding the coordinates of every vertex in the mesh.
+	PointBuffer vertices;
+	// Index buffer; triangle t uses the vertices at indices[3 * t], indices[3 * t + 1] and indices[3 * t + 2].
+	std::vector<std::uint32_t> indices;
+
+	// Whether calcArea stores its results and reuses them until a triangle's shape changes.
+	bool areaCacheEnabled;
+	// Cached area of each triangle, valid where the matching entry of cachedAreaValid is nonzero.
+	mutable std::vector<double> cachedAreas;
+	// One flag per triangle telling whether its entry in cachedAreas is current.
+	mutable std::vector<unsigned char> cachedAreaValid;
+	// Number of calcArea calls answered from the cache.
+	mutable unsigned long long areaCacheHits;
+	// Number of calcArea calls that had to compute the area.
+	mutable unsigned long long areaCacheMisses;
+	// Triangles around each vertex, built on the first setVertex that has cached areas to drop, so an edit only visits its own triangles.
+	// The triangles using vertex v are adjacentTriangles[adjacencyOffsets[v]] up to adjacentTriangles[adjacencyOffsets[v + 1]];
+	// vertices and triangles added after the build are not in it, and the empty offsets mean the lists have to be built again.
+	std::vector<std::size_t> adjacencyOffsets;
+	std::vector<std::uint32_t> adjacentTriangles;
+	// Number of triangles the adjacency lists were built from.
+	std::size_t adjacencyTriangleCount;
+
+	// Whether translations are recorded as a pending offset instead of being applied to the pool right away.
+	bool lazyTransforms;
+	// Offset not yet applied to the pool; the effective coordinates of a vertex are its stored ones plus this offset.
+	int pendingX;
+	int pendingY;
+	int pendingZ;
+
+	// Box of the stored coordinates of every vertex, current while boundsValid is set. The pending offset is added when it is read.
+	int boundsMin[3];
+	int boundsMax[3];
+	bool boundsValid;
+	// Sum of the stored coordinates of every vertex, current while vertexSumValid is set; the centroid is this over the vertex count.
+	Int128 vertexSum[3];
+	bool vertexSumValid;
+
+	/*
+	 * Scans the pool for the box and the coordinate sums of the stored coordinates, without touching the cache.
+	 * Either output may be skipped by passing null for it.
+	 *
+	 * @param minimum Receives the smallest stored coordinate on each axis, or null.
+	 * @param maximum Receives the largest stored coordinate on each axis; null exactly when minimum is.
+	 * @param sums Receives the sum of the stored coordinates on each axis, or null.
+	 */
+	void scanBounds(int* minimum, int* maximum, Int128* sums) const;
+
+	/*
+	 * Builds the lists of triangles around each vertex from the index buffer with a counting sort.
+	 */
+	void buildAdjacency();
+
+	/*
+	 * Drops the lists of triangles around each vertex, after the index buffer changed in place.
+	 */
+	void clearAdjacency();
+
+public:
+	/*
+	 * Default constructor for the TriangleMesh class.
+	 * Creates a mesh with no vertices and no triangles.
+	 */
+	TriangleMesh();
+
+	/*
+	 * Reserves memory for a number of vertices and triangles.
+	 *
+	 * @param vertexCount The number of vertices to reserve space for.
+	 * @param triangleCount The number of triangles to reserve space for.
+	 */
+	void reserve(std::size_t vertexCount, std::size_t triangleCount);
+
+	/*
+	 * Removes all vertices and triangles from the mesh.
+	 */
+	void clear();
+
+	/*
+	 * Sets the number of vertices and triangles in one step, for loaders that fill the buffers directly.
+	 * New vertices are placed at the origin and new triangles use vertex 0, so the caller must
+	 * overwrite them through getVertices() and getIndices(). Every cached area is dropped.
+	 *
+	 * @param vertexCount The new number of vertices.
+	 * @param triangleCount The new number of triangles.
+	 */
+	void resize(std::size_t vertexCount, std::size_t triangleCount);
+
+	/*
+	 * Adds a vertex to the shared pool, at the given effective coordinates.
+	 *
+	 * @param x The x-coordinate of the vertex.
+	 * @param y The y-coordinate of the vertex.
+	 * @param z The z-coordinate of the vertex.
+	 * @return The index of the new vertex.
+	 */
+	std::uint32_t addVertex(int x, int y, int z);
+
+	/*
+	 * Adds a copy of a Point to the shared pool.
+	 *
+	 * @param point The point to copy.
+	 * @return The index of the new vertex.
+	 */
+	std::uint32_t addVertex(const Point& point);
+
+	/*
+	 * Adds a triangle made of three vertices already in the pool.
+	 *
+	 * @param a The index of the first vertex.
+	 * @param b The index of the second vertex.
+	 * @param c The index of the third vertex.
+	 * @return True if the triangle was added, false if any index is out of range.
+	 */
+	bool addTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c);
+
+	/*
+	 * Returns the number of vertices in the shared pool.
+	 *
+	 * @return The number of vertices.
+	 */
+	std::size_t getVertexCount() const;
+
+	/*
+	 * Returns the number of triangles in the mesh.
+	 *
+	 * @return The number of triangles.
+	 */
+	std::size_t getTriangleCount() const;
+
+	/*
+	 * Read-only access to the shared vertex pool.
+	 * The stored coordinates do not include a pending offset; add getPendingOffset() or call flushTransform() first.
+	 * Areas and extents do not change under translation, so kernels measuring them can read the pool as it is.
+	 *
+	 * @return A reference to the vertex pool.
+	 */
+	const PointBuffer& getVertices() const;
+
+	/*
+	 * Writable access to the shared vertex pool, for bulk loaders and kernels.
+	 * A pending offset is applied first, so the pool holds the effective coordinates.
+	 * Moving vertices through it does not update the area cache; call invalidateAreaCache() afterwards.
+	 * The box and the centroid are marked out of date by the call itself, so call invalidateBoundsCache() as well
+	 * only if they are queried while the reference is still being written through.
+	 *
+	 * @return A reference to the vertex pool.
+	 */
+	PointBuffer& getVertices();
+
+	/*
+	 * Read-only access to the index buffer, three indices per triangle.
+	 *
+	 * @return A pointer to the first index, or nullptr if the mesh has no triangles.
+	 */
+	const std::uint32_t* getIndices() const;
+
+	/*
+	 * Writable access to the index buffer, for bulk loaders. Every index written must be below getVertexCount().
+	 * Triangles changed through it keep their cached areas; call invalidateAreaCache() after editing them.
+	 *
+	 * @return A pointer to the first index, or nullptr if the mesh has no triangles.
+	 */
+	std::uint32_t* getIndices();
+
+	/*
+	 * Looks up the three vertex indices of a triangle.
+	 *
+	 * @param triangle The index of the triangle.
+	 * @param a Receives the index of the first vertex.
+	 * @param b Receives the index of the second vertex.
+	 * @param c Receives the index of the third vertex.
+	 */
+	void getTriangle(std::size_t triangle, std::uint32_t& a, std::uint32_t& b, std::uint32_t& c) const;
+
+	/*
+	 * Reorders the vertex pool, for passes that place vertices used together next to each other in memory.
+	 * The triangles are rewritten to keep their positions, so the shape of the mesh and every cached area stay the same.
+	 *
+	 * @param order For each new position, the index the vertex had before; it must list every vertex exactly once.
+	 * @return True if the vertices were reordered, false if order is not a permutation of the vertices.
+	 */
+	bool reorderVertices(const std::vector<std::uint32_t>& order);
+
+	/*
+	 * Reorders the triangles. Each triangle keeps its vertices and its cached area.
+	 *
+	 * @param order For each new position, the index the triangle had before; it must list every triangle exactly once.
+	 * @return True if the triangles were reordered, false if order is not a permutation of the triangles.
+	 */
+	bool reorderTriangles(const std::vector<std::uint32_t>& order);
+
+	/*
+	 * Returns the effective coordinates of a vertex: its stored coordinates plus the pending offset.
+	 *
+	 * @param vertex The index of the vertex.
+	 * @return A Point holding the effective coordinates.
+	 */
+	Point getEffectiveVertex(std::uint32_t vertex) const;
+
+	/*
+	 * Moves a single vertex to new effective coordinates. Every triangle that uses the vertex sees the new position,
+	 * and the cached areas of those triangles are dropped. While areas are cached, the first call builds the lists
+	 * of triangles around each vertex, so later calls only visit the triangles of the moved vertex.
+	 *
+	 * @param vertex The index of the vertex to move.
+	 * @param x The new x-coordinate.
+	 * @param y The new y-coordinate.
+	 * @param z The new z-coordinate.
+	 */
+	void setVertex(std::uint32_t vertex, int x, int y, int z);
+
+	/*
+	 * Translates the whole mesh by a specified distance along a given axis.
+	 * Each shared vertex is moved exactly once in a single pass over the pool,
+	 * or, with lazy transforms enabled, the distance is added to the pending offset in constant time.
+	 *
+	 * @param d The distance to translate the mesh along the axis.
+	 * @param axis The axis along which to translate ('x', 'y', or 'z').
+	 * @return 0 if successful, -1 if the axis is invalid.
+	 */
+	int translate(int d, char axis);
+
+	/*
+	 * Translates the whole mesh by an offset on all three axes.
+	 *
+	 * @param dx The distance to translate along the x-axis.
+	 * @param dy The distance to translate along the y-axis.
+	 * @param dz The distance to translate along the z-axis.
+	 */
+	void translate(int dx, int dy, int dz);
+
+	/*
+	 * Turns lazy transforms on or off. With them on, translate() only updates a pending offset, and the pool
+	 * is moved once, by the sum of the translations, when flushTransform() or the writable getVertices() is called.
+	 * Turning them off applies the pending offset.
+	 *
+	 * @param enabled True to defer translations, false to apply each one right away.
+	 */
+	void setLazyTransformsEnabled(bool enabled);
+
+	/*
+	 * Checks whether lazy transforms are turned on.
+	 *
+	 * @return True if translations are deferred.
+	 */
+	bool isLazyTransformsEnabled() const;
+
+	/*
+	 * Checks whether there is an offset that has not been applied to the pool yet.
+	 *
+	 * @return True if the stored coordinates differ from the effective ones.
+	 */
+	bool hasPendingTransform() const;
+
+	/*
+	 * Returns the offset that has not been applied to the pool yet.
+	 *
+	 * @param dx Receives the pending offset along the x-axis.
+	 * @param dy Receives the pending offset along the y-axis.
+	 * @param dz Receives the pending offset along the z-axis.
+	 */
+	void getPendingOffset(int& dx, int& dy, int& dz) const;
+
+	/*
+	 * Applies the pending offset to the pool in a single pass, so the stored coordinates become the effective ones.
+	 * Does nothing if no offset is pending.
+	 */
+	void flushTransform();
+
+	/*
+	 * Calculates the area of one triangle using the coordinates in the vertex pool.
+	 * With the area cache enabled, the result is reused until one of the triangle's vertices
+	 * is moved on its own; translating the whole mesh keeps every cached area.
+	 * The cache is updated from const calls, so it must not be used from several threads at once.
+	 *
+	 * @param triangle The index of the triangle.
+	 * @return The area of the triangle.
+	 */
+	double calcArea(std::size_t triangle) const;
+
+	/*
+	 * Turns the area cache on or off. Turning it off also drops every cached area.
+	 *
+	 * @param enabled True to cache areas, false to compute them on every call.
+	 */
+	void setAreaCacheEnabled(bool enabled);
+
+	/*
+	 * Checks whether the area cache is turned on.
+	 *
+	 * @return True if the area cache is enabled.
+	 */
+	bool isAreaCacheEnabled() const;
+
+	/*
+	 * Drops every cached area so later calcArea calls compute them again.
+	 * Call this after editing triangles through getIndices(), which also rebuilds the triangles kept around each vertex.
+	 */
+	void invalidateAreaCache();
+
+	/*
+	 * Returns the number of calcArea calls answered from the cache.
+	 *
+	 * @return The number of cache hits.
+	 */
+	unsigned long long getAreaCacheHits() const;
+
+	/*
+	 * Returns the number of calcArea calls that computed the area while the cache was enabled.
+	 *
+	 * @return The number of cache misses.
+	 */
+	unsigned long long getAreaCacheMisses() const;
+
+	/*
+	 * Returns the axis-aligned box around every vertex in the pool, in effective coordinates.
+	 * The box is kept up to date as the mesh changes: a translation shifts it in constant time, added vertices grow it,
+	 * and a moved vertex only marks it out of date when it leaves the box's boundary, so the pool is scanned again
+	 * only after such edits or bulk writes, and the result of that scan is kept for the calls that follow.
+	 *
+	 * @param minimum Receives the smallest coordinate on each axis.
+	 * @param maximum Receives the largest coordinate on each axis.
+	 * @return True if the box was returned, false if the mesh has no vertices.
+	 */
+	bool getBounds(Point& minimum, Point& maximum);
+
+	/*
+	 * Returns the axis-aligned box around every vertex in the pool through a read-only mesh.
+	 * It never writes the cache, so any number of threads can call it at once: while the box is out of date,
+	 * each call scans the pool into locals. Call refreshBoundsCache() before sharing the mesh to avoid that.
+	 *
+	 * @param minimum Receives the smallest coordinate on each axis.
+	 * @param maximum Receives the largest coordinate on each axis.
+	 * @return True if the box was returned, false if the mesh has no vertices.
+	 */
+	bool getBounds(Point& minimum, Point& maximum) const;
+
+	/*
+	 * Returns the centroid of the vertices in the pool, in effective coordinates. It is kept as exact 128-bit coordinate sums,
+	 * which translations, added vertices, and moved vertices all update in constant time, so the pool is scanned again
+	 * only after bulk writes, and the result of that scan is kept for the calls that follow.
+	 *
+	 * @param x Receives the x-coordinate of the centroid.
+	 * @param y Receives the y-coordinate of the centroid.
+	 * @param z Receives the z-coordinate of the centroid.
+	 * @return True if the centroid was returned, false if the mesh has no vertices.
+	 */
+	bool getCentroid(double& x, double& y, double& z);
+
+	/*
+	 * Returns the centroid of the vertices in the pool through a read-only mesh. Like the read-only getBounds(),
+	 * it never writes the cache, so out-of-date sums are scanned again on every call.
+	 *
+	 * @param x Receives the x-coordinate of the centroid.
+	 * @param y Receives the y-coordinate of the centroid.
+	 * @param z Receives the z-coordinate of the centroid.
+	 * @return True if the centroid was returned, false if the mesh has no vertices.
+	 */
+	bool getCentroid(double& x, double& y, double& z) const;
+
+	/*
+	 * Marks the box and the centroid out of date, so the next query scans the pool again.
+	 * Call this after editing coordinates through a writable pool reference kept from an earlier getVertices() call.
+	 */
+	void invalidateBoundsCache();
+
+	/*
+	 * Rescans the pool for whichever of the box and the centroid is out of date and stores it,
+	 * so later getBounds() and getCentroid() calls answer without scanning.
+	 */
+	void refreshBoundsCache();
+
+	/*
+	 * Displays the effective coordinates of the three vertices forming one triangle.
+	 *
+	 * @param triangle The index of the triangle.
+	 */
+	void displayTriangle(std::size_t triangle) const;
+};
+
+// End of the header guard to prevent multiple inclusions of this file.
+#endif